@@ -0,0 +1,240 @@
+#include "AudioMixer.hpp"
+
+#include "MemoryStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace core;
+
+namespace {
+    constexpr float PI = 3.141592f;
+
+    // Equal-power pan: a source straight ahead plays at -3 dB on both sides.
+    void panGains(const float gain, const float pan, float& left, float& right) {
+        const float angle = (std::clamp(pan, -1.f, 1.f) + 1.f) * PI * 0.25f;
+        left = gain * std::cos(angle);
+        right = gain * std::sin(angle);
+    }
+
+    // Mixes `clip` from `position` into one block, ramping from the first gains to the second ones.
+    // Returns where the clip got to, or its size when a one-shot ran out.
+    std::size_t mixClip(const std::vector<float>& clip, std::size_t position, const bool loop,
+        float left, float right, const float endLeft, const float endRight, float* out) {
+        const float step = 1.f / static_cast<float>(AudioMixer::BLOCK_FRAMES);
+        const float leftStep = (endLeft - left) * step;
+        const float rightStep = (endRight - right) * step;
+
+        // Runs up to the end of the clip, so the inner loop has no wrap check.
+        for(std::size_t frame = 0; frame < AudioMixer::BLOCK_FRAMES;) {
+            if(position >= clip.size()) {
+                if(!loop) return clip.size();
+                position = 0;
+            }
+
+            const std::size_t run = std::min(AudioMixer::BLOCK_FRAMES - frame, clip.size() - position);
+            const float* samples = clip.data() + position;
+            float* frames = out + frame * 2;
+
+            for(std::size_t i = 0; i < run; ++i) {
+                frames[i * 2] += samples[i] * left;
+                frames[i * 2 + 1] += samples[i] * right;
+                left += leftStep;
+                right += rightStep;
+            }
+
+            frame += run;
+            position += run;
+        }
+
+        return position;
+    }
+
+    template <typename Sample>
+    std::vector<float> synthesize(const unsigned sampleRate, const SoundKind kind, Sample&& sample) {
+        std::vector<float> clip(static_cast<std::size_t>(SoundBank::GetDuration(kind) * static_cast<float>(sampleRate)));
+        for(std::size_t i = 0; i < clip.size(); ++i)
+            clip[i] = sample(static_cast<float>(i) / static_cast<float>(sampleRate));
+        return clip;
+    }
+}
+
+SoundBank::SoundBank(const unsigned sampleRate) {
+    std::minstd_rand gen(7);
+    std::uniform_real_distribution<float> noise(-1.f, 1.f);
+    float low = 0.f;
+
+    clips[static_cast<std::size_t>(SoundKind::Gunshot)] = synthesize(sampleRate, SoundKind::Gunshot, [&](const float t) {
+        low += 0.35f * (noise(gen) - low);
+        return 0.8f * low * std::exp(-t * 18.f) + 0.6f * std::sin(2.f * PI * 70.f * t) * std::exp(-t * 12.f);
+    });
+
+    clips[static_cast<std::size_t>(SoundKind::Footstep)] = synthesize(sampleRate, SoundKind::Footstep, [&](const float t) {
+        low += 0.15f * (noise(gen) - low);
+        return 0.9f * low * std::exp(-t * 40.f) + 0.4f * std::sin(2.f * PI * 90.f * t) * std::exp(-t * 60.f);
+    });
+
+    clips[static_cast<std::size_t>(SoundKind::Impact)] = synthesize(sampleRate, SoundKind::Impact, [&](const float t) {
+        return 0.6f * noise(gen) * std::exp(-t * 25.f) + 0.2f * std::sin(2.f * PI * 1800.f * t) * std::exp(-t * 50.f);
+    });
+
+    clips[static_cast<std::size_t>(SoundKind::Ghost)] = synthesize(sampleRate, SoundKind::Ghost, [](const float t) {
+        const float tremolo = 0.55f + 0.45f * std::sin(2.f * PI * 0.5f * t);
+        return 0.35f * tremolo * (std::sin(2.f * PI * 110.f * t) + 0.6f * std::sin(2.f * PI * 165.5f * t));
+    });
+}
+
+bool NullAudioBackend::Open(const unsigned sampleRate) {
+    this->sampleRate = sampleRate;
+    deadline = std::chrono::steady_clock::now();
+    return sampleRate > 0;
+}
+
+void NullAudioBackend::Submit(const float* frames, const std::size_t frameCount) {
+    float loudest = peak.load(std::memory_order_relaxed);
+    for(std::size_t i = 0; i < frameCount * 2; ++i)
+        loudest = std::max(loudest, std::abs(frames[i]));
+
+    peak.store(loudest, std::memory_order_relaxed);
+    this->frames.fetch_add(frameCount, std::memory_order_relaxed);
+
+    if(!realTime) return;
+
+    deadline += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(static_cast<double>(frameCount) / sampleRate));
+    std::this_thread::sleep_until(deadline);
+}
+
+AudioMixer::AudioMixer() : bank(SAMPLE_RATE) {}
+
+AudioMixer::~AudioMixer() {
+    Stop();
+}
+
+bool AudioMixer::Start(std::unique_ptr<AudioBackend> backend) {
+    if(IsRunning() || !backend || !backend->Open(SAMPLE_RATE)) return false;
+
+    this->backend = std::move(backend);
+    running.store(true, std::memory_order_release);
+    mixer = std::thread(&AudioMixer::mixerLoop, this);
+    return true;
+}
+
+void AudioMixer::Stop() {
+    if(!IsRunning()) return;
+
+    running.store(false, std::memory_order_release);
+    mixer.join();
+
+    backend->Close();
+    backend.reset();
+}
+
+bool AudioMixer::Send(const VoiceCommand& command) {
+    if(commands.Push(command)) return true;
+
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+MixerStats AudioMixer::GetStats() const {
+    MixerStats stats;
+    stats.blocks = blocks.load(std::memory_order_relaxed);
+    stats.mixSeconds = static_cast<double>(mixNanos.load(std::memory_order_relaxed)) * 1e-9;
+    stats.droppedCommands = dropped.load(std::memory_order_relaxed);
+    stats.activeVoices = activeVoices.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void AudioMixer::MixBlock(float* out) {
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+
+    commands.Drain([this](const VoiceCommand& command) { apply(command); });
+
+    std::fill(out, out + BLOCK_FRAMES * 2, 0.f);
+
+    std::size_t active = 0;
+
+    for(Voice& voice : voices) {
+        float left, right, endLeft, endRight;
+
+        if(voice.fadingClip) {
+            panGains(voice.fadingGain, voice.fadingPan, left, right);
+            mixClip(*voice.fadingClip, voice.fadingPosition, voice.fadingLoop, left, right, 0.f, 0.f, out);
+            voice.fadingClip = nullptr;
+        }
+
+        if(!voice.active) continue;
+
+        const float targetGain = voice.stopping ? 0.f : voice.targetGain;
+        panGains(voice.gain, voice.pan, left, right);
+        panGains(targetGain, voice.targetPan, endLeft, endRight);
+
+        voice.position = mixClip(*voice.clip, voice.position, voice.loop, left, right, endLeft, endRight, out);
+        voice.gain = targetGain;
+        voice.pan = voice.targetPan;
+        voice.fresh = false;
+        if(voice.stopping || (!voice.loop && voice.position >= voice.clip->size())) voice.active = false;
+
+        active += voice.active;
+    }
+
+    for(std::size_t i = 0; i < BLOCK_FRAMES * 2; ++i)
+        out[i] = std::clamp(out[i], -1.f, 1.f);
+
+    activeVoices.store(active, std::memory_order_relaxed);
+    blocks.fetch_add(1, std::memory_order_relaxed);
+    mixNanos.fetch_add(static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count()), std::memory_order_relaxed);
+}
+
+void AudioMixer::apply(const VoiceCommand& command) {
+    if(command.voice >= VOICE_COUNT) return;
+    Voice& voice = voices[command.voice];
+
+    switch(command.type) {
+        case VoiceCommand::Type::Start: {
+            // The scene may hand out a voice in the same batch that stopped it. Cutting the old
+            // sound off would click, so it fades out under the new one instead.
+            if(voice.active && !voice.fresh) {
+                voice.fadingClip = voice.clip;
+                voice.fadingPosition = voice.position;
+                voice.fadingLoop = voice.loop;
+                voice.fadingGain = voice.gain;
+                voice.fadingPan = voice.pan;
+            }
+
+            voice.clip = &bank.Get(command.kind);
+            voice.loop = command.loop;
+            voice.position = voice.loop && !voice.clip->empty() ? command.offset % voice.clip->size() : command.offset;
+            voice.active = voice.position < voice.clip->size();
+            voice.stopping = false;
+            voice.fresh = true;
+            // A sound picked up mid-way fades in; a fresh one keeps its attack.
+            voice.gain = command.offset == 0 ? command.gain : 0.f;
+            voice.pan = command.pan;
+            voice.targetGain = command.gain;
+            voice.targetPan = command.pan;
+            break;
+        }
+        case VoiceCommand::Type::Update:
+            voice.targetGain = command.gain;
+            voice.targetPan = command.pan;
+            break;
+        case VoiceCommand::Type::Stop:
+            voice.stopping = true;
+            break;
+    }
+}
+
+void AudioMixer::mixerLoop() {
+    MemoryScope scope(MemoryTag::Audio);
+    std::vector<float> block(BLOCK_FRAMES * 2);
+
+    while(running.load(std::memory_order_acquire)) {
+        MixBlock(block.data());
+        backend->Submit(block.data(), BLOCK_FRAMES);
+    }
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace core {
+    enum class SoundKind : std::uint8_t {
+        Gunshot,
+        Footstep,
+        Impact,
+        Ghost,
+    };
+
+    constexpr std::size_t SOUND_KIND_COUNT = static_cast<std::size_t>(SoundKind::Ghost) + 1;
+
+    // Mono clips synthesized once at startup; the game ships no audio assets.
+    class SoundBank {
+    public:
+        // Seconds per kind. The ghost's hum loops, so its partials and tremolo fit whole periods.
+        constexpr static std::array<float, SOUND_KIND_COUNT> DURATIONS = {0.4f, 0.12f, 0.25f, 2.f};
+
+        explicit SoundBank(const unsigned sampleRate);
+
+        const std::vector<float>& Get(const SoundKind kind) const { return clips[static_cast<std::size_t>(kind)]; }
+        static float GetDuration(const SoundKind kind) { return DURATIONS[static_cast<std::size_t>(kind)]; }
+
+    private:
+        std::array<std::vector<float>, SOUND_KIND_COUNT> clips;
+    };
+
+    // Where mixed blocks of interleaved stereo go. Submit is called from the mixer thread only and
+    // may block until the device wants more, which is what paces the mixer.
+    class AudioBackend {
+    public:
+        virtual ~AudioBackend() = default;
+
+        virtual bool Open(const unsigned sampleRate) = 0;
+        virtual void Submit(const float* frames, const std::size_t frameCount) = 0;
+        virtual void Close() {}
+    };
+
+    // Discards the mix. In real time it waits as long as a device would take to play each block;
+    // offline it returns at once, so a headless run mixes as fast as the CPU allows.
+    class NullAudioBackend : public AudioBackend {
+    public:
+        explicit NullAudioBackend(const bool realTime = false) : realTime(realTime) {}
+
+        bool Open(const unsigned sampleRate) override;
+        void Submit(const float* frames, const std::size_t frameCount) override;
+
+        std::uint64_t GetFrames() const { return frames.load(std::memory_order_relaxed); }
+        float GetPeak() const { return peak.load(std::memory_order_relaxed); }
+
+    private:
+        bool realTime;
+        unsigned sampleRate = 0;
+        std::chrono::steady_clock::time_point deadline;
+
+        std::atomic<std::uint64_t> frames{0};
+        std::atomic<float> peak{0.f};
+    };
+
+    // The sound card through OpenAL when the game is built with the `audio` vcpkg feature,
+    // otherwise null.
+    std::unique_ptr<AudioBackend> MakeDeviceBackend();
+
+    // One change to one mixer voice. Start begins `kind` `offset` samples in, so a source that
+    // was virtual for a while comes back where it would have been.
+    struct VoiceCommand {
+        enum class Type : std::uint8_t { Start, Update, Stop };
+
+        Type type = Type::Update;
+        std::uint8_t voice = 0;
+        SoundKind kind = SoundKind::Gunshot;
+        bool loop = false;
+        float gain = 0.f;
+        float pan = 0.f;
+        std::uint32_t offset = 0;
+    };
+
+    // Single producer, single consumer: the game thread pushes, the mixer thread drains.
+    template <typename T, std::size_t Capacity>
+    class CommandQueue {
+    public:
+        bool Push(const T& item) {
+            const std::size_t head = this->head.load(std::memory_order_relaxed);
+            if(head - tail.load(std::memory_order_acquire) >= Capacity) return false;
+
+            items[head % Capacity] = item;
+            this->head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        template <typename Sink>
+        std::size_t Drain(Sink&& sink) {
+            const std::size_t head = this->head.load(std::memory_order_acquire);
+            std::size_t tail = this->tail.load(std::memory_order_relaxed);
+            const std::size_t count = head - tail;
+
+            for(; tail != head; ++tail)
+                sink(items[tail % Capacity]);
+
+            this->tail.store(tail, std::memory_order_release);
+            return count;
+        }
+
+    private:
+        alignas(64) std::atomic<std::size_t> head{0};
+        alignas(64) std::atomic<std::size_t> tail{0};
+        std::array<T, Capacity> items{};
+    };
+
+    struct MixerStats {
+        std::uint64_t blocks = 0;
+        // Time spent mixing, without the time Submit blocked.
+        double mixSeconds = 0.0;
+        std::uint64_t droppedCommands = 0;
+        std::size_t activeVoices = 0;
+    };
+
+    // A fixed pool of voices mixed into stereo blocks on a thread of its own. The game never
+    // touches a voice directly: it sends VoiceCommands through a lock-free queue, and gain and
+    // pan changes are ramped over one block so they do not click.
+    class AudioMixer {
+    public:
+        constexpr static unsigned SAMPLE_RATE = 44100;
+        constexpr static std::size_t BLOCK_FRAMES = 512;
+        constexpr static std::size_t VOICE_COUNT = 16;
+        constexpr static std::size_t QUEUE_CAPACITY = 1024;
+
+        AudioMixer();
+        ~AudioMixer();
+
+        AudioMixer(const AudioMixer&) = delete;
+        AudioMixer& operator=(const AudioMixer&) = delete;
+
+        bool Start(std::unique_ptr<AudioBackend> backend);
+        void Stop();
+        bool IsRunning() const { return mixer.joinable(); }
+
+        // Game thread only. A full queue drops the command and counts it.
+        bool Send(const VoiceCommand& command);
+
+        // Drains the queue and mixes one block of BLOCK_FRAMES stereo frames into `out`. The mixer
+        // thread calls this; while it is not running, offline renders and benchmarks may.
+        void MixBlock(float* out);
+
+        const SoundBank& GetBank() const { return bank; }
+        MixerStats GetStats() const;
+
+    private:
+        struct Voice {
+            const std::vector<float>* clip = nullptr;
+            std::size_t position = 0;
+            bool loop = false;
+            bool active = false;
+            bool stopping = false;
+            // Started since the last block, so nothing of it has been heard yet.
+            bool fresh = false;
+            float gain = 0.f;
+            float pan = 0.f;
+            float targetGain = 0.f;
+            float targetPan = 0.f;
+
+            // What the voice played before a Start replaced it, faded out over the next block.
+            const std::vector<float>* fadingClip = nullptr;
+            std::size_t fadingPosition = 0;
+            bool fadingLoop = false;
+            float fadingGain = 0.f;
+            float fadingPan = 0.f;
+        };
+
+        SoundBank bank;
+        std::array<Voice, VOICE_COUNT> voices;
+        CommandQueue<VoiceCommand, QUEUE_CAPACITY> commands;
+
+        std::unique_ptr<AudioBackend> backend;
+        std::thread mixer;
+        std::atomic<bool> running{false};
+
+        std::atomic<std::uint64_t> blocks{0};
+        std::atomic<std::uint64_t> mixNanos{0};
+        std::atomic<std::uint64_t> dropped{0};
+        std::atomic<std::size_t> activeVoices{0};
+
+        void apply(const VoiceCommand& command);
+        void mixerLoop();
+    };
+}
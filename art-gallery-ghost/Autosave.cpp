@@ -0,0 +1,516 @@
+#include "Autosave.hpp"
+#include "WallShape.hpp"
+#include "FogOfWar.hpp"
+#include "ByteStream.hpp"
+#include "EventLog.hpp"
+#include "MemoryStats.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace core;
+
+namespace {
+    constexpr std::uint32_t MANIFEST_MAGIC = 0x56534741;   // "AGSV"
+    constexpr std::uint32_t CHUNK_MAGIC = 0x4b434741;      // "AGCK"
+    constexpr std::uint32_t SAVE_VERSION = 2;
+
+    constexpr std::string_view WALLS_PREFIX = "walls";
+    constexpr std::string_view FOG_PREFIX = "fog";
+    constexpr std::string_view CHUNK_EXTENSION = ".chunk";
+
+    // Run-length packing: a control byte below 128 is followed by that many plus one literal bytes,
+    // any other by one byte repeated control - 125 times. Fog chunks are long runs of 0x00 and 0xff.
+    constexpr std::size_t MAX_LITERAL = 128;
+    constexpr std::size_t MIN_RUN = 3;
+    constexpr std::size_t MAX_RUN = 130;
+
+    struct Manifest {
+        std::uint64_t generation = 0;
+        float mapSize = 0.f;
+        WorldState world{};
+        std::vector<std::uint64_t> wallFiles;
+        std::vector<std::uint64_t> fogFiles;
+    };
+
+    std::uint32_t checksum(const std::uint8_t* data, const std::size_t size) {
+        std::uint32_t hash = 2166136261u;
+        for(std::size_t i = 0; i < size; ++i)
+            hash = (hash ^ data[i]) * 16777619u;
+        return hash;
+    }
+
+    void pack(const std::vector<std::uint8_t>& raw, std::vector<std::uint8_t>& out) {
+        std::size_t i = 0;
+
+        while(i < raw.size()) {
+            std::size_t run = 1;
+            while(i + run < raw.size() && run < MAX_RUN && raw[i + run] == raw[i]) ++run;
+
+            if(run >= MIN_RUN) {
+                out.push_back(static_cast<std::uint8_t>(run + 125));
+                out.push_back(raw[i]);
+                i += run;
+                continue;
+            }
+
+            // Literals up to the next run worth packing.
+            std::size_t end = i;
+            while(end < raw.size() && end - i < MAX_LITERAL) {
+                if(end + 2 < raw.size() && raw[end] == raw[end + 1] && raw[end] == raw[end + 2]) break;
+                ++end;
+            }
+
+            out.push_back(static_cast<std::uint8_t>(end - i - 1));
+            out.insert(out.end(), raw.begin() + static_cast<std::ptrdiff_t>(i), raw.begin() + static_cast<std::ptrdiff_t>(end));
+            i = end;
+        }
+    }
+
+    bool unpack(const std::uint8_t* data, const std::size_t size, const std::size_t rawSize, std::vector<std::uint8_t>& out) {
+        out.clear();
+        out.reserve(rawSize);
+
+        std::size_t i = 0;
+        while(i < size) {
+            const std::uint8_t control = data[i++];
+
+            if(control < 128) {
+                const std::size_t count = control + 1u;
+                if(count > size - i || out.size() + count > rawSize) return false;
+
+                out.insert(out.end(), data + i, data + i + count);
+                i += count;
+            }
+            else {
+                const std::size_t count = control - 125u;
+                if(i == size || out.size() + count > rawSize) return false;
+
+                out.insert(out.end(), count, data[i++]);
+            }
+        }
+
+        return out.size() == rawSize;
+    }
+
+    std::string chunkFileName(const std::string_view prefix, const std::uint32_t index, const std::uint64_t generation) {
+        return std::string(prefix) + '-' + std::to_string(index) + '-' + std::to_string(generation) + std::string(CHUNK_EXTENSION);
+    }
+
+    // "walls-12-34.chunk" -> walls, 12, 34.
+    bool parseChunkFileName(const std::string& name, std::string_view& prefix, std::uint32_t& index, std::uint64_t& generation) {
+        const std::string_view view(name);
+        if(view.size() <= CHUNK_EXTENSION.size() || !view.ends_with(CHUNK_EXTENSION)) return false;
+
+        const std::string_view stem = view.substr(0, view.size() - CHUNK_EXTENSION.size());
+        const std::size_t first = stem.find('-');
+        const std::size_t last = stem.rfind('-');
+        if(first == std::string_view::npos || first == last) return false;
+
+        prefix = stem.substr(0, first);
+        const char* indexEnd = stem.data() + last;
+        const char* generationEnd = stem.data() + stem.size();
+
+        return std::from_chars(stem.data() + first + 1, indexEnd, index).ptr == indexEnd
+            && std::from_chars(indexEnd + 1, generationEnd, generation).ptr == generationEnd;
+    }
+
+    bool readFile(const std::filesystem::path& path, std::vector<std::uint8_t>& bytes) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if(!file) return false;
+
+        bytes.resize(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size())));
+    }
+
+    // Returns only once the bytes are on the disk, not just in the OS cache.
+    bool writeDurably(const std::filesystem::path& path, const std::vector<std::uint8_t>& bytes) {
+        std::FILE* file = std::fopen(path.string().c_str(), "wb");
+        if(!file) return false;
+
+        bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size() && std::fflush(file) == 0;
+#if defined(_WIN32)
+        written = written && _commit(_fileno(file)) == 0;
+#else
+        written = written && fsync(fileno(file)) == 0;
+#endif
+
+        return std::fclose(file) == 0 && written;
+    }
+
+    // Makes created and renamed entries durable. NTFS journals those itself.
+    bool syncDirectory(const std::filesystem::path& directory) {
+#if defined(_WIN32)
+        return true;
+#else
+        const int fd = open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+        if(fd < 0) return false;
+
+        const bool synced = fsync(fd) == 0;
+        close(fd);
+        return synced;
+#endif
+    }
+
+    void encodeChunk(const std::vector<std::uint8_t>& raw, std::vector<std::uint8_t>& out) {
+        ByteWriter writer(out);
+        writer.Write(CHUNK_MAGIC);
+        writer.Write(static_cast<std::uint32_t>(raw.size()));
+        writer.Write(checksum(raw.data(), raw.size()));
+        pack(raw, out);
+    }
+
+    bool readChunk(const std::filesystem::path& path, std::vector<std::uint8_t>& raw) {
+        std::vector<std::uint8_t> bytes;
+        if(!readFile(path, bytes)) return false;
+
+        ByteReader in(bytes);
+        std::uint32_t magic = 0, rawSize = 0, sum = 0;
+        if(!in.Read(magic) || magic != CHUNK_MAGIC || !in.Read(rawSize) || !in.Read(sum)) return false;
+
+        const std::size_t header = bytes.size() - in.GetRemaining();
+        return unpack(bytes.data() + header, in.GetRemaining(), rawSize, raw) && checksum(raw.data(), raw.size()) == sum;
+    }
+
+    void encodeManifest(const Manifest& manifest, std::vector<std::uint8_t>& out) {
+        ByteWriter writer(out);
+        writer.Write(MANIFEST_MAGIC);
+        writer.Write(SAVE_VERSION);
+        writer.Write(manifest.generation);
+        writer.Write(manifest.mapSize);
+        writer.Write(manifest.world);
+
+        writer.Write(static_cast<std::uint32_t>(manifest.wallFiles.size()));
+        writer.WriteBytes(manifest.wallFiles.data(), manifest.wallFiles.size() * sizeof(std::uint64_t));
+        writer.Write(static_cast<std::uint32_t>(manifest.fogFiles.size()));
+        writer.WriteBytes(manifest.fogFiles.data(), manifest.fogFiles.size() * sizeof(std::uint64_t));
+
+        writer.Write(checksum(out.data(), out.size()));
+    }
+
+    bool finite(const sf::Vector2f& v) { return std::isfinite(v.x) && std::isfinite(v.y); }
+
+    // The checksum only catches damaged files; a save from a mismatched build or an edited one
+    // passes it. Anything the restore would index or divide by is checked here.
+    bool validWorld(const WorldState& world) {
+        const Gun::State& gun = world.gun;
+        if(gun.bulletCount > Gun::MAX_BULLETS || gun.ammo < 0 || gun.ammo > Gun::MAX_AMMO) return false;
+
+        for(std::uint32_t i = 0; i < gun.bulletCount; ++i) {
+            const Gun::Bullet& bullet = gun.bullets[i];
+            if(!finite(bullet.position) || !finite(bullet.direction) || !std::isfinite(bullet.lifetime)) return false;
+        }
+
+        const FlashLight::State& light = world.flashlight;
+        return finite(world.movement.pos) && finite(world.movement.velocity)
+            && std::isfinite(light.fanWidth) && std::isfinite(light.radius) && std::isfinite(light.startAngle);
+    }
+
+    bool readFileList(ByteReader& in, std::vector<std::uint64_t>& files) {
+        std::uint32_t count = 0;
+        if(!in.Read(count) || count > in.GetRemaining() / sizeof(std::uint64_t)) return false;
+
+        files.resize(count);
+        return in.ReadBytes(files.data(), count * sizeof(std::uint64_t));
+    }
+
+    bool readManifest(const std::filesystem::path& directory, Manifest& manifest) {
+        std::vector<std::uint8_t> bytes;
+        if(!readFile(directory / Autosave::MANIFEST, bytes) || bytes.size() < sizeof(std::uint32_t)) return false;
+
+        const std::size_t body = bytes.size() - sizeof(std::uint32_t);
+        std::uint32_t sum = 0;
+        std::memcpy(&sum, bytes.data() + body, sizeof(sum));
+        if(sum != checksum(bytes.data(), body)) return false;
+
+        ByteReader in(bytes.data(), body);
+        std::uint32_t magic = 0, version = 0;
+
+        return in.Read(magic) && magic == MANIFEST_MAGIC && in.Read(version) && version == SAVE_VERSION
+            && in.Read(manifest.generation) && in.Read(manifest.mapSize) && in.Read(manifest.world)
+            && std::isfinite(manifest.mapSize) && manifest.mapSize > 0.f && validWorld(manifest.world)
+            && readFileList(in, manifest.wallFiles) && readFileList(in, manifest.fogFiles) && in.AtEnd();
+    }
+
+    bool readChunks(const std::filesystem::path& directory, const std::string_view prefix,
+                    const std::vector<std::uint64_t>& files, std::vector<std::vector<std::uint8_t>>& chunks) {
+        chunks.resize(files.size());
+
+        for(std::uint32_t i = 0; i < files.size(); ++i) {
+            if(!readChunk(directory / chunkFileName(prefix, i, files[i]), chunks[i])) {
+                std::cerr << "[autosave] cannot read " << chunkFileName(prefix, i, files[i]) << std::endl;
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+bool Autosave::Start(const std::filesystem::path& directory) {
+    if(IsRunning()) return true;
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if(error) {
+        std::cerr << "[autosave] cannot create " << directory.string() << ": " << error.message() << std::endl;
+        return false;
+    }
+
+    this->directory = directory;
+
+    // New files are numbered past the existing save, which stays valid until they replace it.
+    Manifest manifest;
+    if(readManifest(directory, manifest)) {
+        generation = manifest.generation;
+        wallFiles = std::move(manifest.wallFiles);
+        fogFiles = std::move(manifest.fogFiles);
+    }
+
+    stopping = false;
+    worker = std::thread(&Autosave::workerLoop, this);
+    return true;
+}
+
+void Autosave::Stop() {
+    if(!IsRunning()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+
+    wake.notify_one();
+    worker.join();
+    collectResult();
+}
+
+void Autosave::Wait() {
+    if(!IsRunning()) return;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return !busy.load(std::memory_order_acquire); });
+    lock.unlock();
+
+    collectResult();
+}
+
+bool Autosave::Capture(const WorldState& world, const float mapSize, const WallShape& walls, const FogOfWar& fog) {
+    if(!IsRunning() || busy.load(std::memory_order_acquire)) return false;
+
+    MemoryScope scope(MemoryTag::Save);
+    collectResult();
+
+    // Chunks never saved get a revision they cannot have yet.
+    savedWalls.resize(walls.GetChunkCount(), UINT32_MAX);
+    savedFog.resize(fog.GetChunkCount(), UINT32_MAX);
+
+    job.mapSize = mapSize;
+    job.world = world;
+    job.wallChunks = static_cast<std::uint32_t>(walls.GetChunkCount());
+    job.fogChunks = static_cast<std::uint32_t>(fog.GetChunkCount());
+    job.chunkCount = 0;
+
+    for(std::uint32_t chunk = 0; chunk < job.wallChunks; ++chunk) {
+        const std::uint32_t revision = walls.GetChunkRevision(chunk);
+        if(revision == savedWalls[chunk]) continue;
+
+        ChunkCopy& copy = nextChunk();
+        copy.kind = Kind::Walls;
+        copy.index = chunk;
+        copy.revision = revision;
+
+        ByteWriter out(copy.bytes);
+        walls.WriteChunk(chunk, out);
+    }
+
+    for(std::uint32_t chunk = 0; chunk < job.fogChunks; ++chunk) {
+        const std::uint32_t revision = fog.GetChunkRevision(chunk);
+        if(revision == savedFog[chunk]) continue;
+
+        ChunkCopy& copy = nextChunk();
+        copy.kind = Kind::Fog;
+        copy.index = chunk;
+        copy.revision = revision;
+
+        ByteWriter out(copy.bytes);
+        fog.WriteChunk(chunk, out);
+    }
+
+    pendingResult = true;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        busy.store(true, std::memory_order_release);
+    }
+
+    wake.notify_one();
+    return true;
+}
+
+void Autosave::MarkSaved(const WallShape& walls, const FogOfWar& fog) {
+    savedWalls.resize(walls.GetChunkCount());
+    for(std::size_t chunk = 0; chunk < savedWalls.size(); ++chunk)
+        savedWalls[chunk] = walls.GetChunkRevision(chunk);
+
+    savedFog.resize(fog.GetChunkCount());
+    for(std::size_t chunk = 0; chunk < savedFog.size(); ++chunk)
+        savedFog[chunk] = fog.GetChunkRevision(chunk);
+}
+
+bool Autosave::Load(const std::filesystem::path& directory, SaveGame& save) {
+    Manifest manifest;
+    if(!readManifest(directory, manifest)) return false;
+
+    save.mapSize = manifest.mapSize;
+    save.world = manifest.world;
+
+    return readChunks(directory, WALLS_PREFIX, manifest.wallFiles, save.walls)
+        && readChunks(directory, FOG_PREFIX, manifest.fogFiles, save.fog);
+}
+
+Autosave::ChunkCopy& Autosave::nextChunk() {
+    // Copies are reused between saves so their buffers keep their capacity.
+    if(job.chunkCount == job.chunks.size()) job.chunks.emplace_back();
+
+    ChunkCopy& copy = job.chunks[job.chunkCount++];
+    copy.bytes.clear();
+    return copy;
+}
+
+void Autosave::collectResult() {
+    if(!pendingResult) return;
+    pendingResult = false;
+
+    // A failed save leaves its chunks dirty, so the next one writes them again.
+    if(!job.succeeded) return;
+
+    for(std::size_t i = 0; i < job.chunkCount; ++i) {
+        const ChunkCopy& copy = job.chunks[i];
+        (copy.kind == Kind::Walls ? savedWalls : savedFog)[copy.index] = copy.revision;
+    }
+}
+
+void Autosave::workerLoop() {
+    MemoryScope scope(MemoryTag::Save);
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while(true) {
+        wake.wait(lock, [this] { return stopping || busy.load(std::memory_order_relaxed); });
+
+        // A job handed over before Stop() is still written.
+        if(busy.load(std::memory_order_relaxed)) {
+            lock.unlock();
+            job.succeeded = write(job);
+            lock.lock();
+
+            busy.store(false, std::memory_order_release);
+            idle.notify_all();
+            continue;
+        }
+
+        if(stopping) return;
+    }
+}
+
+bool Autosave::write(Job& job) {
+    const auto start = std::chrono::steady_clock::now();
+    const std::uint64_t current = ++generation;
+
+    Manifest manifest;
+    manifest.generation = current;
+    manifest.mapSize = job.mapSize;
+    manifest.world = job.world;
+    manifest.wallFiles = wallFiles;
+    manifest.fogFiles = fogFiles;
+    manifest.wallFiles.resize(job.wallChunks, 0);
+    manifest.fogFiles.resize(job.fogChunks, 0);
+
+    std::vector<std::uint8_t> bytes;
+    std::size_t written = 0;
+
+    for(std::size_t i = 0; i < job.chunkCount; ++i) {
+        const ChunkCopy& copy = job.chunks[i];
+        const std::string_view prefix = copy.kind == Kind::Walls ? WALLS_PREFIX : FOG_PREFIX;
+        const std::string name = chunkFileName(prefix, copy.index, current);
+
+        bytes.clear();
+        encodeChunk(copy.bytes, bytes);
+
+        if(!writeDurably(directory / name, bytes)) {
+            std::cerr << "[autosave] cannot write " << name << std::endl;
+            return false;
+        }
+
+        (copy.kind == Kind::Walls ? manifest.wallFiles : manifest.fogFiles)[copy.index] = current;
+        written += bytes.size();
+    }
+
+    for(const auto* files : {&manifest.wallFiles, &manifest.fogFiles}) {
+        if(std::find(files->begin(), files->end(), std::uint64_t{0}) != files->end()) {
+            std::cerr << "[autosave] save " << current << " is missing chunks" << std::endl;
+            return false;
+        }
+    }
+
+    // The chunk files must be durable before a manifest names them, and the manifest before the
+    // files it replaces are removed.
+    const std::filesystem::path temporary = directory / (std::string(MANIFEST) + ".tmp");
+
+    bytes.clear();
+    encodeManifest(manifest, bytes);
+
+    std::error_code error;
+    if(!syncDirectory(directory) || !writeDurably(temporary, bytes)) {
+        std::cerr << "[autosave] cannot write the manifest for save " << current << std::endl;
+        return false;
+    }
+
+    std::filesystem::rename(temporary, directory / MANIFEST, error);
+    if(error || !syncDirectory(directory)) {
+        std::cerr << "[autosave] cannot commit save " << current << ": " << error.message() << std::endl;
+        return false;
+    }
+
+    wallFiles = std::move(manifest.wallFiles);
+    fogFiles = std::move(manifest.fogFiles);
+    removeStaleFiles();
+
+    const float ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    EventLog::Emit(Event::Autosave, static_cast<std::uint32_t>(current), static_cast<std::uint32_t>(job.chunkCount),
+        static_cast<float>(written + bytes.size()) / 1024.f, ms);
+    return true;
+}
+
+void Autosave::removeStaleFiles() const {
+    std::error_code error;
+
+    for(const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        const std::string name = entry.path().filename().string();
+        std::string_view prefix;
+        std::uint32_t index = 0;
+        std::uint64_t fileGeneration = 0;
+        if(!parseChunkFileName(name, prefix, index, fileGeneration)) continue;
+
+        const std::vector<std::uint64_t>* files = prefix == WALLS_PREFIX ? &wallFiles : prefix == FOG_PREFIX ? &fogFiles : nullptr;
+        if(!files || (index < files->size() && (*files)[index] == fileGeneration)) continue;
+
+        std::error_code removeError;
+        std::filesystem::remove(entry.path(), removeError);
+    }
+}
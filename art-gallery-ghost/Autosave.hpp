@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Rollback.hpp"
+
+class WallShape;
+
+namespace core {
+    class FogOfWar;
+
+    // A save as read back from disk: the simulation state plus one serialized chunk per WallShape
+    // and FogOfWar chunk, in chunk order.
+    struct SaveGame {
+        float mapSize = 0.f;
+        WorldState world{};
+        std::vector<std::vector<std::uint8_t>> walls;
+        std::vector<std::vector<std::uint8_t>> fog;
+    };
+
+    // Saves the offline world into a directory without stalling the game loop. Capture() runs at a
+    // tick boundary and only copies the world state and the chunks whose revision changed since
+    // the last save that reached the disk; a worker thread compresses them, writes each to a new
+    // file and fsyncs it, and only then swaps in a new manifest naming every chunk's current file.
+    // A crash at any point leaves the previous manifest and all of the files it names intact.
+    class Autosave {
+    public:
+        constexpr static const char* MANIFEST = "autosave.manifest";
+
+        ~Autosave() { Stop(); }
+
+        // Starts the writer. An existing save in `directory` is kept until the first new one lands.
+        bool Start(const std::filesystem::path& directory);
+
+        // Finishes the save in flight, if any, and stops the writer.
+        void Stop();
+
+        // Blocks until the save in flight reaches the disk. Only meant for shutdown.
+        void Wait();
+
+        // Hands a snapshot to the writer. Returns false without copying anything while the
+        // previous save is still being written; dirty chunks then simply wait for the next call.
+        bool Capture(const WorldState& world, const float mapSize, const WallShape& walls, const FogOfWar& fog);
+
+        // Counts the current chunks as saved, after the world was just restored from this save.
+        void MarkSaved(const WallShape& walls, const FogOfWar& fog);
+
+        bool IsRunning() const { return worker.joinable(); }
+        bool IsWriting() const { return busy.load(std::memory_order_acquire); }
+
+        static bool Load(const std::filesystem::path& directory, SaveGame& save);
+
+    private:
+        enum class Kind : std::uint8_t { Walls, Fog };
+
+        struct ChunkCopy {
+            Kind kind = Kind::Walls;
+            std::uint32_t index = 0;
+            std::uint32_t revision = 0;
+            std::vector<std::uint8_t> bytes;
+        };
+
+        // Written by Capture() while the worker is idle, read by the worker while it is busy.
+        struct Job {
+            float mapSize = 0.f;
+            WorldState world{};
+            std::uint32_t wallChunks = 0;
+            std::uint32_t fogChunks = 0;
+            std::vector<ChunkCopy> chunks;
+            std::size_t chunkCount = 0;
+            bool succeeded = false;
+        };
+
+        std::filesystem::path directory;
+        Job job;
+
+        // Main thread: revisions that reached the disk, and whether `job` still has to be accounted.
+        std::vector<std::uint32_t> savedWalls;
+        std::vector<std::uint32_t> savedFog;
+        bool pendingResult = false;
+
+        // Worker thread: the generation of the file each chunk lives in, as named by the manifest.
+        std::vector<std::uint64_t> wallFiles;
+        std::vector<std::uint64_t> fogFiles;
+        std::uint64_t generation = 0;
+
+        std::thread worker;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable idle;
+        std::atomic<bool> busy{false};
+        bool stopping = false;
+
+        ChunkCopy& nextChunk();
+        void collectResult();
+
+        void workerLoop();
+        bool write(Job& job);
+        void removeStaleFiles() const;
+    };
+}
@@ -0,0 +1,99 @@
+#include "BatchRunner.hpp"
+
+#include "MemoryStats.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+using namespace core;
+
+BatchRunner::BatchRunner(const std::size_t threadCount) {
+    const std::size_t count = threadCount ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+
+    workers.reserve(count);
+    for(std::size_t i = 0; i < count; ++i)
+        workers.emplace_back(&BatchRunner::workerLoop, this);
+}
+
+BatchRunner::~BatchRunner() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+
+    wake.notify_all();
+    for(std::thread& worker : workers)
+        worker.join();
+}
+
+void BatchRunner::Populate(const std::size_t count, const WorldConfig& config) {
+    const std::size_t first = entries.size();
+    entries.resize(first + count);
+
+    parallelFor(count, [this, first, &config](const std::size_t i) {
+        WorldConfig seeded = config;
+        seeded.seed = config.seed + static_cast<std::uint32_t>(i);
+        entries[first + i] = std::make_unique<Entry>(seeded);
+    });
+}
+
+BatchStats BatchRunner::Run(const std::uint32_t ticks) {
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+
+    parallelFor(entries.size(), [this, ticks](const std::size_t index) {
+        Entry& entry = *entries[index];
+
+        for(std::uint32_t tick = 0; tick < ticks; ++tick) {
+            World& world = entry.world;
+            world.Step(script ? script(index, world)
+                : entry.input.Next(world.GetConfig().tickTime, world.GetPlayer().GetCenter().GetWorldPosition()));
+        }
+    });
+
+    BatchStats stats;
+    stats.worlds = entries.size();
+    stats.threads = workers.size();
+    stats.ticks = static_cast<std::uint64_t>(entries.size()) * ticks;
+    stats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return stats;
+}
+
+void BatchRunner::parallelFor(const std::size_t count, const std::function<void(std::size_t)>& body) {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    job = &body;
+    jobSize = count;
+    nextIndex.store(0, std::memory_order_relaxed);
+    busyWorkers = workers.size();
+    ++generation;
+
+    wake.notify_all();
+    done.wait(lock, [this] { return busyWorkers == 0; });
+
+    job = nullptr;
+}
+
+void BatchRunner::workerLoop() {
+    MemoryScope scope(MemoryTag::Gameplay);
+    std::uint64_t seen = 0;
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while(true) {
+        wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+        if(stopping) return;
+
+        seen = generation;
+        const std::function<void(std::size_t)>& body = *job;
+        const std::size_t size = jobSize;
+        lock.unlock();
+
+        for(std::size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed); index < size;
+            index = nextIndex.fetch_add(1, std::memory_order_relaxed))
+            body(index);
+
+        lock.lock();
+        if(--busyWorkers == 0) done.notify_one();
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "World.hpp"
+#include "ScriptedInput.hpp"
+
+namespace core {
+    struct BatchStats {
+        std::size_t worlds = 0;
+        std::size_t threads = 0;
+        std::uint64_t ticks = 0;
+        double seconds = 0.0;
+
+        double GetTicksPerSecond() const { return seconds > 0.0 ? static_cast<double>(ticks) / seconds : 0.0; }
+    };
+
+    // Steps many independent headless worlds on a fixed pool of threads, for soak tests and AI
+    // tuning. Worlds share nothing, so a worker takes whole worlds off a shared counter and runs
+    // each for all requested ticks back to back: no per-tick barrier, and one world's state stays
+    // in one core's cache while it runs.
+    class BatchRunner {
+    public:
+        // Replaces the ScriptedInput of every world. Called on the worker threads, never for the
+        // same world twice at once.
+        using Script = std::function<InputCommand(const std::size_t index, const World& world)>;
+
+        // No thread count means one per hardware thread.
+        explicit BatchRunner(const std::size_t threadCount = 0);
+        ~BatchRunner();
+
+        BatchRunner(const BatchRunner&) = delete;
+        BatchRunner& operator=(const BatchRunner&) = delete;
+
+        // Adds `count` worlds, built on the pool. World i is seeded `config.seed + i` and played by
+        // a ScriptedInput with the same seed.
+        void Populate(const std::size_t count, const WorldConfig& config);
+        void Clear() { entries.clear(); }
+
+        void SetScript(Script script) { this->script = std::move(script); }
+
+        // Steps every world `ticks` times and returns once all of them are done.
+        BatchStats Run(const std::uint32_t ticks);
+
+        World& GetWorld(const std::size_t index) { return entries[index]->world; }
+        std::size_t GetWorldCount() const { return entries.size(); }
+        std::size_t GetThreadCount() const { return workers.size(); }
+
+    private:
+        // Allocated one by one so neighbouring worlds stepped on different cores share no cache lines.
+        struct Entry {
+            World world;
+            ScriptedInput input;
+
+            explicit Entry(const WorldConfig& config) : world(config), input(config.seed) {}
+        };
+
+        std::vector<std::unique_ptr<Entry>> entries;
+        Script script;
+
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+
+        // The job in flight, handed out one index at a time.
+        const std::function<void(std::size_t)>* job = nullptr;
+        std::size_t jobSize = 0;
+        std::atomic<std::size_t> nextIndex{0};
+        std::size_t busyWorkers = 0;
+        std::uint64_t generation = 0;
+        bool stopping = false;
+
+        void parallelFor(const std::size_t count, const std::function<void(std::size_t)>& body);
+        void workerLoop();
+    };
+}
@@ -0,0 +1,134 @@
+#include "Behavior.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace core;
+
+void WaitAwaiter::await_suspend(const Behavior::Handle handle) {
+    this->handle = handle;
+
+    BehaviorScheduler& scheduler = *handle.promise().scheduler;
+    const std::uint32_t slot = handle.promise().slot;
+    const std::uint32_t wait = scheduler.slots[slot].wait;
+
+    scheduler.slots[slot].triggered = false;
+
+    if(trigger)
+        trigger->add(scheduler, slot);
+
+    if(std::isfinite(seconds))
+        scheduler.timers.push({scheduler.time + std::max(0.f, seconds), slot, wait});
+}
+
+bool WaitAwaiter::await_resume() const noexcept {
+    const auto& promise = handle.promise();
+    return promise.scheduler->slots[promise.slot].triggered;
+}
+
+void Trigger::Fire() {
+    for(const Waiter& waiter : waiters)
+        scheduler->wake(waiter.slot, waiter.wait, true);
+
+    waiters.clear();
+}
+
+void Trigger::add(BehaviorScheduler& scheduler, const std::uint32_t slot) {
+    this->scheduler = &scheduler;
+
+    // Drop registrations whose wait already ended on a timeout, so an unfired trigger stays small.
+    waiters.erase(std::remove_if(waiters.begin(), waiters.end(),
+        [&scheduler](const Waiter& waiter) { return !scheduler.pending(waiter.slot, waiter.wait); }),
+        waiters.end());
+
+    waiters.push_back({slot, scheduler.slots[slot].wait});
+}
+
+BehaviorScheduler::~BehaviorScheduler() {
+    Clear();
+}
+
+void BehaviorScheduler::Spawn(Behavior behavior) {
+    std::uint32_t slot;
+    if(freeSlots.empty()) {
+        slot = static_cast<std::uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+    else {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+
+    Behavior::Handle handle = behavior.handle;
+    behavior.handle = {};
+
+    handle.promise().scheduler = this;
+    handle.promise().slot = slot;
+
+    slots[slot].handle = handle;
+    ready.push_back(slot);
+}
+
+void BehaviorScheduler::Reserve(const std::size_t count) {
+    slots.reserve(count);
+    ready.reserve(count);
+    resuming.reserve(count);
+
+    // A behavior has at most one live timer, but retired ones stay queued until they come up.
+    std::vector<Timer> storage;
+    storage.reserve(count * 2);
+    while(!timers.empty()) {
+        storage.push_back(timers.top());
+        timers.pop();
+    }
+
+    timers = decltype(timers)(std::greater<Timer>{}, std::move(storage));
+}
+
+void BehaviorScheduler::Tick(const float deltaTime) {
+    time += deltaTime;
+
+    while(!timers.empty() && timers.top().at <= time) {
+        const Timer timer = timers.top();
+        timers.pop();
+        wake(timer.slot, timer.wait, false);
+    }
+
+    // Behaviors woken while this batch runs wait for the next tick.
+    resuming.swap(ready);
+    resumed = resuming.size();
+
+    for(const std::uint32_t slot : resuming) {
+        const Behavior::Handle handle = slots[slot].handle;
+        if(!handle) continue;
+
+        handle.resume();
+        if(handle.done()) release(slot);
+    }
+
+    resuming.clear();
+}
+
+void BehaviorScheduler::Clear() {
+    for(std::uint32_t slot = 0; slot < slots.size(); ++slot) {
+        if(slots[slot].handle) release(slot);
+    }
+
+    timers = {};
+    ready.clear();
+}
+
+void BehaviorScheduler::wake(const std::uint32_t slot, const std::uint32_t wait, const bool triggered) {
+    if(!pending(slot, wait) || !slots[slot].handle) return;
+
+    ++slots[slot].wait;
+    slots[slot].triggered = triggered;
+    ready.push_back(slot);
+}
+
+void BehaviorScheduler::release(const std::uint32_t slot) {
+    slots[slot].handle.destroy();
+    slots[slot].handle = {};
+    ++slots[slot].wait;
+    freeSlots.push_back(slot);
+}
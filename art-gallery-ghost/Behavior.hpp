@@ -0,0 +1,146 @@
+#pragma once
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <vector>
+
+namespace core {
+    class BehaviorScheduler;
+    class Trigger;
+
+    // Script written as a C++20 coroutine. It starts suspended and runs once handed to
+    // BehaviorScheduler::Spawn; between awaits it costs nothing.
+    class Behavior {
+    public:
+        struct promise_type {
+            BehaviorScheduler* scheduler = nullptr;
+            std::uint32_t slot = 0;
+
+            Behavior get_return_object() { return Behavior(Handle::from_promise(*this)); }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        Behavior(Behavior&& other) noexcept : handle(other.handle) { other.handle = {}; }
+        Behavior(const Behavior&) = delete;
+        Behavior& operator=(const Behavior&) = delete;
+        Behavior& operator=(Behavior&&) = delete;
+
+        ~Behavior() {
+            if(handle) handle.destroy();
+        }
+
+    private:
+        friend class BehaviorScheduler;
+
+        explicit Behavior(const Handle handle) : handle(handle) {}
+
+        Handle handle;
+    };
+
+    // Result of Wait / WaitUntil. Resumes with true when the trigger fired, false on timeout.
+    struct WaitAwaiter {
+        float seconds = 0.f;
+        Trigger* trigger = nullptr;
+        Behavior::Handle handle;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(const Behavior::Handle handle);
+        bool await_resume() const noexcept;
+    };
+
+    constexpr float FOREVER = std::numeric_limits<float>::infinity();
+
+    inline WaitAwaiter Wait(const float seconds) { return {seconds, nullptr, {}}; }
+    inline WaitAwaiter WaitUntil(Trigger& trigger, const float timeout = FOREVER) { return {timeout, &trigger, {}}; }
+
+    // Edge-triggered condition: Fire() wakes the behaviors waiting on it right now and
+    // remembers nothing, so a behavior that starts waiting afterwards waits for the next Fire().
+    class Trigger {
+    public:
+        void Fire();
+        bool HasWaiters() const { return !waiters.empty(); }
+        void Reserve(const std::size_t count) { waiters.reserve(count); }
+
+    private:
+        friend struct WaitAwaiter;
+
+        struct Waiter {
+            std::uint32_t slot;
+            std::uint32_t wait;
+        };
+
+        BehaviorScheduler* scheduler = nullptr;
+        std::vector<Waiter> waiters;
+
+        void add(BehaviorScheduler& scheduler, const std::uint32_t slot);
+    };
+
+    // Resumes only behaviors whose timer expired or whose trigger fired, so a crowd of idle
+    // behaviors costs a heap peek per tick. Timers and trigger registrations carry the wait
+    // generation of their slot; whichever wakes a behavior first retires the other lazily.
+    class BehaviorScheduler {
+    public:
+        BehaviorScheduler() = default;
+        ~BehaviorScheduler();
+
+        BehaviorScheduler(const BehaviorScheduler&) = delete;
+        BehaviorScheduler& operator=(const BehaviorScheduler&) = delete;
+
+        // Takes ownership; the behavior first runs on the next Tick().
+        void Spawn(Behavior behavior);
+
+        // Sizes the queues for `count` behaviors, so ticking them never grows the heap.
+        void Reserve(const std::size_t count);
+
+        // Advances the clock, then resumes every behavior that became due.
+        void Tick(const float deltaTime);
+
+        // Destroys every behavior, suspended or not.
+        void Clear();
+
+        double GetTime() const { return time; }
+        std::size_t GetCount() const { return slots.size() - freeSlots.size(); }
+        std::size_t GetResumed() const { return resumed; }
+
+    private:
+        friend struct WaitAwaiter;
+        friend class Trigger;
+
+        struct Slot {
+            Behavior::Handle handle;
+            std::uint32_t wait = 0;
+            bool triggered = false;
+        };
+
+        struct Timer {
+            double at;
+            std::uint32_t slot;
+            std::uint32_t wait;
+
+            bool operator>(const Timer& other) const { return at > other.at; }
+        };
+
+        std::vector<Slot> slots;
+        std::vector<std::uint32_t> freeSlots;
+
+        std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers;
+        std::vector<std::uint32_t> ready;
+        std::vector<std::uint32_t> resuming;
+
+        double time = 0.0;
+        std::size_t resumed = 0;
+
+        bool pending(const std::uint32_t slot, const std::uint32_t wait) const { return slots[slot].wait == wait; }
+        void wake(const std::uint32_t slot, const std::uint32_t wait, const bool triggered);
+        void release(const std::uint32_t slot);
+    };
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace core {
+    // Appends values as their raw bytes. Saves are native-endian and versioned, not portable.
+    class ByteWriter {
+    public:
+        explicit ByteWriter(std::vector<std::uint8_t>& out) : out(out) {}
+
+        template <typename T>
+        void Write(const T& value) {
+            static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable values are written as bytes");
+            WriteBytes(&value, sizeof(T));
+        }
+
+        void WriteBytes(const void* data, const std::size_t size) {
+            const auto* bytes = static_cast<const std::uint8_t*>(data);
+            out.insert(out.end(), bytes, bytes + size);
+        }
+
+    private:
+        std::vector<std::uint8_t>& out;
+    };
+
+    // Reads what ByteWriter wrote. Every read is bounds-checked; once the data runs out, that read
+    // and every later one fail and Ok() turns false, so a run of reads can be checked once.
+    class ByteReader {
+    public:
+        ByteReader(const std::uint8_t* data, const std::size_t size) : data(data), size(size) {}
+        explicit ByteReader(const std::vector<std::uint8_t>& bytes) : ByteReader(bytes.data(), bytes.size()) {}
+
+        template <typename T>
+        bool Read(T& value) {
+            static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable values are read as bytes");
+            return ReadBytes(&value, sizeof(T));
+        }
+
+        // The next value, or T{} once the data has run out; check Ok() after a run of these.
+        template <typename T>
+        T Take() {
+            T value{};
+            Read(value);
+            return value;
+        }
+
+        bool ReadBytes(void* out, const std::size_t count) {
+            if(failed || count > size - offset) {
+                failed = true;
+                return false;
+            }
+
+            std::memcpy(out, data + offset, count);
+            offset += count;
+            return true;
+        }
+
+        bool Ok() const { return !failed; }
+        bool AtEnd() const { return offset == size; }
+        std::size_t GetRemaining() const { return size - offset; }
+
+    private:
+        const std::uint8_t* data = nullptr;
+        std::size_t size = 0;
+        std::size_t offset = 0;
+        bool failed = false;
+    };
+}
@@ -0,0 +1,166 @@
+#include "Client.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+using namespace net;
+
+bool Client::Connect(const std::string& host, const unsigned short port, const float timeoutSeconds) {
+    serverAddress = sf::IpAddress::resolve(host);
+    serverPort = port;
+
+    if(!serverAddress) {
+        std::cerr << "[client] cannot resolve " << host << std::endl;
+        return false;
+    }
+
+    if(socket.bind(sf::Socket::AnyPort) != sf::Socket::Status::Done) {
+        std::cerr << "[client] cannot bind a UDP port" << std::endl;
+        return false;
+    }
+
+    socket.setBlocking(false);
+
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(timeoutSeconds));
+    auto nextHello = Clock::now();
+
+    std::array<std::uint8_t, MAX_PACKET_SIZE> buffer{};
+    std::size_t size = 0;
+    std::optional<sf::IpAddress> sender;
+    unsigned short senderPort = 0;
+
+    while(Clock::now() < deadline) {
+        if(Clock::now() >= nextHello) {
+            sendHello();
+            nextHello += std::chrono::milliseconds(250);
+        }
+
+        while(socket.receive(buffer.data(), buffer.size(), size, sender, senderPort) == sf::Socket::Status::Done) {
+            core::ByteReader reader(buffer.data(), size);
+            if(reader.Take<MessageType>() != MessageType::Welcome) continue;
+
+            playerId = reader.Take<std::uint16_t>();
+            mapSeed = reader.Take<std::uint32_t>();
+            mapSize = reader.Take<float>();
+            reader.Take<std::uint32_t>();
+
+            if(!reader.Ok()) continue;
+
+            connected = true;
+            nextReport = Clock::now() + std::chrono::seconds(1);
+
+            std::cout << "[client] joined " << host << ":" << port << " as player " << playerId << std::endl;
+            return true;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::cerr << "[client] no answer from " << host << ":" << port << std::endl;
+    return false;
+}
+
+void Client::Disconnect() {
+    if(!connected) return;
+
+    packet.clear();
+    core::ByteWriter writer(packet);
+    writer.Write(MessageType::Bye);
+    static_cast<void>(socket.send(packet.data(), packet.size(), *serverAddress, serverPort));
+
+    connected = false;
+}
+
+void Client::sendHello() {
+    packet.clear();
+    core::ByteWriter writer(packet);
+    writer.Write(MessageType::Hello);
+    writer.Write(PROTOCOL_ID);
+
+    static_cast<void>(socket.send(packet.data(), packet.size(), *serverAddress, serverPort));
+}
+
+void Client::SendInput(const InputCommand& input) {
+    if(!connected) return;
+
+    pendingInputs.push_back(input);
+    if(pendingInputs.size() > MAX_PENDING_INPUTS)
+        pendingInputs.pop_front();
+
+    // Resend the last few commands so a single lost datagram does not drop input.
+    std::array<InputCommand, INPUT_REDUNDANCY> recent;
+    const std::size_t count = std::min(pendingInputs.size(), INPUT_REDUNDANCY);
+    std::copy(pendingInputs.end() - static_cast<std::ptrdiff_t>(count), pendingInputs.end(), recent.begin());
+
+    packet.clear();
+    core::ByteWriter writer(packet);
+    WriteInputs(writer, latestTick, recent.data(), count);
+
+    static_cast<void>(socket.send(packet.data(), packet.size(), *serverAddress, serverPort));
+}
+
+const Snapshot* Client::Poll() {
+    if(!connected) return nullptr;
+
+    std::array<std::uint8_t, MAX_PACKET_SIZE> buffer{};
+    std::size_t size = 0;
+    std::optional<sf::IpAddress> sender;
+    unsigned short senderPort = 0;
+
+    const Snapshot* newest = nullptr;
+
+    while(socket.receive(buffer.data(), buffer.size(), size, sender, senderPort) == sf::Socket::Status::Done) {
+        core::ByteReader reader(buffer.data(), size);
+        if(reader.Take<MessageType>() != MessageType::Snapshot) continue;
+
+        if(const Snapshot* snapshot = readSnapshot(reader, size))
+            newest = snapshot;
+    }
+
+    if(printStats && std::chrono::steady_clock::now() >= nextReport) {
+        std::cout << "[client] " << statSnapshots << " snapshots/s, "
+            << (statSnapshots ? statBytes / statSnapshots : 0) << " B per snapshot, "
+            << pendingInputs.size() << " inputs in flight" << std::endl;
+
+        statSnapshots = 0;
+        statBytes = 0;
+        nextReport += std::chrono::seconds(1);
+    }
+
+    return newest;
+}
+
+const Snapshot* Client::readSnapshot(core::ByteReader& reader, const std::size_t size) {
+    std::uint32_t tick = 0;
+    std::uint32_t baselineTick = 0;
+
+    if(!ReadSnapshotHeader(reader, tick, baselineTick) || tick <= latestTick)
+        return nullptr;
+
+    const Snapshot* baseline = nullptr;
+    if(baselineTick != 0) {
+        baseline = &received[baselineTick % SNAPSHOT_HISTORY];
+        if(baseline->tick != baselineTick) return nullptr;
+    }
+
+    Snapshot& snapshot = received[tick % SNAPSHOT_HISTORY];
+    if(&snapshot == baseline) return nullptr;
+
+    if(!ReadSnapshotBody(reader, baseline, snapshot)) {
+        snapshot.Clear();
+        return nullptr;
+    }
+
+    snapshot.tick = tick;
+    latestTick = tick;
+
+    while(!pendingInputs.empty() && pendingInputs.front().sequence <= snapshot.lastProcessedInput)
+        pendingInputs.pop_front();
+
+    ++statSnapshots;
+    statBytes += size;
+
+    return &snapshot;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <SFML/Network.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "NetProtocol.hpp"
+
+namespace net {
+    class Client {
+    public:
+        Client(const bool printStats = false) : printStats(printStats) {}
+        ~Client() { Disconnect(); }
+
+        bool Connect(const std::string& host, const unsigned short port, const float timeoutSeconds = 3.f);
+        void Disconnect();
+
+        bool IsConnected() const { return connected; }
+        std::uint16_t GetPlayerId() const { return playerId; }
+        std::uint32_t GetMapSeed() const { return mapSeed; }
+        float GetMapSize() const { return mapSize; }
+
+        void SendInput(const InputCommand& input);
+
+        // Drains the socket and returns the newest decoded snapshot, or nullptr if none arrived.
+        const Snapshot* Poll();
+
+        // Inputs sent but not yet processed by the server, oldest first.
+        const std::deque<InputCommand>& GetPendingInputs() const { return pendingInputs; }
+
+    private:
+        constexpr static std::size_t MAX_PENDING_INPUTS = 120;
+
+        sf::UdpSocket socket;
+        std::optional<sf::IpAddress> serverAddress;
+        unsigned short serverPort = 0;
+        bool connected = false;
+        bool printStats = false;
+
+        std::uint16_t playerId = 0;
+        std::uint32_t mapSeed = 0;
+        float mapSize = 0.f;
+
+        std::array<Snapshot, SNAPSHOT_HISTORY> received;
+        std::uint32_t latestTick = 0;
+
+        std::deque<InputCommand> pendingInputs;
+        std::vector<std::uint8_t> packet;
+
+        std::size_t statSnapshots = 0;
+        std::size_t statBytes = 0;
+        std::chrono::steady_clock::time_point nextReport;
+
+        void sendHello();
+        const Snapshot* readSnapshot(core::ByteReader& reader, const std::size_t size);
+    };
+}
@@ -3,81 +3,207 @@
 
 #include <cmath>
 #include <algorithm>
+#include <type_traits>
+#include <variant>
 
 using namespace core;
 
+namespace {
+    constexpr std::size_t SHAPE_KINDS = std::variant_size_v<core::RenderShape>;
+
+    template <std::size_t Index>
+    using ShapeKind = core::ShapeTag<std::variant_alternative_t<Index, core::RenderShape>>;
+
+    static_assert(std::is_same_v<std::variant_alternative_t<static_cast<std::size_t>(CollisionType::Circle), core::RenderShape>, sf::CircleShape>);
+    static_assert(std::is_same_v<std::variant_alternative_t<static_cast<std::size_t>(CollisionType::Rectangle), core::RenderShape>, sf::RectangleShape>);
+    static_assert(std::is_same_v<std::variant_alternative_t<static_cast<std::size_t>(CollisionType::Convex), core::RenderShape>, sf::ConvexShape>);
+    static_assert(std::is_same_v<std::variant_alternative_t<static_cast<std::size_t>(CollisionType::Polygon), core::RenderShape>, PolygonShape>);
+    static_assert(std::is_same_v<std::variant_alternative_t<static_cast<std::size_t>(CollisionType::Walls), core::RenderShape>, WallShape>);
+}
+
 void Collision::UpdateFromRenderShape() {
     if (!owner) return;
-    
+
+    core::MemoryScope scope(core::MemoryTag::Collision);
     auto render = std::dynamic_pointer_cast<Render>(owner->GetComponent("render").lock());
-    auto movement = std::dynamic_pointer_cast<Movement>(owner->GetComponent("movement").lock());
     
     if (!render) return;
     
-    sf::Vector2f position{0.f, 0.f};
+    // Same cached matrix the shape is drawn with; collision shapes only follow its translation.
+    const sf::Vector2f position = owner->GetTransform().GetWorldPosition();
+
+    bounds = sf::FloatRect(position, sf::Vector2f(radius * 2.f, radius * 2.f));
+
+    const core::RenderShape& shape = render->GetShapeVariant();
+    type = static_cast<CollisionType>(shape.index());
+
+    std::visit([this, &position](const auto& drawable) { updateFrom(drawable, position); }, shape);
+}
 
+void Collision::updateFrom(const sf::CircleShape& circle, const sf::Vector2f& position) {
+    radius = circle.getRadius();
+    center = position + sf::Vector2f{radius, radius};
     bounds = sf::FloatRect(position, sf::Vector2f(radius * 2.f, radius * 2.f));
+}
 
-    if (movement)
-        position = movement->GetPos();
+void Collision::updateFrom(const sf::RectangleShape& rect, const sf::Vector2f& position) {
+    sf::Vector2f size = rect.getSize();
+    center = position + size * 0.5f;
+    bounds = sf::FloatRect(position, size);
+}
+
+void Collision::updateFrom(const sf::ConvexShape& convex, const sf::Vector2f& position) {
+    vertices.clear();
     
-    if (auto circle = render->GetShape<sf::CircleShape>()) {
-        type = CollisionType::Circle;
-        radius = circle->getRadius();
-        center = position + sf::Vector2f{radius, radius};
-        bounds = sf::FloatRect(position, sf::Vector2f(radius * 2.f, radius * 2.f));
-    }
-    else if (auto rect = render->GetShape<sf::RectangleShape>()) {
-        type = CollisionType::Rectangle;
-        sf::Vector2f size = rect->getSize();
-        center = position + size * 0.5f;
-        bounds = sf::FloatRect(position, size);
-    }
-    else if (auto convex = render->GetShape<sf::ConvexShape>()) {
-        type = CollisionType::Convex;
-        vertices.clear();
-        
-        std::size_t pointCount = convex->getPointCount();
+    std::size_t pointCount = convex.getPointCount();
 
-        for (std::size_t i = 0; i < pointCount; ++i)
-            vertices.emplace_back(convex->getPoint(i) + position);
+    for (std::size_t i = 0; i < pointCount; ++i)
+        vertices.emplace_back(convex.getPoint(i) + position);
+    
+    if (!vertices.empty()) {
+        float minX = vertices[0].x, maxX = vertices[0].x;
+        float minY = vertices[0].y, maxY = vertices[0].y;
         
-        if (!vertices.empty()) {
-            float minX = vertices[0].x, maxX = vertices[0].x;
-            float minY = vertices[0].y, maxY = vertices[0].y;
-            
-            for (const auto& vertex : vertices) {
-                minX = std::min(minX, vertex.x);
-                maxX = std::max(maxX, vertex.x);
-                minY = std::min(minY, vertex.y);
-                maxY = std::max(maxY, vertex.y);
-            }
-            
-            bounds = sf::FloatRect(sf::Vector2f(minX, minY), sf::Vector2f(maxX - minX, maxY - minY));
-            center = sf::Vector2f{(minX + maxX) * 0.5f, (minY + maxY) * 0.5f};
+        for (const auto& vertex : vertices) {
+            minX = std::min(minX, vertex.x);
+            maxX = std::max(maxX, vertex.x);
+            minY = std::min(minY, vertex.y);
+            maxY = std::max(maxY, vertex.y);
         }
+        
+        bounds = sf::FloatRect(sf::Vector2f(minX, minY), sf::Vector2f(maxX - minX, maxY - minY));
+        center = sf::Vector2f{(minX + maxX) * 0.5f, (minY + maxY) * 0.5f};
+    }
+
+    rebuildEdges();
+}
+
+void Collision::updateFrom(const PolygonShape& polygon, const sf::Vector2f& position) {
+    if (&polygon != cachedPolygon || position != cachedPosition)
+        rebuildPolygon(polygon, position);
+
+    bounds = polygonBounds;
+}
+
+void Collision::updateFrom(const WallShape& shape, const sf::Vector2f& position) {
+    walls = &shape;
+    wallsPosition = position;
+
+    const sf::FloatRect frame = shape.GetBounds();
+    bounds = sf::FloatRect(frame.position + position, frame.size);
+    center = bounds.getCenter();
+}
+
+void Collision::rebuildPolygon(const PolygonShape& polygon, const sf::Vector2f& position) {
+    cachedPolygon = &polygon;
+    cachedPosition = position;
+
+    const auto& rings = polygon.GetRings();
+
+    vertices.clear();
+    for (const auto& vertex : rings.front())
+        vertices.emplace_back(vertex + position);
+
+    edgeStartX.clear();
+    edgeStartY.clear();
+    edgeEndX.clear();
+    edgeEndY.clear();
+    edgeInvLengthSq.clear();
+
+    for (const auto& ring : rings)
+        appendRingEdges(ring, position);
+
+    pieces.clear();
+    pieceBounds.clear();
+
+    for (const auto& source : polygon.GetConvexPieces()) {
+        auto& piece = pieces.emplace_back();
+        sf::Vector2f min = source.front() + position;
+        sf::Vector2f max = min;
+
+        for (const auto& vertex : source) {
+            piece.emplace_back(vertex + position);
+            min = {std::min(min.x, piece.back().x), std::min(min.y, piece.back().y)};
+            max = {std::max(max.x, piece.back().x), std::max(max.y, piece.back().y)};
+        }
+
+        pieceBounds.emplace_back(min, max - min);
+    }
+
+    sf::Vector2f min = vertices.empty() ? position : vertices.front();
+    sf::Vector2f max = min;
+
+    for (const auto& vertex : vertices) {
+        min = {std::min(min.x, vertex.x), std::min(min.y, vertex.y)};
+        max = {std::max(max.x, vertex.x), std::max(max.y, vertex.y)};
+    }
+
+    polygonBounds = sf::FloatRect(min, max - min);
+    center = (min + max) * 0.5f;
+}
+
+void Collision::rebuildEdges() {
+    edgeStartX.clear();
+    edgeStartY.clear();
+    edgeEndX.clear();
+    edgeEndY.clear();
+    edgeInvLengthSq.clear();
+
+    appendRingEdges(vertices, sf::Vector2f{0.f, 0.f});
+}
+
+void Collision::appendRingEdges(const std::vector<sf::Vector2f>& ring, const sf::Vector2f& offset) {
+    const std::size_t count = ring.size();
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const sf::Vector2f start = ring[i] + offset;
+        const sf::Vector2f end = ring[(i + 1) % count] + offset;
+        sf::Vector2f line = end - start;
+        float lengthSq = line.x * line.x + line.y * line.y;
+
+        edgeStartX.push_back(start.x);
+        edgeStartY.push_back(start.y);
+        edgeEndX.push_back(end.x);
+        edgeEndY.push_back(end.y);
+        edgeInvLengthSq.push_back(lengthSq < 0.001f ? 0.f : 1.f / lengthSq);
     }
 }
 
+template <std::size_t Lhs, std::size_t Rhs>
+CollisionInfo Collision::narrowphase(const Collision& lhs, const Collision& rhs) {
+    return lhs.collide(ShapeKind<Lhs>{}, ShapeKind<Rhs>{}, rhs);
+}
+
+template <std::size_t... Pairs>
+constexpr std::array<Collision::Narrowphase, sizeof...(Pairs)> Collision::makeDispatchTable(std::index_sequence<Pairs...>) {
+    return {&narrowphase<Pairs / SHAPE_KINDS, Pairs % SHAPE_KINDS>...};
+}
+
 CollisionInfo Collision::CheckCollision(const Collision& other) const {
+    static constexpr auto dispatch = makeDispatchTable(std::make_index_sequence<SHAPE_KINDS * SHAPE_KINDS>{});
+
     if (!sf::FloatRect(bounds).findIntersection(other.bounds))
         return CollisionInfo{};
-    
-    if (type == CollisionType::Circle && other.type == CollisionType::Circle)
-        return checkCircleCircle(other);
 
-    else if (type == CollisionType::Circle && other.type == CollisionType::Rectangle) {
-        return checkCircleRect(other);
-    }
-    else if (type == CollisionType::Rectangle && other.type == CollisionType::Circle) {
-        CollisionInfo info = other.checkCircleRect(*this);
-        info.penetrationVector = -info.penetrationVector;
-        return info;
-    }
-    else if (type == CollisionType::Rectangle && other.type == CollisionType::Rectangle)
-        return checkRectRect(other);
-    else
-        return checkConvexCollision(other);
+    return dispatch[static_cast<std::size_t>(type) * SHAPE_KINDS + static_cast<std::size_t>(other.type)](*this, other);
+}
+
+CollisionInfo Collision::collide(core::ShapeTag<sf::CircleShape>, core::ShapeTag<sf::CircleShape>, const Collision& other) const {
+    return checkCircleCircle(other);
+}
+
+CollisionInfo Collision::collide(core::ShapeTag<sf::CircleShape>, core::ShapeTag<sf::RectangleShape>, const Collision& other) const {
+    return checkCircleRect(other);
+}
+
+CollisionInfo Collision::collide(core::ShapeTag<sf::RectangleShape>, core::ShapeTag<sf::CircleShape>, const Collision& other) const {
+    CollisionInfo info = other.checkCircleRect(*this);
+    info.penetrationVector = -info.penetrationVector;
+    return info;
+}
+
+CollisionInfo Collision::collide(core::ShapeTag<sf::RectangleShape>, core::ShapeTag<sf::RectangleShape>, const Collision& other) const {
+    return checkRectRect(other);
 }
 
 CollisionInfo Collision::checkCircleCircle(const Collision& other) const {
@@ -153,6 +279,10 @@ bool Collision::ContainsPoint(const sf::Vector2f& point) const {
             return pointInRect(point);
         case CollisionType::Convex:
             return pointInConvex(point);
+        case CollisionType::Polygon:
+            return pointInPolygon(point);
+        case CollisionType::Walls:
+            return walls && !walls->IsSolid(point - wallsPosition);
     }
     return false;
 }
@@ -183,7 +313,32 @@ bool Collision::pointInConvex(const sf::Vector2f& point) const {
     return intersectionCount % 2 == 1;
 }
 
+bool Collision::pointInPolygon(const sf::Vector2f& point) const {
+    for (std::size_t p = 0; p < pieces.size(); ++p) {
+        if (!pieceBounds[p].contains(point)) continue;
+
+        const auto& piece = pieces[p];
+        bool inside = true;
+
+        for (std::size_t i = 0, j = piece.size() - 1; inside && i < piece.size(); j = i++) {
+            const sf::Vector2f edge = piece[i] - piece[j];
+            const sf::Vector2f toPoint = point - piece[j];
+            inside = edge.x * toPoint.y - edge.y * toPoint.x >= 0.f;
+        }
+
+        if (inside) return true;
+    }
+
+    return false;
+}
+
 sf::Vector2f Collision::GetClosestPointOnBoundary(const sf::Vector2f& point) const {
+    if (type == CollisionType::Polygon || type == CollisionType::Walls) {
+        sf::Vector2f closestPoint = center;
+        GetClosestPointsOnBoundary(&point.x, &point.y, 1, &closestPoint.x, &closestPoint.y);
+        return closestPoint;
+    }
+
     if (type != CollisionType::Convex || vertices.empty()) {
         return center; // fallback
     }
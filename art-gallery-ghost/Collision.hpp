@@ -4,13 +4,24 @@
 #include "Component.hpp"
 #include "Movement.hpp"
 #include "Render.hpp"
+#include "PolygonShape.hpp"
+#include "WallShape.hpp"
+#include "MemoryStats.hpp"
 #include <memory>
 #include <limits>
+#include <vector>
+#include <cstdint>
+#include <array>
+#include <type_traits>
+#include <utility>
 
+// Matches the alternative order of core::RenderShape.
 enum class CollisionType {
     Circle,
     Rectangle,
-    Convex
+    Convex,
+    Polygon,
+    Walls
 };
 
 struct CollisionInfo {
@@ -46,6 +57,12 @@ public:
     sf::Vector2f GetClosestPointOnBoundary(const sf::Vector2f& point) const;
     sf::Vector2f GetClosestPointOnLineSegment(const sf::Vector2f& point, const sf::Vector2f& lineStart, const sf::Vector2f& lineEnd) const;
 
+    // Batch variants over SoA query points. inside[i] is 1 when (xs[i], ys[i]) is contained.
+    void ContainsPoints(const float* xs, const float* ys, std::size_t count, std::uint8_t* inside) const;
+    void GetClosestPointsOnBoundary(const float* xs, const float* ys, std::size_t count, float* outXs, float* outYs) const;
+    // blocked[i] is 1 when the segment from `from` to (xs[i], ys[i]) crosses an edge. Only Convex, Polygon and Walls shapes occlude.
+    void SegmentsBlocked(const sf::Vector2f& from, const float* xs, const float* ys, std::size_t count, std::uint8_t* blocked) const;
+
 private:
     constexpr static std::string_view tag = "collision";
 
@@ -55,7 +72,64 @@ private:
     float radius = 0.f;
     std::vector<sf::Vector2f> vertices;
 
+    // Convex pieces of a Polygon shape, in world space, for point queries.
+    std::vector<std::vector<sf::Vector2f>> pieces;
+    std::vector<sf::FloatRect> pieceBounds;
+
+    // Polygon geometry is rebuilt only when the shape or its position changes.
+    const PolygonShape* cachedPolygon = nullptr;
+    sf::Vector2f cachedPosition;
+    sf::FloatRect polygonBounds;
+
+    // Edge i runs from vertices[i] to vertices[i + 1], kept in SoA for the batch kernels.
+    // Polygon shapes store the edges of every ring, holes included.
+    using EdgeArray = std::vector<float, core::TaggedAllocator<float, core::MemoryTag::Collision>>;
+
+    EdgeArray edgeStartX;
+    EdgeArray edgeStartY;
+    EdgeArray edgeEndX;
+    EdgeArray edgeEndY;
+    EdgeArray edgeInvLengthSq;
+
+    // A WallShape collides as the floor it encloses. Carving changes it in place, so queries go
+    // straight to the shape instead of through a copy.
+    const WallShape* walls = nullptr;
+    sf::Vector2f wallsPosition;
+
     void UpdateFromRenderShape();
+    void updateFrom(const sf::CircleShape& circle, const sf::Vector2f& position);
+    void updateFrom(const sf::RectangleShape& rect, const sf::Vector2f& position);
+    void updateFrom(const sf::ConvexShape& convex, const sf::Vector2f& position);
+    void updateFrom(const PolygonShape& polygon, const sf::Vector2f& position);
+    void updateFrom(const WallShape& shape, const sf::Vector2f& position);
+    void rebuildEdges();
+    void appendRingEdges(const std::vector<sf::Vector2f>& ring, const sf::Vector2f& offset);
+    void rebuildPolygon(const PolygonShape& polygon, const sf::Vector2f& position);
+
+    using Narrowphase = CollisionInfo (*)(const Collision&, const Collision&);
+
+    // One entry per (lhs, rhs) pair of shape kinds, generated at compile time from the
+    // collide() overloads below; a pair without an overload does not compile.
+    template <std::size_t Lhs, std::size_t Rhs>
+    static CollisionInfo narrowphase(const Collision& lhs, const Collision& rhs);
+
+    template <std::size_t... Pairs>
+    static constexpr std::array<Narrowphase, sizeof...(Pairs)> makeDispatchTable(std::index_sequence<Pairs...>);
+
+    CollisionInfo collide(core::ShapeTag<sf::CircleShape>, core::ShapeTag<sf::CircleShape>, const Collision& other) const;
+    CollisionInfo collide(core::ShapeTag<sf::CircleShape>, core::ShapeTag<sf::RectangleShape>, const Collision& other) const;
+    CollisionInfo collide(core::ShapeTag<sf::RectangleShape>, core::ShapeTag<sf::CircleShape>, const Collision& other) const;
+    CollisionInfo collide(core::ShapeTag<sf::RectangleShape>, core::ShapeTag<sf::RectangleShape>, const Collision& other) const;
+
+    template <typename T>
+    constexpr static bool isEdgeShape = std::is_same_v<T, sf::ConvexShape> || std::is_same_v<T, PolygonShape> || std::is_same_v<T, WallShape>;
+
+    // Convex, polygon and wall shapes only collide by bounds for now.
+    template <typename Lhs, typename Rhs>
+    auto collide(core::ShapeTag<Lhs>, core::ShapeTag<Rhs>, const Collision& other) const
+        -> std::enable_if_t<isEdgeShape<Lhs> || isEdgeShape<Rhs>, CollisionInfo> {
+        return checkConvexCollision(other);
+    }
 
     CollisionInfo checkCircleCircle(const Collision& other) const;
     CollisionInfo checkCircleRect(const Collision& other) const;
@@ -65,4 +139,5 @@ private:
     bool pointInCircle(const sf::Vector2f& point) const;
     bool pointInRect(const sf::Vector2f& point) const;
     bool pointInConvex(const sf::Vector2f& point) const;
+    bool pointInPolygon(const sf::Vector2f& point) const;
 };
\ No newline at end of file
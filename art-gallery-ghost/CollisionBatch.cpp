@@ -0,0 +1,388 @@
+#include "Collision.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define COLLISION_BATCH_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define COLLISION_BATCH_SSE2
+#endif
+
+namespace {
+    struct EdgeView {
+        const float* startX;
+        const float* startY;
+        const float* endX;
+        const float* endY;
+        const float* invLengthSq;
+        std::size_t count;
+    };
+
+    std::uint8_t crossingParity(const EdgeView& edges, const float px, const float py) {
+        std::uint8_t parity = 0;
+
+        for (std::size_t e = 0; e < edges.count; ++e) {
+            const float y0 = edges.startY[e];
+            const float y1 = edges.endY[e];
+
+            if (((y0 > py) != (y1 > py)) &&
+                (px < (edges.endX[e] - edges.startX[e]) * (py - y0) / (y1 - y0) + edges.startX[e]))
+                parity ^= 1;
+        }
+
+        return parity;
+    }
+
+    void closestOnEdges(const EdgeView& edges, const float px, const float py, float& outX, float& outY) {
+        float best = std::numeric_limits<float>::max();
+        outX = edges.startX[0];
+        outY = edges.startY[0];
+
+        for (std::size_t e = 0; e < edges.count; ++e) {
+            const float dx = edges.endX[e] - edges.startX[e];
+            const float dy = edges.endY[e] - edges.startY[e];
+            const float t = std::max(0.f, std::min(1.f,
+                ((px - edges.startX[e]) * dx + (py - edges.startY[e]) * dy) * edges.invLengthSq[e]));
+
+            const float qx = edges.startX[e] + dx * t;
+            const float qy = edges.startY[e] + dy * t;
+            const float distSq = (px - qx) * (px - qx) + (py - qy) * (py - qy);
+
+            if (distSq < best) {
+                best = distSq;
+                outX = qx;
+                outY = qy;
+            }
+        }
+    }
+
+    // Proper crossings only: a sight line that just grazes a vertex is not blocked.
+    std::uint8_t segmentBlocked(const EdgeView& edges, const float ox, const float oy, const float qx, const float qy) {
+        const float dx = qx - ox;
+        const float dy = qy - oy;
+
+        for (std::size_t e = 0; e < edges.count; ++e) {
+            const float ax = edges.startX[e] - ox;
+            const float ay = edges.startY[e] - oy;
+            const float bx = edges.endX[e] - ox;
+            const float by = edges.endY[e] - oy;
+            const float ex = bx - ax;
+            const float ey = by - ay;
+
+            const float sideA = dx * ay - dy * ax;
+            const float sideB = dx * by - dy * bx;
+            const float sideO = ey * ax - ex * ay;
+            const float sideQ = ex * (dy - ay) - ey * (dx - ax);
+
+            if (sideA * sideB < 0.f && sideO * sideQ < 0.f)
+                return 1;
+        }
+
+        return 0;
+    }
+
+#if defined(COLLISION_BATCH_AVX2)
+    constexpr std::size_t LANES = 8;
+
+    void containsLanes(const EdgeView& edges, const float* xs, const float* ys, std::uint8_t* inside) {
+        const __m256 px = _mm256_loadu_ps(xs);
+        const __m256 py = _mm256_loadu_ps(ys);
+        __m256 parity = _mm256_setzero_ps();
+
+        for (std::size_t e = 0; e < edges.count; ++e) {
+            const __m256 x0 = _mm256_set1_ps(edges.startX[e]);
+            const __m256 y0 = _mm256_set1_ps(edges.startY[e]);
+            const __m256 x1 = _mm256_set1_ps(edges.endX[e]);
+            const __m256 y1 = _mm256_set1_ps(edges.endY[e]);
+
+            const __m256 straddles = _mm256_xor_ps(
+                _mm256_cmp_ps(y0, py, _CMP_GT_OQ),
+                _mm256_cmp_ps(y1, py, _CMP_GT_OQ));
+
+            const __m256 crossX = _mm256_add_ps(
+                _mm256_div_ps(
+                    _mm256_mul_ps(_mm256_sub_ps(x1, x0), _mm256_sub_ps(py, y0)),
+                    _mm256_sub_ps(y1, y0)),
+                x0);
+
+            parity = _mm256_xor_ps(parity,
+                _mm256_and_ps(straddles, _mm256_cmp_ps(px, crossX, _CMP_LT_OQ)));
+        }
+
+        const int mask = _mm256_movemask_ps(parity);
+        for (std::size_t lane = 0; lane < LANES; ++lane)
+            inside[lane] = static_cast<std::uint8_t>((mask >> lane) & 1);
+    }
+
+    void closestLanes(const EdgeView& edges, const float* xs, const float* ys, float* outXs, float* outYs) {
+        const __m256 px = _mm256_loadu_ps(xs);
+        const __m256 py = _mm256_loadu_ps(ys);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.f);
+
+        __m256 best = _mm256_set1_ps(std::numeric_limits<float>::max());
+        __m256 bestX = _mm256_set1_ps(edges.startX[0]);
+        __m256 bestY = _mm256_set1_ps(edges.startY[0]);
+
+        for (std::size_t e = 0; e < edges.count; ++e) {
+            const __m256 x0 = _mm256_set1_ps(edges.startX[e]);
+            const __m256 y0 = _mm256_set1_ps(edges.startY[e]);
+            const __m256 dx = _mm256_set1_ps(edges.endX[e] - edges.startX[e]);
+            const __m256 dy = _mm256_set1_ps(edges.endY[e] - edges.startY[e]);
+
+            __m256 t = _mm256_mul_ps(
+                _mm256_add_ps(
+                    _mm256_mul_ps(_mm256_sub_ps(px, x0), dx),
+                    _mm256_mul_ps(_mm256_sub_ps(py, y0), dy)),
+                _mm256_set1_ps(edges.invLengthSq[e]));
+            t = _mm256_max_ps(zero, _mm256_min_ps(one, t));
+
+            const __m256 qx = _mm256_add_ps(x0, _mm256_mul_ps(dx, t));
+            const __m256 qy = _mm256_add_ps(y0, _mm256_mul_ps(dy, t));
+            const __m256 ox = _mm256_sub_ps(px, qx);
+            const __m256 oy = _mm256_sub_ps(py, qy);
+            const __m256 distSq = _mm256_add_ps(_mm256_mul_ps(ox, ox), _mm256_mul_ps(oy, oy));
+
+            const __m256 closer = _mm256_cmp_ps(distSq, best, _CMP_LT_OQ);
+            best = _mm256_blendv_ps(best, distSq, closer);
+            bestX = _mm256_blendv_ps(bestX, qx, closer);
+            bestY = _mm256_blendv_ps(bestY, qy, closer);
+        }
+
+        _mm256_storeu_ps(outXs, bestX);
+        _mm256_storeu_ps(outYs, bestY);
+    }
+
+    void blockedLanes(const EdgeView& edges, const float ox, const float oy, const float* xs, const float* ys, std::uint8_t* blocked) {
+        const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(xs), _mm256_set1_ps(ox));
+        const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(ys), _mm256_set1_ps(oy));
+        const __m256 zero = _mm256_setzero_ps();
+        __m256 hit = _mm256_setzero_ps();
+
+        for (std::size_t e = 0; e < edges.count; ++e) {
+            const float ax = edges.startX[e] - ox;
+            const float ay = edges.startY[e] - oy;
+            const float ex = edges.endX[e] - edges.startX[e];
+            const float ey = edges.endY[e] - edges.startY[e];
+
+            const __m256 sideA = _mm256_sub_ps(
+                _mm256_mul_ps(dx, _mm256_set1_ps(ay)), _mm256_mul_ps(dy, _mm256_set1_ps(ax)));
+            const __m256 sideB = _mm256_sub_ps(
+                _mm256_mul_ps(dx, _mm256_set1_ps(ay + ey)), _mm256_mul_ps(dy, _mm256_set1_ps(ax + ex)));
+            const __m256 sideQ = _mm256_sub_ps(
+                _mm256_mul_ps(_mm256_set1_ps(ex), _mm256_sub_ps(dy, _mm256_set1_ps(ay))),
+                _mm256_mul_ps(_mm256_set1_ps(ey), _mm256_sub_ps(dx, _mm256_set1_ps(ax))));
+            const __m256 sideO = _mm256_set1_ps(ey * ax - ex * ay);
+
+            hit = _mm256_or_ps(hit, _mm256_and_ps(
+                _mm256_cmp_ps(_mm256_mul_ps(sideA, sideB), zero, _CMP_LT_OQ),
+                _mm256_cmp_ps(_mm256_mul_ps(sideO, sideQ), zero, _CMP_LT_OQ)));
+
+            if (_mm256_movemask_ps(hit) == 0xff) break;
+        }
+
+        const int mask = _mm256_movemask_ps(hit);
+        for (std::size_t lane = 0; lane < LANES; ++lane)
+            blocked[lane] = static_cast<std::uint8_t>((mask >> lane) & 1);
+    }
+#elif defined(COLLISION_BATCH_SSE2)
+    constexpr std::size_t LANES = 4;
+
+    inline __m128 select(const __m128 mask, const __m128 whenTrue, const __m128 whenFalse) {
+        return _mm_or_ps(_mm_and_ps(mask, whenTrue), _mm_andnot_ps(mask, whenFalse));
+    }
+
+    void containsLanes(const EdgeView& edges, const float* xs, const float* ys, std::uint8_t* inside) {
+        const __m128 px = _mm_loadu_ps(xs);
+        const __m128 py = _mm_loadu_ps(ys);
+        __m128 parity = _mm_setzero_ps();
+
+        for (std::size_t e = 0; e < edges.count; ++e) {
+            const __m128 x0 = _mm_set1_ps(edges.startX[e]);
+            const __m128 y0 = _mm_set1_ps(edges.startY[e]);
+            const __m128 x1 = _mm_set1_ps(edges.endX[e]);
+            const __m128 y1 = _mm_set1_ps(edges.endY[e]);
+
+            const __m128 straddles = _mm_xor_ps(_mm_cmpgt_ps(y0, py), _mm_cmpgt_ps(y1, py));
+
+            const __m128 crossX = _mm_add_ps(
+                _mm_div_ps(
+                    _mm_mul_ps(_mm_sub_ps(x1, x0), _mm_sub_ps(py, y0)),
+                    _mm_sub_ps(y1, y0)),
+                x0);
+
+            parity = _mm_xor_ps(parity, _mm_and_ps(straddles, _mm_cmplt_ps(px, crossX)));
+        }
+
+        const int mask = _mm_movemask_ps(parity);
+        for (std::size_t lane = 0; lane < LANES; ++lane)
+            inside[lane] = static_cast<std::uint8_t>((mask >> lane) & 1);
+    }
+
+    void closestLanes(const EdgeView& edges, const float* xs, const float* ys, float* outXs, float* outYs) {
+        const __m128 px = _mm_loadu_ps(xs);
+        const __m128 py = _mm_loadu_ps(ys);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.f);
+
+        __m128 best = _mm_set1_ps(std::numeric_limits<float>::max());
+        __m128 bestX = _mm_set1_ps(edges.startX[0]);
+        __m128 bestY = _mm_set1_ps(edges.startY[0]);
+
+        for (std::size_t e = 0; e < edges.count; ++e) {
+            const __m128 x0 = _mm_set1_ps(edges.startX[e]);
+            const __m128 y0 = _mm_set1_ps(edges.startY[e]);
+            const __m128 dx = _mm_set1_ps(edges.endX[e] - edges.startX[e]);
+            const __m128 dy = _mm_set1_ps(edges.endY[e] - edges.startY[e]);
+
+            __m128 t = _mm_mul_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_sub_ps(px, x0), dx), _mm_mul_ps(_mm_sub_ps(py, y0), dy)),
+                _mm_set1_ps(edges.invLengthSq[e]));
+            t = _mm_max_ps(zero, _mm_min_ps(one, t));
+
+            const __m128 qx = _mm_add_ps(x0, _mm_mul_ps(dx, t));
+            const __m128 qy = _mm_add_ps(y0, _mm_mul_ps(dy, t));
+            const __m128 ox = _mm_sub_ps(px, qx);
+            const __m128 oy = _mm_sub_ps(py, qy);
+            const __m128 distSq = _mm_add_ps(_mm_mul_ps(ox, ox), _mm_mul_ps(oy, oy));
+
+            const __m128 closer = _mm_cmplt_ps(distSq, best);
+            best = select(closer, distSq, best);
+            bestX = select(closer, qx, bestX);
+            bestY = select(closer, qy, bestY);
+        }
+
+        _mm_storeu_ps(outXs, bestX);
+        _mm_storeu_ps(outYs, bestY);
+    }
+
+    void blockedLanes(const EdgeView& edges, const float ox, const float oy, const float* xs, const float* ys, std::uint8_t* blocked) {
+        const __m128 dx = _mm_sub_ps(_mm_loadu_ps(xs), _mm_set1_ps(ox));
+        const __m128 dy = _mm_sub_ps(_mm_loadu_ps(ys), _mm_set1_ps(oy));
+        const __m128 zero = _mm_setzero_ps();
+        __m128 hit = _mm_setzero_ps();
+
+        for (std::size_t e = 0; e < edges.count; ++e) {
+            const float ax = edges.startX[e] - ox;
+            const float ay = edges.startY[e] - oy;
+            const float ex = edges.endX[e] - edges.startX[e];
+            const float ey = edges.endY[e] - edges.startY[e];
+
+            const __m128 sideA = _mm_sub_ps(_mm_mul_ps(dx, _mm_set1_ps(ay)), _mm_mul_ps(dy, _mm_set1_ps(ax)));
+            const __m128 sideB = _mm_sub_ps(_mm_mul_ps(dx, _mm_set1_ps(ay + ey)), _mm_mul_ps(dy, _mm_set1_ps(ax + ex)));
+            const __m128 sideQ = _mm_sub_ps(
+                _mm_mul_ps(_mm_set1_ps(ex), _mm_sub_ps(dy, _mm_set1_ps(ay))),
+                _mm_mul_ps(_mm_set1_ps(ey), _mm_sub_ps(dx, _mm_set1_ps(ax))));
+            const __m128 sideO = _mm_set1_ps(ey * ax - ex * ay);
+
+            hit = _mm_or_ps(hit, _mm_and_ps(
+                _mm_cmplt_ps(_mm_mul_ps(sideA, sideB), zero),
+                _mm_cmplt_ps(_mm_mul_ps(sideO, sideQ), zero)));
+
+            if (_mm_movemask_ps(hit) == 0xf) break;
+        }
+
+        const int mask = _mm_movemask_ps(hit);
+        for (std::size_t lane = 0; lane < LANES; ++lane)
+            blocked[lane] = static_cast<std::uint8_t>((mask >> lane) & 1);
+    }
+#else
+    constexpr std::size_t LANES = 1;
+
+    void containsLanes(const EdgeView& edges, const float* xs, const float* ys, std::uint8_t* inside) {
+        inside[0] = crossingParity(edges, xs[0], ys[0]);
+    }
+
+    void closestLanes(const EdgeView& edges, const float* xs, const float* ys, float* outXs, float* outYs) {
+        closestOnEdges(edges, xs[0], ys[0], outXs[0], outYs[0]);
+    }
+
+    void blockedLanes(const EdgeView& edges, const float ox, const float oy, const float* xs, const float* ys, std::uint8_t* blocked) {
+        blocked[0] = segmentBlocked(edges, ox, oy, xs[0], ys[0]);
+    }
+#endif
+}
+
+void Collision::ContainsPoints(const float* xs, const float* ys, std::size_t count, std::uint8_t* inside) const {
+    if (type != CollisionType::Convex && type != CollisionType::Polygon) {
+        for (std::size_t i = 0; i < count; ++i)
+            inside[i] = ContainsPoint({xs[i], ys[i]}) ? 1 : 0;
+        return;
+    }
+
+    if (edgeStartX.size() < 3) {
+        std::fill(inside, inside + count, std::uint8_t{0});
+        return;
+    }
+
+    const EdgeView edges{
+        edgeStartX.data(), edgeStartY.data(), edgeEndX.data(), edgeEndY.data(),
+        edgeInvLengthSq.data(), edgeStartX.size()};
+
+    std::size_t i = 0;
+    for (; i + LANES <= count; i += LANES)
+        containsLanes(edges, xs + i, ys + i, inside + i);
+
+    for (; i < count; ++i)
+        inside[i] = crossingParity(edges, xs[i], ys[i]);
+}
+
+void Collision::GetClosestPointsOnBoundary(const float* xs, const float* ys, std::size_t count, float* outXs, float* outYs) const {
+    // Wall edges live per tile and every point walks a different set of tiles, so the Walls type
+    // stays on WallShape's scalar grid search instead of the lane kernels below.
+    if (type == CollisionType::Walls && walls) {
+        for (std::size_t i = 0; i < count; ++i) {
+            sf::Vector2f closest = center - wallsPosition;
+            walls->GetClosestSurfacePoint(sf::Vector2f{xs[i], ys[i]} - wallsPosition, closest);
+            outXs[i] = closest.x + wallsPosition.x;
+            outYs[i] = closest.y + wallsPosition.y;
+        }
+        return;
+    }
+
+    if ((type != CollisionType::Convex && type != CollisionType::Polygon) || edgeStartX.empty()) {
+        std::fill(outXs, outXs + count, center.x);
+        std::fill(outYs, outYs + count, center.y);
+        return;
+    }
+
+    const EdgeView edges{
+        edgeStartX.data(), edgeStartY.data(), edgeEndX.data(), edgeEndY.data(),
+        edgeInvLengthSq.data(), edgeStartX.size()};
+
+    std::size_t i = 0;
+    for (; i + LANES <= count; i += LANES)
+        closestLanes(edges, xs + i, ys + i, outXs + i, outYs + i);
+
+    for (; i < count; ++i)
+        closestOnEdges(edges, xs[i], ys[i], outXs[i], outYs[i]);
+}
+
+void Collision::SegmentsBlocked(const sf::Vector2f& from, const float* xs, const float* ys, std::size_t count, std::uint8_t* blocked) const {
+    // Scalar per segment for the same reason: each one walks its own tiles of the wall grid.
+    if (type == CollisionType::Walls && walls) {
+        const sf::Vector2f local = from - wallsPosition;
+        for (std::size_t i = 0; i < count; ++i)
+            blocked[i] = walls->SegmentBlocked(local, sf::Vector2f{xs[i], ys[i]} - wallsPosition) ? 1 : 0;
+        return;
+    }
+
+    if ((type != CollisionType::Convex && type != CollisionType::Polygon) || edgeStartX.empty()) {
+        std::fill(blocked, blocked + count, std::uint8_t{0});
+        return;
+    }
+
+    const EdgeView edges{
+        edgeStartX.data(), edgeStartY.data(), edgeEndX.data(), edgeEndY.data(),
+        edgeInvLengthSq.data(), edgeStartX.size()};
+
+    std::size_t i = 0;
+    for (; i + LANES <= count; i += LANES)
+        blockedLanes(edges, from.x, from.y, xs + i, ys + i, blocked + i);
+
+    for (; i < count; ++i)
+        blocked[i] = segmentBlocked(edges, from.x, from.y, xs[i], ys[i]);
+}
@@ -2,6 +2,7 @@
 #include "Movement.hpp"
 #include "Object.hpp"
 #include "Player.hpp"
+#include "PlayerInput.hpp"
 
 #include <iostream>
 
@@ -11,17 +12,24 @@ void Controller::HandleEvents() {
     if(auto movement = std::dynamic_pointer_cast<Movement>(
         owner->GetComponent("movement").lock())) {
 
-        sf::Vector2f velocity{0.f, 0.f};
+        InputCommand input;
+        input.buttons = SampleButtons();
 
-        if(sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::W))
-            velocity.y -= Player::MOVE_SPEED;
-        if(sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::S))
-            velocity.y += Player::MOVE_SPEED;
-        if(sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::A))
-            velocity.x -= Player::MOVE_SPEED;
-        if(sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::D))
-            velocity.x += Player::MOVE_SPEED;
-
-        movement->SetVel(velocity);
+        movement->SetVel(input.GetVelocity());
     }
 }
+
+std::uint8_t Controller::SampleButtons() {
+    std::uint8_t buttons = 0;
+
+    if(sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::W))
+        buttons |= InputCommand::Up;
+    if(sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::S))
+        buttons |= InputCommand::Down;
+    if(sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::A))
+        buttons |= InputCommand::Left;
+    if(sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::D))
+        buttons |= InputCommand::Right;
+
+    return buttons;
+}
@@ -2,6 +2,7 @@
 
 #include <SFML/Graphics.hpp>
 #include <string_view>
+#include <cstdint>
 
 #include "Component.hpp"
 
@@ -18,6 +19,8 @@ public:
     void HandleEvents();
     std::string_view GetTag() const { return tag; }
 
+    static std::uint8_t SampleButtons();
+
 private:
     std::string_view tag = "controller";
 };
\ No newline at end of file
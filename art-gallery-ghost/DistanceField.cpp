@@ -0,0 +1,179 @@
+#include "DistanceField.hpp"
+#include "Collision.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace core;
+
+namespace {
+    // Fixed-point steps per unit; MAX_DISTANCE * SCALE must fit in an int16_t.
+    constexpr float SCALE = 64.f;
+    constexpr int PUSH_STEPS = 2;
+
+    static_assert(DistanceField::MAX_DISTANCE * SCALE <= 32767.f);
+
+    std::int16_t toFixed(const float distance) {
+        const float clamped = std::clamp(distance, -DistanceField::MAX_DISTANCE, DistanceField::MAX_DISTANCE);
+        return static_cast<std::int16_t>(std::lround(clamped * SCALE));
+    }
+
+    // Marks every cell within `reach` of a marked cell along one axis, via a running window count.
+    void dilate(std::vector<std::uint8_t>& cells, const int lines, const int length, const int lineStride,
+                const int step, const int reach, std::vector<int>& prefix) {
+        prefix.resize(static_cast<std::size_t>(length) + 1);
+
+        for (int line = 0; line < lines; ++line) {
+            std::uint8_t* cell = &cells[static_cast<std::size_t>(line) * lineStride];
+
+            prefix[0] = 0;
+            for (int i = 0; i < length; ++i)
+                prefix[i + 1] = prefix[i] + cell[static_cast<std::size_t>(i) * step];
+
+            for (int i = 0; i < length; ++i)
+                cell[static_cast<std::size_t>(i) * step] = prefix[std::min(length, i + reach + 1)] > prefix[std::max(0, i - reach)];
+        }
+    }
+}
+
+void DistanceField::Bake(const Collision& walls, const float cellSize) {
+    const sf::FloatRect bounds = walls.GetBounds();
+
+    // A margin of MAX_DISTANCE around the bounds, so points just outside them still see the walls.
+    const int reach = static_cast<int>(std::ceil(MAX_DISTANCE / cellSize)) + 1;
+    this->cellSize = cellSize;
+    origin = bounds.position - sf::Vector2f{cellSize, cellSize} * static_cast<float>(reach);
+    columns = static_cast<int>(std::ceil(bounds.size.x / cellSize)) + 2 * reach + 1;
+    rows = static_cast<int>(std::ceil(bounds.size.y / cellSize)) + 2 * reach + 1;
+
+    const std::size_t count = static_cast<std::size_t>(columns) * rows;
+    std::vector<std::uint8_t> floor(count);
+
+    xs.resize(static_cast<std::size_t>(columns));
+    ys.resize(static_cast<std::size_t>(columns));
+    for (int c = 0; c < columns; ++c)
+        xs[c] = origin.x + static_cast<float>(c) * cellSize;
+
+    for (int r = 0; r < rows; ++r) {
+        std::fill(ys.begin(), ys.end(), origin.y + static_cast<float>(r) * cellSize);
+        walls.ContainsPoints(xs.data(), ys.data(), xs.size(), &floor[static_cast<std::size_t>(r) * columns]);
+    }
+
+    values.resize(count);
+    for (std::size_t node = 0; node < count; ++node)
+        values[node] = toFixed(floor[node] ? MAX_DISTANCE : -MAX_DISTANCE);
+
+    // Only nodes within the band of a sign change can be closer than MAX_DISTANCE to a wall.
+    std::vector<std::uint8_t> near(count, 0);
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < columns; ++c) {
+            const std::size_t node = static_cast<std::size_t>(r) * columns + c;
+
+            if (c + 1 < columns && floor[node] != floor[node + 1])
+                near[node] = near[node + 1] = 1;
+            if (r + 1 < rows && floor[node] != floor[node + columns])
+                near[node] = near[node + columns] = 1;
+        }
+    }
+
+    std::vector<int> prefix;
+    dilate(near, rows, columns, columns, 1, reach, prefix);
+    dilate(near, columns, rows, 1, columns, reach, prefix);
+
+    nodes.clear();
+    for (std::size_t node = 0; node < count; ++node)
+        if (near[node]) nodes.push_back(static_cast<std::uint32_t>(node));
+
+    resolve(walls);
+}
+
+void DistanceField::Rebake(const Collision& walls, const sf::FloatRect& area) {
+    if (values.empty()) return;
+
+    const int firstColumn = std::max(0, static_cast<int>(std::floor((area.position.x - MAX_DISTANCE - origin.x) / cellSize)));
+    const int lastColumn = std::min(columns - 1, static_cast<int>(std::ceil((area.position.x + area.size.x + MAX_DISTANCE - origin.x) / cellSize)));
+    const int firstRow = std::max(0, static_cast<int>(std::floor((area.position.y - MAX_DISTANCE - origin.y) / cellSize)));
+    const int lastRow = std::min(rows - 1, static_cast<int>(std::ceil((area.position.y + area.size.y + MAX_DISTANCE - origin.y) / cellSize)));
+
+    nodes.clear();
+    for (int r = firstRow; r <= lastRow; ++r)
+        for (int c = firstColumn; c <= lastColumn; ++c)
+            nodes.push_back(static_cast<std::uint32_t>(r * columns + c));
+
+    resolve(walls);
+}
+
+void DistanceField::resolve(const Collision& walls) {
+    const std::size_t count = nodes.size();
+    if (count == 0) return;
+
+    xs.resize(count);
+    ys.resize(count);
+    closestXs.resize(count);
+    closestYs.resize(count);
+    inside.resize(count);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        xs[i] = origin.x + static_cast<float>(nodes[i] % columns) * cellSize;
+        ys[i] = origin.y + static_cast<float>(nodes[i] / columns) * cellSize;
+    }
+
+    walls.ContainsPoints(xs.data(), ys.data(), count, inside.data());
+    walls.GetClosestPointsOnBoundary(xs.data(), ys.data(), count, closestXs.data(), closestYs.data());
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const float dx = closestXs[i] - xs[i];
+        const float dy = closestYs[i] - ys[i];
+        const float distance = std::sqrt(dx * dx + dy * dy);
+
+        values[nodes[i]] = toFixed(inside[i] ? distance : -distance);
+    }
+}
+
+DistanceSample DistanceField::Sample(const sf::Vector2f& point) const {
+    const float fx = (point.x - origin.x) / cellSize;
+    const float fy = (point.y - origin.y) / cellSize;
+    const int c = static_cast<int>(std::floor(fx));
+    const int r = static_cast<int>(std::floor(fy));
+
+    if (c < 0 || r < 0 || c >= columns - 1 || r >= rows - 1) {
+        const sf::Vector2f center = origin + sf::Vector2f{static_cast<float>(columns - 1), static_cast<float>(rows - 1)} * (cellSize * 0.5f);
+        const sf::Vector2f toCenter = center - point;
+        const float length = std::sqrt(toCenter.x * toCenter.x + toCenter.y * toCenter.y);
+
+        return {-MAX_DISTANCE, length > 0.f ? toCenter / length : sf::Vector2f{}};
+    }
+
+    const float tx = fx - static_cast<float>(c);
+    const float ty = fy - static_cast<float>(r);
+
+    const std::int16_t* node = &values[static_cast<std::size_t>(r) * columns + c];
+    const float d00 = node[0] / SCALE;
+    const float d10 = node[1] / SCALE;
+    const float d01 = node[columns] / SCALE;
+    const float d11 = node[columns + 1] / SCALE;
+
+    const float top = d00 + (d10 - d00) * tx;
+    const float bottom = d01 + (d11 - d01) * tx;
+
+    const sf::Vector2f gradient{
+        (d10 - d00) * (1.f - ty) + (d11 - d01) * ty,
+        bottom - top};
+    const float length = std::sqrt(gradient.x * gradient.x + gradient.y * gradient.y);
+
+    return {top + (bottom - top) * ty, length > 0.f ? gradient / length : sf::Vector2f{}};
+}
+
+sf::Vector2f DistanceField::PushOut(const sf::Vector2f& point, const float clearance) const {
+    sf::Vector2f result = point;
+
+    // A second step settles points pushed from one wall toward another in a corner.
+    for (int step = 0; step < PUSH_STEPS; ++step) {
+        const DistanceSample sample = Sample(result);
+        if (sample.distance >= clearance || (sample.normal.x == 0.f && sample.normal.y == 0.f)) break;
+
+        result += sample.normal * (clearance - sample.distance);
+    }
+
+    return result;
+}
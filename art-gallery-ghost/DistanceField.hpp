@@ -0,0 +1,62 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstdint>
+#include <vector>
+
+class Collision;
+
+namespace core {
+    struct DistanceSample {
+        // Positive on the floor, negative inside walls.
+        float distance = 0.f;
+        // Unit gradient, pointing away from the nearest wall; zero where the field is saturated.
+        sf::Vector2f normal;
+    };
+
+    // Signed distance to the walls of a map, baked once into a grid of 16-bit fixed-point nodes so
+    // push-out and steering cost one bilinear lookup instead of an edge scan. Distances saturate at
+    // MAX_DISTANCE: only nodes that close to a wall are ever computed exactly.
+    class DistanceField {
+    public:
+        constexpr static float DEFAULT_CELL_SIZE = 16.f;
+        constexpr static float MAX_DISTANCE = 128.f;
+
+        // Covers the bounds of `walls`, whose contained points are the floor.
+        void Bake(const Collision& walls, const float cellSize = DEFAULT_CELL_SIZE);
+
+        // Recomputes every node within MAX_DISTANCE of `area` after the walls changed there.
+        void Rebake(const Collision& walls, const sf::FloatRect& area);
+
+        bool IsBaked() const { return !values.empty(); }
+
+        // Points off the grid are deep inside the walls and point back toward its center.
+        DistanceSample Sample(const sf::Vector2f& point) const;
+
+        // Moves `point` along the gradient until it is at least `clearance` away from the walls.
+        sf::Vector2f PushOut(const sf::Vector2f& point, const float clearance) const;
+
+        std::size_t GetNodeCount() const { return values.size(); }
+        std::size_t GetMemoryBytes() const { return values.size() * sizeof(std::int16_t); }
+
+    private:
+        sf::Vector2f origin;
+        float cellSize = DEFAULT_CELL_SIZE;
+        int columns = 0;
+        int rows = 0;
+
+        // Row-major nodes; node (c, r) sits at origin + (c, r) * cellSize.
+        std::vector<std::int16_t> values;
+
+        // Per-bake scratch.
+        std::vector<float> xs;
+        std::vector<float> ys;
+        std::vector<float> closestXs;
+        std::vector<float> closestYs;
+        std::vector<std::uint8_t> inside;
+        std::vector<std::uint32_t> nodes;
+
+        void resolve(const Collision& walls);
+    };
+}
@@ -0,0 +1,140 @@
+#include "EventLog.hpp"
+#include "MemoryStats.hpp"
+
+#include <iomanip>
+#include <iostream>
+
+using namespace core;
+
+namespace {
+    constexpr auto IDLE_SLEEP = std::chrono::milliseconds(10);
+
+    float unpackFloat(const std::uint32_t bits) {
+        float value = 0.f;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+}
+
+std::mutex EventLog::ringsMutex;
+std::vector<std::unique_ptr<EventLog::Ring>> EventLog::rings;
+std::atomic<bool> EventLog::running{false};
+std::int64_t EventLog::startTime = 0;
+std::thread EventLog::writer;
+std::ofstream EventLog::file;
+
+bool EventLog::Start(const std::string& path) {
+    if(running.load()) return true;
+
+    if(!path.empty()) {
+        file.open(path, std::ios::out | std::ios::app);
+        if(!file) {
+            std::cerr << "[log] cannot open " << path << std::endl;
+            return false;
+        }
+    }
+
+    startTime = std::chrono::steady_clock::now().time_since_epoch().count();
+    running = true;
+    writer = std::thread(&EventLog::writerLoop);
+    return true;
+}
+
+void EventLog::Stop() {
+    if(!running.exchange(false)) return;
+
+    if(writer.joinable()) writer.join();
+    if(file.is_open()) file.close();
+}
+
+EventLog::Ring& EventLog::localRing() {
+    thread_local Ring* ring = &registerRing();
+    return *ring;
+}
+
+EventLog::Ring& EventLog::registerRing() {
+    MemoryScope scope(MemoryTag::Log);
+    std::lock_guard<std::mutex> lock(ringsMutex);
+
+    rings.emplace_back(std::make_unique<Ring>());
+    rings.back()->id = static_cast<std::uint16_t>(rings.size() - 1);
+    return *rings.back();
+}
+
+void EventLog::writerLoop() {
+    MemoryScope scope(MemoryTag::Log);
+    std::ostream& out = file.is_open() ? static_cast<std::ostream&>(file) : std::cout;
+
+    while(running.load(std::memory_order_relaxed)) {
+        if(drainAll(out) == 0) {
+            out.flush();
+            std::this_thread::sleep_for(IDLE_SLEEP);
+        }
+    }
+
+    drainAll(out);
+    out.flush();
+}
+
+std::size_t EventLog::drainAll(std::ostream& out) {
+    // Copy the ring list so a thread registering its first event never waits on our I/O.
+    static std::vector<Ring*> active;
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        active.clear();
+        for(const auto& ring : rings)
+            active.push_back(ring.get());
+    }
+
+    std::size_t written = 0;
+
+    for(Ring* ring : active) {
+        written += ring->Drain([&out](const EventRecord& record) { format(out, record); });
+
+        if(const std::size_t dropped = ring->TakeDropped())
+            out << "[log] thread " << ring->id << " dropped " << dropped << " events\n";
+    }
+
+    return written;
+}
+
+void EventLog::format(std::ostream& out, const EventRecord& record) {
+    const double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::duration(record.timestamp - startTime)).count();
+
+    out << '[' << std::fixed << std::setprecision(3) << seconds << "s t" << record.thread << "] ";
+
+    const auto& args = record.args;
+    switch(record.type) {
+        case Event::OutOfAmmo:
+            out << "OUT OF AMMO at (" << std::setprecision(1) << unpackFloat(args[0]) << ", " << unpackFloat(args[1]) << ')';
+            break;
+        case Event::PlayerJoined:
+            out << "player " << args[0] << " joined from "
+                << (args[1] >> 24) << '.' << ((args[1] >> 16) & 0xff) << '.' << ((args[1] >> 8) & 0xff) << '.' << (args[1] & 0xff)
+                << ':' << args[2];
+            break;
+        case Event::PlayerLeft:
+            out << "player " << args[0] << " left after " << std::setprecision(1) << unpackFloat(args[1]) << "s of silence";
+            break;
+        case Event::FrameStats:
+            out << "frame " << std::setprecision(2) << unpackFloat(args[0]) << " ms mean, " << unpackFloat(args[1])
+                << " ms p99, " << unpackFloat(args[2]) << " ms jitter, " << args[3] << " missed";
+            break;
+        case Event::MemoryStats:
+            out << "memory " << GetMemoryTagName(static_cast<MemoryTag>(args[0])) << ": " << std::setprecision(1)
+                << unpackFloat(args[1]) << " KB live, " << unpackFloat(args[2]) << " KB peak, "
+                << args[3] << " allocs last frame";
+            break;
+        case Event::Autosave:
+            out << "autosave " << args[0] << ": " << args[1] << " chunks, " << std::setprecision(1)
+                << unpackFloat(args[2]) << " KB in " << unpackFloat(args[3]) << " ms";
+            break;
+        case Event::HeapStats:
+            out << "heap: " << std::setprecision(1) << unpackFloat(args[0]) << " KB live, "
+                << unpackFloat(args[1]) << " KB peak, " << args[2] << " blocks";
+            break;
+    }
+
+    out << '\n';
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace core {
+    enum class Event : std::uint16_t {
+        OutOfAmmo,      // x, y of the shooter
+        PlayerJoined,   // player id, IPv4 address, port
+        PlayerLeft,     // player id, seconds silent
+        FrameStats,     // mean, p99 and jitter in ms, missed frames
+        MemoryStats,    // MemoryTag, live and peak KB in its TaggedAllocators, allocations last frame
+        Autosave,       // save generation, chunks rewritten, KB written, ms on the writer thread
+        HeapStats,      // live and peak KB, live blocks
+    };
+
+    // One preformatted binary record; formatting happens on the writer thread.
+    struct EventRecord {
+        std::int64_t timestamp = 0;
+        Event type = Event::OutOfAmmo;
+        std::uint16_t thread = 0;
+        std::array<std::uint32_t, 4> args{};
+    };
+
+    static_assert(std::is_trivially_copyable_v<EventRecord>, "EventRecord is copied as raw bytes");
+
+    // Structured gameplay log. Emit() writes into a per-thread single-producer ring and never
+    // blocks or allocates after a thread's first call; a background thread formats and writes.
+    // When a ring is full the record is dropped and counted instead of waiting.
+    class EventLog {
+    public:
+        constexpr static std::size_t RING_CAPACITY = 1024;
+
+        // Starts the writer thread. An empty path logs to the console.
+        static bool Start(const std::string& path = {});
+        static void Stop();
+
+        template <typename... Args>
+        static void Emit(const Event type, const Args... args) {
+            static_assert(sizeof...(Args) <= 4, "at most four event arguments");
+
+            EventRecord record;
+            record.timestamp = std::chrono::steady_clock::now().time_since_epoch().count();
+            record.type = type;
+
+            [[maybe_unused]] std::size_t i = 0;
+            ((record.args[i++] = pack(args)), ...);
+
+            Ring& ring = localRing();
+            record.thread = ring.id;
+            ring.Push(record);
+        }
+
+    private:
+        class Ring {
+        public:
+            std::uint16_t id = 0;
+
+            void Push(const EventRecord& record) {
+                const std::size_t head = this->head.load(std::memory_order_relaxed);
+                if(head - tail.load(std::memory_order_acquire) >= RING_CAPACITY) {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+
+                records[head % RING_CAPACITY] = record;
+                this->head.store(head + 1, std::memory_order_release);
+            }
+
+            template <typename Sink>
+            std::size_t Drain(Sink&& sink) {
+                const std::size_t head = this->head.load(std::memory_order_acquire);
+                std::size_t tail = this->tail.load(std::memory_order_relaxed);
+                const std::size_t count = head - tail;
+
+                for(; tail != head; ++tail)
+                    sink(records[tail % RING_CAPACITY]);
+
+                this->tail.store(tail, std::memory_order_release);
+                return count;
+            }
+
+            std::size_t TakeDropped() { return dropped.exchange(0, std::memory_order_relaxed); }
+
+        private:
+            std::array<EventRecord, RING_CAPACITY> records{};
+            alignas(64) std::atomic<std::size_t> head{0};
+            alignas(64) std::atomic<std::size_t> tail{0};
+            std::atomic<std::size_t> dropped{0};
+        };
+
+        template <typename T>
+        static std::uint32_t pack(const T value) {
+            static_assert(sizeof(T) <= sizeof(std::uint32_t) && std::is_trivially_copyable_v<T>, "event arguments are 32-bit scalars");
+
+            std::uint32_t bits = 0;
+            if constexpr (std::is_floating_point_v<T>) std::memcpy(&bits, &value, sizeof(T));
+            else bits = static_cast<std::uint32_t>(value);
+            return bits;
+        }
+
+        static Ring& localRing();
+        static Ring& registerRing();
+
+        static void writerLoop();
+        static std::size_t drainAll(std::ostream& out);
+        static void format(std::ostream& out, const EventRecord& record);
+
+        // Rings outlive their threads so late records are still written.
+        static std::mutex ringsMutex;
+        static std::vector<std::unique_ptr<Ring>> rings;
+
+        static std::atomic<bool> running;
+        static std::int64_t startTime;
+        static std::thread writer;
+        static std::ofstream file;
+    };
+
+    // Stops the log on every way out of the scope it is built in. A writer thread still running
+    // when static destructors run would end the process in std::terminate.
+    class EventLogGuard {
+    public:
+        EventLogGuard() = default;
+        ~EventLogGuard() { EventLog::Stop(); }
+
+        EventLogGuard(const EventLogGuard&) = delete;
+        EventLogGuard& operator=(const EventLogGuard&) = delete;
+    };
+}
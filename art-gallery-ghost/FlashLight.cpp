@@ -1,7 +1,7 @@
 #include "FlashLight.hpp"
-#include "Movement.hpp"
 #include "Object.hpp"
-#include "Player.hpp"
+#include "Tessellation.hpp"
+#include "RenderStats.hpp"
 
 #include <cmath>
 
@@ -9,32 +9,47 @@ using namespace core;
 
 constexpr float PI = 3.141592f;
 
-void FlashLight::Render(sf::RenderWindow& window) const {
+sf::Vector2f FlashLight::getOrigin() const {
+    return mount ? mount->GetWorldPosition() : owner->GetTransform().GetWorldPosition();
+}
+
+std::optional<Cone> FlashLight::GetCone() const {
+    if(!isSwitchOn) return std::nullopt;
+
+    return Cone{getOrigin(), startAngle, fanWidth, radius};
+}
+
+void FlashLight::Render(sf::RenderTarget& target, const std::optional<sf::Vector2f>& aim) const {
     if(!isSwitchOn) return;
 
-    auto movement = std::dynamic_pointer_cast<Movement>(owner->GetComponent("movement").lock());
-    if(!movement) return;
+    sf::Vector2f pos = getOrigin();
+
+    float start = startAngle;
+    if(aim) {
+        const sf::Vector2f direction = *aim - pos;
+        start = std::atan2(direction.y, direction.x) * 180.0f / PI - fanWidth / 2.0f;
+    }
 
-    sf::Vector2f pos = movement->GetPos() + sf::Vector2f(Player::SHAPE_RADIUS, Player::SHAPE_RADIUS);
     sf::Color color = sf::Color(FLASH_COLOR.r, FLASH_COLOR.g, FLASH_COLOR.b, alpha);
     
-    sf::VertexArray vertices = getVertices(pos, color);
-    window.draw(vertices);
+    const std::size_t segments = ArcSegments(radius * PixelsPerUnit(target), fanWidth * PI / 180.0f);
+
+    buildFan(pos, start, color, segments);
+    target.draw(fan.data(), fan.size(), sf::PrimitiveType::TriangleFan);
+    CountDraw(fan.size());
 }
 
-sf::VertexArray FlashLight::getVertices(const sf::Vector2f pos, const sf::Color& color) const {
-    sf::VertexArray vertices(sf::PrimitiveType::TriangleFan);
-    vertices.append({pos, color});
+void FlashLight::buildFan(const sf::Vector2f pos, const float start, const sf::Color& color, const std::size_t segments) const {
+    fan.resize(segments + 2);
+    fan[0] = {pos, color};
 
-    const float angleStep = fanWidth / static_cast<float>(POINT_COUNT - 1);
+    const float angleStep = fanWidth / static_cast<float>(segments);
 
-    for(unsigned int i = 1; i < POINT_COUNT; ++i) {
-        float angle = startAngle + (i - 1) * angleStep;
+    for(std::size_t i = 0; i <= segments; ++i) {
+        float angle = start + static_cast<float>(i) * angleStep;
         float x = pos.x + radius * std::cos(angle * PI / 180.0f);
         float y = pos.y + radius * std::sin(angle * PI / 180.0f);
 
-        vertices.append({{x, y}, color});
+        fan[i + 1] = {{x, y}, color};
     }
-    
-    return vertices;
 }
\ No newline at end of file
@@ -2,7 +2,11 @@
 
 #include <SFML/Graphics.hpp>
 #include "Component.hpp"
+#include "Transform.hpp"
+#include "Visibility.hpp"
 #include <memory>
+#include <optional>
+#include <vector>
 #include <algorithm>
 
 class FlashLight : public core::Component{
@@ -16,11 +20,22 @@ public:
     constexpr static std::uint8_t MIN_ALPHA = 64;
     constexpr static std::uint8_t WHEEL_LEVEL = 12;
 
+    struct State {
+        float fanWidth;
+        float radius;
+        float startAngle;
+        std::uint8_t alpha;
+        bool isSwitchOn;
+    };
+
     FlashLight(core::Object * obj) : core::Component(obj) {}
 
     void Update(const float deltaTime) override {};
     std::string_view GetTag() const override { return tag; }
 
+    // The cone starts at the mount's world position, or at the owner's origin without one.
+    void Mount(const core::Transform* mount) { this->mount = mount; }
+
     bool GetSwitch() const { return isSwitchOn; }
     void ToggleSwitch() { isSwitchOn = !isSwitchOn; }
 
@@ -55,17 +70,34 @@ public:
         alpha = std::max(static_cast<int>(MIN_ALPHA), std::min(newAlpha, static_cast<int>(MAX_ALPHA)));
     }
 
-    void Render(sf::RenderWindow& window) const;
+    State GetState() const { return {fanWidth, radius, startAngle, alpha, isSwitchOn}; }
+    void SetState(const State& state) {
+        fanWidth = state.fanWidth;
+        radius = state.radius;
+        startAngle = state.startAngle;
+        alpha = state.alpha;
+        isSwitchOn = state.isSwitchOn;
+    }
+
+    // The lit cone in world space, or nothing while the light is off.
+    std::optional<core::Cone> GetCone() const;
+
+    // A late-latched aim point turns the drawn cone only; the simulated angle is left alone.
+    void Render(sf::RenderTarget& target, const std::optional<sf::Vector2f>& aim = std::nullopt) const;
 
 private:
     constexpr static std::string_view tag = "flashlight";
-    constexpr static int POINT_COUNT = 30;
 
     float fanWidth = MIN_FAN_WIDTH;
     float radius = MAX_RADIUS;
     float startAngle = 0.f;
     std::uint8_t alpha = MAX_ALPHA;
     bool isSwitchOn = false;
+    const core::Transform* mount = nullptr;
+
+    // Rebuilt in place every frame; only grows when the fan needs more segments.
+    mutable std::vector<sf::Vertex> fan;
 
-    sf::VertexArray getVertices(const sf::Vector2f pos, const sf::Color& color) const;
+    sf::Vector2f getOrigin() const;
+    void buildFan(const sf::Vector2f pos, const float start, const sf::Color& color, const std::size_t segments) const;
 };
\ No newline at end of file
@@ -0,0 +1,241 @@
+#include "FogOfWar.hpp"
+#include "Collision.hpp"
+#include "RenderStats.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+using namespace core;
+
+std::uint64_t& FogOfWar::word(const int column, const int row) {
+    const int chunk = (row / CHUNK_SIZE) * chunkColumns + column / CHUNK_SIZE;
+    return bits[static_cast<std::size_t>(chunk) * CHUNK_SIZE + row % CHUNK_SIZE];
+}
+
+std::uint64_t FogOfWar::word(const int column, const int row) const {
+    const int chunk = (row / CHUNK_SIZE) * chunkColumns + column / CHUNK_SIZE;
+    return bits[static_cast<std::size_t>(chunk) * CHUNK_SIZE + row % CHUNK_SIZE];
+}
+
+void FogOfWar::Reset(const Collision& walls, const float cellSize) {
+    const sf::FloatRect bounds = walls.GetBounds();
+
+    this->cellSize = cellSize;
+    origin = bounds.position;
+    columns = std::max(1, static_cast<int>(std::ceil(bounds.size.x / cellSize)));
+    rows = std::max(1, static_cast<int>(std::ceil(bounds.size.y / cellSize)));
+    chunkColumns = (columns + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    chunkRows = (rows + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    const std::size_t chunks = static_cast<std::size_t>(chunkColumns) * chunkRows;
+    bits.assign(chunks * CHUNK_SIZE, 0);
+    explored = 0;
+    floorCells = 0;
+
+    // Padding past the last column or row counts as explored so it is never tested.
+    std::vector<float> xs(static_cast<std::size_t>(columns));
+    std::vector<float> ys(static_cast<std::size_t>(columns));
+    std::vector<std::uint8_t> inside(static_cast<std::size_t>(columns));
+
+    for (int c = 0; c < columns; ++c)
+        xs[c] = origin.x + (static_cast<float>(c) + 0.5f) * cellSize;
+
+    for (int r = 0; r < chunkRows * CHUNK_SIZE; ++r) {
+        if (r >= rows) {
+            for (int chunk = 0; chunk < chunkColumns; ++chunk)
+                word(chunk * CHUNK_SIZE, r) = ~std::uint64_t{0};
+            continue;
+        }
+
+        std::fill(ys.begin(), ys.end(), origin.y + (static_cast<float>(r) + 0.5f) * cellSize);
+        walls.ContainsPoints(xs.data(), ys.data(), xs.size(), inside.data());
+
+        for (int c = 0; c < chunkColumns * CHUNK_SIZE; ++c) {
+            if (c < columns && inside[c]) ++floorCells;
+            else word(c, r) |= std::uint64_t{1} << (c % CHUNK_SIZE);
+        }
+    }
+
+    revisions.assign(chunks, 0);
+    dirty.assign(chunks, 1);
+    dirtyChunks.resize(chunks);
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+        dirtyChunks[chunk] = static_cast<std::uint32_t>(chunk);
+
+    textureReady = false;
+}
+
+void FogOfWar::Reveal(const Cone& cone, const Collision* walls) {
+    if (bits.empty() || cone.radius <= 0.f || cone.fanWidth <= 0.f) return;
+
+    const sf::FloatRect bounds = ConeBounds(cone);
+    const int firstColumn = std::max(0, static_cast<int>(std::floor((bounds.position.x - origin.x) / cellSize)));
+    const int lastColumn = std::min(columns - 1, static_cast<int>(std::floor((bounds.position.x + bounds.size.x - origin.x) / cellSize)));
+    const int firstRow = std::max(0, static_cast<int>(std::floor((bounds.position.y - origin.y) / cellSize)));
+    const int lastRow = std::min(rows - 1, static_cast<int>(std::floor((bounds.position.y + bounds.size.y - origin.y) / cellSize)));
+    if (firstColumn > lastColumn || firstRow > lastRow) return;
+
+    candidateX.clear();
+    candidateY.clear();
+    candidateCells.clear();
+
+    for (int r = firstRow; r <= lastRow; ++r) {
+        const float y = origin.y + (static_cast<float>(r) + 0.5f) * cellSize;
+
+        for (int c = firstColumn; c <= lastColumn;) {
+            // Walk the unexplored bits of this chunk row within the column range.
+            const int chunkEnd = std::min(lastColumn + 1, (c / CHUNK_SIZE + 1) * CHUNK_SIZE);
+            std::uint64_t open = ~word(c, r);
+
+            const int low = c % CHUNK_SIZE;
+            const int high = (chunkEnd - 1) % CHUNK_SIZE;
+            open &= (~std::uint64_t{0} << low) & (~std::uint64_t{0} >> (CHUNK_SIZE - 1 - high));
+
+            const int base = c - low;
+            while (open) {
+                const int bit = std::countr_zero(open);
+                open &= open - 1;
+
+                candidateX.push_back(origin.x + (static_cast<float>(base + bit) + 0.5f) * cellSize);
+                candidateY.push_back(y);
+                candidateCells.push_back(static_cast<std::uint32_t>(r * columns + base + bit));
+            }
+
+            c = chunkEnd;
+        }
+    }
+
+    if (candidateCells.empty()) return;
+
+    inCone.resize(candidateCells.size());
+    ConeContains(cone, candidateX.data(), candidateY.data(), candidateCells.size(), inCone.data());
+
+    std::size_t lit = 0;
+    for (std::size_t i = 0; i < candidateCells.size(); ++i) {
+        if (!inCone[i]) continue;
+
+        candidateX[lit] = candidateX[i];
+        candidateY[lit] = candidateY[i];
+        candidateCells[lit] = candidateCells[i];
+        ++lit;
+    }
+
+    blocked.assign(lit, 0);
+    if (walls && lit > 0)
+        walls->SegmentsBlocked(cone.origin, candidateX.data(), candidateY.data(), lit, blocked.data());
+
+    for (std::size_t i = 0; i < lit; ++i) {
+        if (blocked[i]) continue;
+
+        const int cell = static_cast<int>(candidateCells[i]);
+        markExplored(cell % columns, cell / columns);
+    }
+}
+
+bool FogOfWar::IsExplored(const sf::Vector2f& point) const {
+    if (bits.empty()) return false;
+
+    const int c = static_cast<int>(std::floor((point.x - origin.x) / cellSize));
+    const int r = static_cast<int>(std::floor((point.y - origin.y) / cellSize));
+    if (c < 0 || r < 0 || c >= columns || r >= rows) return false;
+
+    return (word(c, r) >> (c % CHUNK_SIZE)) & 1;
+}
+
+float FogOfWar::GetExploredFraction() const {
+    return floorCells > 0 ? static_cast<float>(explored) / static_cast<float>(floorCells) : 0.f;
+}
+
+void FogOfWar::markExplored(const int column, const int row) {
+    word(column, row) |= std::uint64_t{1} << (column % CHUNK_SIZE);
+    ++explored;
+
+    const std::uint32_t chunk = static_cast<std::uint32_t>((row / CHUNK_SIZE) * chunkColumns + column / CHUNK_SIZE);
+    ++revisions[chunk];
+
+    if (!dirty[chunk]) {
+        dirty[chunk] = 1;
+        dirtyChunks.push_back(chunk);
+    }
+}
+
+void FogOfWar::WriteChunk(const std::size_t chunk, ByteWriter& out) const {
+    out.WriteBytes(&bits[chunk * CHUNK_SIZE], CHUNK_SIZE * sizeof(std::uint64_t));
+}
+
+bool FogOfWar::ReadChunk(const std::size_t chunk, ByteReader& in) {
+    std::uint64_t saved[CHUNK_SIZE];
+    if (chunk >= revisions.size() || !in.ReadBytes(saved, sizeof(saved)) || !in.AtEnd()) return false;
+
+    for (std::size_t r = 0; r < CHUNK_SIZE; ++r) {
+        std::uint64_t& current = bits[chunk * CHUNK_SIZE + r];
+        explored += static_cast<std::size_t>(std::popcount(saved[r] & ~current));
+        current |= saved[r];
+    }
+
+    if (!dirty[chunk]) {
+        dirty[chunk] = 1;
+        dirtyChunks.push_back(static_cast<std::uint32_t>(chunk));
+    }
+
+    return true;
+}
+
+void FogOfWar::Draw(sf::RenderTarget& target) {
+    if (bits.empty()) return;
+
+    if (!textureReady) {
+        const sf::Vector2u size{
+            static_cast<unsigned int>(chunkColumns * CHUNK_SIZE),
+            static_cast<unsigned int>(chunkRows * CHUNK_SIZE)};
+
+        if (!texture.resize(size)) return;
+
+        texture.setSmooth(true);
+        textureReady = true;
+    }
+
+    for (const std::uint32_t chunk : dirtyChunks) {
+        uploadChunk(chunk);
+        dirty[chunk] = 0;
+    }
+    dirtyChunks.clear();
+
+    const float width = static_cast<float>(chunkColumns * CHUNK_SIZE);
+    const float height = static_cast<float>(chunkRows * CHUNK_SIZE);
+    const sf::Vector2f extent{width * cellSize, height * cellSize};
+
+    const sf::Vertex quad[] = {
+        {origin, sf::Color::White, {0.f, 0.f}},
+        {origin + sf::Vector2f{extent.x, 0.f}, sf::Color::White, {width, 0.f}},
+        {origin + sf::Vector2f{0.f, extent.y}, sf::Color::White, {0.f, height}},
+        {origin + extent, sf::Color::White, {width, height}},
+    };
+
+    target.draw(quad, 4, sf::PrimitiveType::TriangleStrip, sf::RenderStates(&texture));
+    CountDraw(4);
+}
+
+void FogOfWar::uploadChunk(const std::uint32_t chunk) {
+    pixels.resize(CHUNK_SIZE * CHUNK_SIZE * 4);
+
+    for (int r = 0; r < CHUNK_SIZE; ++r) {
+        const std::uint64_t row = bits[static_cast<std::size_t>(chunk) * CHUNK_SIZE + r];
+
+        for (int c = 0; c < CHUNK_SIZE; ++c) {
+            const bool open = (row >> c) & 1;
+            std::uint8_t* pixel = &pixels[static_cast<std::size_t>(r * CHUNK_SIZE + c) * 4];
+
+            pixel[0] = FOG_COLOR.r;
+            pixel[1] = FOG_COLOR.g;
+            pixel[2] = FOG_COLOR.b;
+            pixel[3] = open ? 0 : FOG_COLOR.a;
+        }
+    }
+
+    const unsigned int chunkX = chunk % static_cast<std::uint32_t>(chunkColumns);
+    const unsigned int chunkY = chunk / static_cast<std::uint32_t>(chunkColumns);
+
+    texture.update(pixels.data(), {CHUNK_SIZE, CHUNK_SIZE}, {chunkX * CHUNK_SIZE, chunkY * CHUNK_SIZE});
+}
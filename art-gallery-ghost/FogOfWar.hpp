@@ -0,0 +1,84 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include "Visibility.hpp"
+#include "ByteStream.hpp"
+
+#include <cstdint>
+#include <vector>
+
+class Collision;
+
+namespace core {
+    // Which parts of the floor the flashlight has ever lit, at one bit per cell. Cells are grouped
+    // in 64x64 chunks stored as one 64-bit word per chunk row, so skipping an explored run is a
+    // word compare and only chunks that changed are re-uploaded to the fog texture.
+    class FogOfWar {
+    public:
+        constexpr static float DEFAULT_CELL_SIZE = 16.f;
+        constexpr static int CHUNK_SIZE = 64;
+        constexpr static sf::Color FOG_COLOR = sf::Color{0, 0, 0, 200};
+
+        // Covers the bounds of `walls`. Cells whose centers are off the floor start explored, so
+        // nothing keeps testing space the light can never reach.
+        void Reset(const Collision& walls, const float cellSize = DEFAULT_CELL_SIZE);
+
+        // Only cells that are still unexplored and inside the cone's bounds are tested.
+        void Reveal(const Cone& cone, const Collision* walls);
+
+        bool IsExplored(const sf::Vector2f& point) const;
+        std::size_t GetExploredCount() const { return explored; }
+        std::size_t GetFloorCount() const { return floorCells; }
+        float GetExploredFraction() const;
+
+        std::size_t GetDirtyCount() const { return dirtyChunks.size(); }
+        std::size_t GetMemoryBytes() const { return bits.size() * sizeof(std::uint64_t); }
+
+        std::size_t GetChunkCount() const { return revisions.size(); }
+
+        // Bumped whenever a cell in the chunk is explored.
+        std::uint32_t GetChunkRevision(const std::size_t chunk) const { return revisions[chunk]; }
+
+        // The chunk's explored bits. ReadChunk merges them into the current ones, so the fog must
+        // have been reset over the same walls as the one that wrote them.
+        void WriteChunk(const std::size_t chunk, ByteWriter& out) const;
+        bool ReadChunk(const std::size_t chunk, ByteReader& in);
+
+        // Darkens unexplored cells. Chunks changed since the last draw are uploaded first.
+        void Draw(sf::RenderTarget& target);
+
+    private:
+        sf::Vector2f origin;
+        float cellSize = DEFAULT_CELL_SIZE;
+        int columns = 0;
+        int rows = 0;
+        int chunkColumns = 0;
+        int chunkRows = 0;
+
+        // Chunk-major; chunk c row r is bits[c * CHUNK_SIZE + r], column x is bit x.
+        std::vector<std::uint64_t> bits;
+        std::size_t floorCells = 0;
+        std::size_t explored = 0;
+
+        std::vector<std::uint8_t> dirty;
+        std::vector<std::uint32_t> dirtyChunks;
+        std::vector<std::uint32_t> revisions;
+
+        sf::Texture texture;
+        bool textureReady = false;
+        std::vector<std::uint8_t> pixels;
+
+        // Per-reveal scratch, kept to avoid allocating every tick.
+        std::vector<float> candidateX;
+        std::vector<float> candidateY;
+        std::vector<std::uint32_t> candidateCells;
+        std::vector<std::uint8_t> inCone;
+        std::vector<std::uint8_t> blocked;
+
+        std::uint64_t& word(const int column, const int row);
+        std::uint64_t word(const int column, const int row) const;
+        void markExplored(const int column, const int row);
+        void uploadChunk(const std::uint32_t chunk);
+    };
+}
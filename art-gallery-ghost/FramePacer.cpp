@@ -0,0 +1,78 @@
+#include "FramePacer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+using namespace core;
+
+namespace {
+    constexpr auto MIN_SPIN_MARGIN = std::chrono::microseconds(200);
+    constexpr auto MAX_SPIN_MARGIN = std::chrono::milliseconds(4);
+}
+
+FramePacer::FramePacer(const float fps)
+    : period(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / fps)))
+    , deadline(Clock::now())
+    , spinMargin(std::chrono::milliseconds(2)) {
+}
+
+void FramePacer::Wait() {
+    Clock::time_point now = Clock::now();
+
+    deadline += period;
+    if(now > deadline + period) deadline = now;
+
+    while(deadline - now > spinMargin) {
+        const Clock::time_point wake = deadline - spinMargin;
+        std::this_thread::sleep_until(wake);
+        now = Clock::now();
+
+        // Grow the margin to the worst oversleep seen, and let it shrink slowly when sleeps are accurate.
+        const Clock::duration late = now - wake;
+        spinMargin = std::clamp<Clock::duration>(
+            std::max<Clock::duration>(late + late / 4, spinMargin - spinMargin / 64),
+            MIN_SPIN_MARGIN, MAX_SPIN_MARGIN);
+    }
+
+    while(Clock::now() < deadline)
+        std::this_thread::yield();
+}
+
+void FramePacer::MarkFrame() {
+    const Clock::time_point now = Clock::now();
+
+    if(hasLastFrame)
+        frameTimes[recorded++ % HISTORY] = std::chrono::duration<float, std::milli>(now - lastFrame).count();
+
+    lastFrame = now;
+    hasLastFrame = true;
+}
+
+FrameStats FramePacer::GetStats() const {
+    FrameStats stats;
+    stats.frames = std::min(recorded, HISTORY);
+    if(stats.frames == 0) return stats;
+
+    std::array<float, HISTORY> sorted = frameTimes;
+    std::sort(sorted.begin(), sorted.begin() + stats.frames);
+
+    const float missedMs = std::chrono::duration<float, std::milli>(period).count() * 1.5f;
+
+    float sum = 0.f;
+    for(std::size_t i = 0; i < stats.frames; ++i) {
+        sum += sorted[i];
+        stats.missed += sorted[i] > missedMs;
+    }
+    stats.meanMs = sum / static_cast<float>(stats.frames);
+
+    float variance = 0.f;
+    for(std::size_t i = 0; i < stats.frames; ++i)
+        variance += (sorted[i] - stats.meanMs) * (sorted[i] - stats.meanMs);
+    stats.jitterMs = std::sqrt(variance / static_cast<float>(stats.frames));
+
+    stats.p99Ms = sorted[std::min(stats.frames - 1, stats.frames * 99 / 100)];
+    stats.maxMs = sorted[stats.frames - 1];
+
+    return stats;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+namespace core {
+    struct FrameStats {
+        float meanMs = 0.f;
+        float p99Ms = 0.f;
+        float maxMs = 0.f;
+        float jitterMs = 0.f;       // standard deviation of the frame time
+        std::size_t missed = 0;     // frames longer than 1.5 periods
+        std::size_t frames = 0;
+    };
+
+    // High-resolution frame pacer. Wait() sleeps while the deadline is far away and spins the
+    // last stretch, learning how late the OS wakes us so the spin stays as short as possible.
+    class FramePacer {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        constexpr static std::size_t HISTORY = 240;
+
+        explicit FramePacer(const float fps);
+
+        // Blocks until the next frame deadline. A hitch longer than a period restarts the schedule
+        // rather than running frames back to back to catch up.
+        void Wait();
+
+        // Records the time since the previous call as one frame.
+        void MarkFrame();
+
+        // Statistics over the last HISTORY frames.
+        FrameStats GetStats() const;
+
+    private:
+        Clock::duration period;
+        Clock::time_point deadline;
+        Clock::duration spinMargin;
+
+        Clock::time_point lastFrame;
+        bool hasLastFrame = false;
+
+        std::array<float, HISTORY> frameTimes{};
+        std::size_t recorded = 0;
+    };
+}
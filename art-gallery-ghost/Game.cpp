@@ -7,19 +7,48 @@
 #include "Collision.hpp"
 #include "Gun.hpp"
 #include "FlashLight.hpp"
+#include "Physics.hpp"
+#include "PlayerInput.hpp"
+#include "EventLog.hpp"
+#include "Hud.hpp"
+#include "Particles.hpp"
 
 #include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
 
 using namespace core;
 
-const float MAP_SIZE = 3000.f;
-constexpr float PI = 3.141592f;
-
 const std::uint8_t FPS = 60;
+const std::uint32_t ROLLBACK_CHECK_TICKS = 8;
+const std::uint32_t FRAME_STATS_INTERVAL = 300;
+const std::size_t IMPACT_PARTICLES = 16;
+const std::size_t GHOST_PARTICLES = 256;
+const float HUD_MARGIN = 16.f;
+const std::uint32_t AUTOSAVE_TICKS = FPS * 30;
+const float STEP_LENGTH = 80.f;
+// Longer moves in one tick are teleports, such as a restored save, and make no step.
+const float MAX_STEP = 200.f;
+const float GUNSHOT_GAIN = 1.f;
+const float FOOTSTEP_GAIN = 0.35f;
+const float IMPACT_GAIN = 0.6f;
+const float GHOST_GAIN = 0.5f;
+
+namespace {
+    WorldConfig worldConfig(const std::uint32_t seed, const float mapSize) {
+        WorldConfig config;
+        config.seed = seed;
+        config.mapSize = mapSize;
+        config.tickTime = 1.f / FPS;
+        return config;
+    }
+}
 
 Game::Game(const std::string& title, const std::uint16_t width, const std::uint16_t height)
     : window(nullptr)
+    , pacer(FPS)
     , windowTitle(title)
     , screenWidth(width)
     , screenHeight(height) {
@@ -39,24 +68,94 @@ Game::Game(const std::string& title, const std::uint16_t width, const std::uint1
 
     window->setView(*view);
 
-    objects.emplace_back(std::make_unique<Map>(MAP_SIZE));
+    ammoGauge = &hud.Add<AmmoGauge>();
+    zoomGauge = &hud.Add<ZoomGauge>();
+    zoomGauge->SetPosition({HUD_MARGIN, static_cast<float>(screenHeight) - HUD_MARGIN - ZoomGauge::SIZE.y});
+
+    world = std::make_unique<World>(worldConfig(std::random_device{}(), Map::DEFAULT_SIZE));
 
-    player = std::make_unique<Player>(0.f, 0.f);
+    Particles::SetEmitting(true);
+
+    if(!mixer.Start(MakeDeviceBackend())) {
+        std::cerr << "[audio] no sound device, playing muted" << std::endl;
+        sounds.SetMixer(nullptr);
+    }
 }
 
 void Game::Run() {
     while(window->isOpen()) {
+        if(lowLatency) pacer.Wait();
+
         handleEvents();
-        update();
 
-        window->clear();
-        render();
-        window->display();
+        {
+            MemoryScope scope(MemoryTag::Gameplay);
+            update();
+            latchAim();
+        }
+
+        {
+            MemoryScope scope(MemoryTag::Rendering);
+            window->clear();
+            render();
+            window->display();
+        }
+
+        EndMemoryFrame();
+        pacer.MarkFrame();
+        if(lowLatency && ++frameCount % FRAME_STATS_INTERVAL == 0)
+            reportFrameStats();
     }
 }
 
+void Game::SetLowLatency(const bool enabled) {
+    lowLatency = enabled;
+
+    window->setVerticalSyncEnabled(false);
+    window->setFramerateLimit(enabled ? 0 : FPS);
+}
+
 void Game::Clear() {
+    if(client) client->Disconnect();
+
+    // The last save is the only one the game waits for.
+    if(autosave.IsRunning()) {
+        autosave.Wait();
+        nextAutosaveTick = world->GetTick();
+        captureSave();
+        autosave.Stop();
+    }
+}
+
+bool Game::EnableAutosave(const std::filesystem::path& directory) {
+    if(client) {
+        std::cerr << "[autosave] networked games are not saved" << std::endl;
+        return false;
+    }
+
+    SaveGame save;
+    const bool resumed = Autosave::Load(directory, save) && restoreSave(save);
+
+    if(!autosave.Start(directory)) return false;
+    if(resumed) autosave.MarkSaved(*world->GetMap().GetWalls(), world->GetFog());
+
+    nextAutosaveTick = world->GetTick() + AUTOSAVE_TICKS;
+    return true;
+}
+
+bool Game::Connect(const std::string& host, const unsigned short port) {
+    client = std::make_unique<net::Client>(true);
+
+    if(!client->Connect(host, port)) {
+        client.reset();
+        return false;
+    }
 
+    // The server never carves its walls, so ours have to stay intact as well.
+    world = std::make_unique<World>(worldConfig(client->GetMapSeed(), client->GetMapSize()));
+    world->SetCarving(false);
+
+    return true;
 }
 
 void Game::handleEvents() {
@@ -68,31 +167,31 @@ void Game::handleEvents() {
             if(keyPressed->scancode == sf::Keyboard::Scan::Escape)
                 window->close();
 
-            else if(keyPressed->scancode == sf::Keyboard::Scan::R) {
-                auto gun = std::dynamic_pointer_cast<Gun>(player->GetComponent("gun").lock());
-                if(gun) gun->Reload();
-            }
+            else if(keyPressed->scancode == sf::Keyboard::Scan::R)
+                input.buttons |= InputCommand::Reload;
 
             else if(keyPressed->scancode == sf::Keyboard::Scan::Space)
                 isFollowingPlayer = true;
+
+            else if(keyPressed->scancode == sf::Keyboard::Scan::F9)
+                verifyRollback(ROLLBACK_CHECK_TICKS);
+
+            else if(keyPressed->scancode == sf::Keyboard::Scan::F10)
+                reportFrameStats();
+
+            else if(keyPressed->scancode == sf::Keyboard::Scan::F11)
+                reportMemoryStats();
         }
         else if(const auto* keyReleased = event->getIf<sf::Event::KeyReleased>()) {
             if(keyReleased->scancode == sf::Keyboard::Scan::Space) 
                 isFollowingPlayer = false;
         }
         else if(const auto* mousePressed = event->getIf<sf::Event::MouseButtonPressed>()) {
-            if(mousePressed->button == sf::Mouse::Button::Left) {
-                sf::Vector2i mousePos = sf::Mouse::getPosition(*window);
-                sf::Vector2f worldMousePos = window->mapPixelToCoords(mousePos);
-
-                auto gun = std::dynamic_pointer_cast<Gun>(player->GetComponent("gun").lock());
-                if(gun) gun->Fire(worldMousePos);
-            }
+            if(mousePressed->button == sf::Mouse::Button::Left)
+                input.buttons |= InputCommand::Fire;
 
-            if(mousePressed->button == sf::Mouse::Button::Right) {
-                auto flashlight = std::dynamic_pointer_cast<FlashLight>(player->GetComponent("flashlight").lock());
-                if(flashlight) flashlight->ToggleSwitch();
-            }
+            if(mousePressed->button == sf::Mouse::Button::Right)
+                input.buttons |= InputCommand::ToggleLight;
         }
         else if(const auto* mouseWheelScrolled = event->getIf<sf::Event::MouseWheelScrolled>()) {
             if(mouseWheelScrolled->wheel == sf::Mouse::Wheel::Vertical) {
@@ -106,34 +205,67 @@ void Game::handleEvents() {
                         static_cast<float>(screenWidth) * zoomLevel,
                         static_cast<float>(screenHeight) * zoomLevel});
                 }
-                else {
-                    auto flashlight = std::dynamic_pointer_cast<FlashLight>(player->GetComponent("flashlight").lock());
-                    if(flashlight && flashlight->GetSwitch()) {
-                        flashlight->AdjustRadius(delta);
-                        flashlight->AdjustWidth(-delta);
-                        flashlight->AdjustAlpha(static_cast<int>(delta));
-                    }
-                }
+                else
+                    input.wheel += delta;
             }
         }
+    }
+}
+
+void Game::update() {
+    input.sequence = ++inputSequence;
+    input.buttons |= Controller::SampleButtons();
+    mousePos = sf::Mouse::getPosition(*window);
+    input.aim = window->mapPixelToCoords(mousePos);
+
+    world->SetCamera(view->getCenter());
+    world->Step(input);
+    emitImpacts();
+    playSounds();
+
+    if(client) {
+        MemoryScope scope(MemoryTag::Network);
+        client->SendInput(input);
+    }
+
+    const std::uint32_t tick = world->GetTick();
+    rollback.RecordInput(tick, input);
+    world->Capture(rollback.Slot(tick));
+
+    input = InputCommand{};
+
+    for(const auto& [id, remote] : remotePlayers)
+        remote->Update(deltaTime);
 
-        if(const auto controller = std::dynamic_pointer_cast<Controller>(
-            player->GetComponent("controller").lock())) {
-            controller->HandleEvents();
+    Particles::Update(deltaTime);
+
+    captureSave();
+
+    if(client) {
+        const net::Snapshot* snapshot = nullptr;
+        {
+            MemoryScope scope(MemoryTag::Network);
+            snapshot = client->Poll();
         }
+
+        if(snapshot) applySnapshot(*snapshot);
     }
 }
 
-void Game::update() {
-    for(const auto& object : objects)
-        object->Update(deltaTime);
+void Game::latchAim() {
+    updateCamera();
+    window->setView(*view);
+
+    if(!lowLatency) return;
 
-    player->Update(deltaTime);
-    
-    handleCollisions();
-    
+    // Presentation only: the simulation already consumed this tick's aim.
+    mousePos = sf::Mouse::getPosition(*window);
+    latchedAim = window->mapPixelToCoords(mousePos);
+}
+
+void Game::updateCamera() {
     const auto playerMovement = std::dynamic_pointer_cast<Movement>(
-        player->GetComponent("movement").lock());
+        world->GetPlayer().GetComponent("movement").lock());
 
     if(playerMovement) {
         if(isFollowingPlayer) {
@@ -147,196 +279,241 @@ void Game::update() {
 
             view->setCenter(camPos);
         }
+    }
+}
+
+void Game::emitImpacts() {
+    for(const Impact& impact : world->GetImpacts()) {
+        Particles::Emit(ParticleKind::Impact, impact.position, impact.direction, IMPACT_PARTICLES);
+        sounds.Play(SoundKind::Impact, impact.position, IMPACT_GAIN);
+    }
+}
 
-        sf::Vector2i mousePos = sf::Mouse::getPosition(*window);
-        sf::Vector2f worldMousePos = window->mapPixelToCoords(mousePos);
-        sf::Vector2f direction = worldMousePos 
-            - (playerMovement->GetPos() + sf::Vector2f(Player::SHAPE_RADIUS, Player::SHAPE_RADIUS));
+void Game::playSounds() {
+    MemoryScope scope(MemoryTag::Audio);
 
-        float angle = std::atan2(direction.y, direction.x) * 180.0f / PI;
-        
-        auto flashlight = std::dynamic_pointer_cast<FlashLight>(player->GetComponent("flashlight").lock());
-        if(flashlight) flashlight->SetAngles(angle);
+    const Player& player = world->GetPlayer();
+    const sf::Vector2f position = player.GetCenter().GetWorldPosition();
+
+    sounds.SetWalls(world->GetMapCollision());
+    sounds.SetListener(position);
+
+    // Ammo only drops when a shot left the barrel.
+    if(const auto gun = std::dynamic_pointer_cast<Gun>(player.GetComponent("gun").lock())) {
+        if(gun->GetAmmo() < lastAmmo)
+            sounds.Play(SoundKind::Gunshot, position, GUNSHOT_GAIN);
+        lastAmmo = gun->GetAmmo();
     }
 
-    window->setView(*view);
+    const sf::Vector2f moved = position - lastStep;
+    const float distance = std::sqrt(moved.x * moved.x + moved.y * moved.y);
+    stride = distance > MAX_STEP ? 0.f : stride + distance;
+    lastStep = position;
+
+    if(stride >= STEP_LENGTH) {
+        stride -= STEP_LENGTH;
+        sounds.Play(SoundKind::Footstep, position, FOOTSTEP_GAIN);
+    }
+
+    // One hum per ghost; most of them stay virtual, far away or behind walls.
+    const GhostCrowd& ghosts = world->GetGhosts();
+    if(ghostSounds.size() != ghosts.GetCount()) {
+        for(const SoundId id : ghostSounds)
+            sounds.Stop(id);
+
+        ghostSounds.clear();
+        for(std::size_t i = 0; i < ghosts.GetCount(); ++i)
+            ghostSounds.push_back(sounds.Loop(SoundKind::Ghost, {ghosts.GetXs()[i], ghosts.GetYs()[i]}, GHOST_GAIN));
+    }
+
+    for(std::size_t i = 0; i < ghostSounds.size(); ++i)
+        sounds.Move(ghostSounds[i], {ghosts.GetXs()[i], ghosts.GetYs()[i]});
+
+    sounds.Update(deltaTime);
 }
 
-void Game::handleCollisions() {
-    auto playerCollision = std::dynamic_pointer_cast<Collision>(player->GetComponent("collision").lock());
-    auto playerMovement = std::dynamic_pointer_cast<Movement>(player->GetComponent("movement").lock());
-    auto gun = std::dynamic_pointer_cast<Gun>(player->GetComponent("gun").lock());
-    auto flashlight = std::dynamic_pointer_cast<FlashLight>(player->GetComponent("flashlight").lock());
-
-    if (!playerCollision || !playerMovement) return;
-
-    for (const auto& object : objects) {
-        auto mapCollision = std::dynamic_pointer_cast<Collision>(object->GetComponent("collision").lock());
-        if (!mapCollision) continue;
-
-        sf::Vector2f currentPos = playerMovement->GetPos();
-        sf::Vector2f playerCenter = currentPos + sf::Vector2f(Player::SHAPE_RADIUS, Player::SHAPE_RADIUS);
-        
-        if (!mapCollision->ContainsPoint(playerCenter)) {
-            sf::Vector2f closestBoundaryPoint = mapCollision->GetClosestPointOnBoundary(playerCenter);
-            sf::Vector2f toPlayer = playerCenter - closestBoundaryPoint;
-            float distanceToPlayer = std::sqrt(toPlayer.x * toPlayer.x + toPlayer.y * toPlayer.y);
-            
-            if (distanceToPlayer > 0.001f) {
-                sf::Vector2f normalToPlayer = toPlayer / distanceToPlayer;
-                
-                sf::Vector2f safePlayerCenter = closestBoundaryPoint + normalToPlayer * (Player::SHAPE_RADIUS + 2.0f);
-                
-                if (!mapCollision->ContainsPoint(safePlayerCenter)) {
-                    sf::Vector2f mapCenter = mapCollision->GetCenter();
-                    sf::Vector2f toMapCenter = mapCenter - closestBoundaryPoint;
-                    float distanceToCenter = std::sqrt(toMapCenter.x * toMapCenter.x + toMapCenter.y * toMapCenter.y);
-                    
-                    if (distanceToCenter > 0.001f) {
-                        sf::Vector2f normalToCenter = toMapCenter / distanceToCenter;
-                        safePlayerCenter = closestBoundaryPoint + normalToCenter * (Player::SHAPE_RADIUS + 5.0f);
-                    }
-                }
-                
-                sf::Vector2f safePlayerPos = safePlayerCenter - sf::Vector2f(Player::SHAPE_RADIUS, Player::SHAPE_RADIUS);
-                
-                playerMovement->SetPos(safePlayerPos);
-                sf::Vector2f currentVelocity = playerMovement->GetVel();
-                sf::Vector2f tangent = sf::Vector2f(-normalToPlayer.y, normalToPlayer.x);
-                float tangentSpeed = currentVelocity.x * tangent.x + currentVelocity.y * tangent.y;
-                sf::Vector2f slideVelocity = tangent * tangentSpeed;
-                playerMovement->SetVel(slideVelocity * 0.8f);
-            }
-        }
-        else {
-            sf::Vector2f velocity = playerMovement->GetVel();
-            sf::Vector2f nextPos = currentPos + velocity * deltaTime;
-            sf::Vector2f nextPlayerCenter = nextPos + sf::Vector2f(Player::SHAPE_RADIUS, Player::SHAPE_RADIUS);
-            
-            if (!mapCollision->ContainsPoint(nextPlayerCenter)) {
-                sf::Vector2f closestBoundaryPoint = mapCollision->GetClosestPointOnBoundary(nextPlayerCenter);
-                sf::Vector2f toBoundary = closestBoundaryPoint - playerCenter;
-                float distanceToBoundary = std::sqrt(toBoundary.x * toBoundary.x + toBoundary.y * toBoundary.y);
-                
-                if (distanceToBoundary > 0.001f) {
-                    sf::Vector2f normalToBoundary = toBoundary / distanceToBoundary;
-                    
-                    float velocityAlongNormal = velocity.x * normalToBoundary.x + velocity.y * normalToBoundary.y;
-                    if (velocityAlongNormal < 0) {
-                        velocity = velocity - normalToBoundary * velocityAlongNormal;
-                        playerMovement->SetVel(velocity);
-                    }
-                    
-                    float minDistance = Player::SHAPE_RADIUS + 1.0f;
-                    if (distanceToBoundary < minDistance) {
-                        sf::Vector2f pushVector = normalToBoundary * (minDistance - distanceToBoundary);
-                        sf::Vector2f adjustedCenter = playerCenter + pushVector;
-                        sf::Vector2f adjustedPos = adjustedCenter - sf::Vector2f(Player::SHAPE_RADIUS, Player::SHAPE_RADIUS);
-                        playerMovement->SetPos(adjustedPos);
-                    }
-                }
-            }
-        }
+void Game::reportMemoryStats() {
+    for(std::size_t i = 0; i < MEMORY_TAG_COUNT; ++i) {
+        const MemoryTag tag = static_cast<MemoryTag>(i);
+        const MemoryTagStats stats = GetMemoryStats(tag);
 
-        if (gun) {
-            const auto& bullets = gun->GetBullets();
-            for (size_t i = 0; i < bullets.size(); ++i) {
-                if (!bullets[i].active) continue;
+        EventLog::Emit(Event::MemoryStats, static_cast<std::uint32_t>(tag),
+            static_cast<float>(stats.liveBytes) / 1024.f, static_cast<float>(stats.peakBytes) / 1024.f,
+            static_cast<std::uint32_t>(stats.frameAllocations));
+    }
 
-                sf::Vector2f bulletCenter = bullets[i].position + sf::Vector2f(Gun::BULLET_RADIUS, Gun::BULLET_RADIUS);
-                
-                if (!mapCollision->ContainsPoint(bulletCenter)) {
-                    gun->DeactivateBullet(i);
-                }
-            }
-        }
+    const HeapStats heap = GetHeapStats();
+    EventLog::Emit(Event::HeapStats, static_cast<float>(heap.liveBytes) / 1024.f,
+        static_cast<float>(heap.peakBytes) / 1024.f, static_cast<std::uint32_t>(heap.liveBlocks));
+}
 
-        if (flashlight && flashlight->GetSwitch())
-            checkFlashlightMapCollision(flashlight.get(), mapCollision.get(), playerMovement->GetPos());
+void Game::captureSave() {
+    const std::uint32_t tick = world->GetTick();
+    const Map& map = world->GetMap();
+    if(!autosave.IsRunning() || tick < nextAutosaveTick || !map.GetWalls()) return;
+
+    // While the previous save is still being written, try again next tick.
+    if(autosave.Capture(rollback.Slot(tick), map.GetSize(), *map.GetWalls(), world->GetFog()))
+        nextAutosaveTick = tick + AUTOSAVE_TICKS;
+}
+
+bool Game::restoreSave(const SaveGame& save) {
+    auto restored = std::make_unique<World>(worldConfig(save.world.mapSeed, save.mapSize));
+
+    if(!restored->Restore(save)) {
+        std::cerr << "[autosave] the save does not match its map, starting a new game" << std::endl;
+        return false;
     }
+
+    world = std::move(restored);
+    return true;
+}
+
+void Game::reportFrameStats() {
+    const FrameStats stats = pacer.GetStats();
+    EventLog::Emit(Event::FrameStats, stats.meanMs, stats.p99Ms, stats.jitterMs,
+        static_cast<std::uint32_t>(stats.missed));
 }
 
-void Game::checkFlashlightMapCollision(FlashLight* flashlight, Collision* mapCollision, const sf::Vector2f& playerPos) {
-    sf::Vector2f flashlightCenter = playerPos + sf::Vector2f(Player::SHAPE_RADIUS, Player::SHAPE_RADIUS);
-    
-    if (mapCollision->ContainsPoint(flashlightCenter)) {
-        // ÷öƮ  ο   ۵
-        //  ray casting  ÷öƮ      
-        // Ͽ  ִ Ÿ   
+void Game::verifyRollback(const std::uint32_t ticks) {
+    using Clock = std::chrono::steady_clock;
+
+    const std::uint32_t tick = world->GetTick();
+    const std::uint32_t target = tick - ticks;
+    const WorldState* from = rollback.Find(target);
+    if(ticks >= RollbackBuffer::CAPACITY || !from) return;
+
+    WorldState before;
+    const auto saveStart = Clock::now();
+    world->Capture(before);
+
+    const auto restoreStart = Clock::now();
+    if(!world->Restore(*from)) {
+        std::cout << "[rollback] walls carved too often since tick " << target << " to rewind" << std::endl;
+        return;
     }
-    else {
-        // ÷öƮ  ܺο  (̷δ ߻ ʾƾ )
-        // ÷̾ ̹  ܺη  ̹Ƿ ÷öƮ  ۵
+
+    // Replayed impacts already produced their particles. The walls were rewound, so they carve again.
+    Particles::SetEmitting(false);
+
+    const auto resimStart = Clock::now();
+    for(std::uint32_t t = target + 1; t <= tick; ++t) {
+        world->Simulate(rollback.GetInput(t));
+        CaptureWorld(world->GetPlayer(), &world->GetMap(), t, rollback.Slot(t));
     }
+    const auto end = Clock::now();
+
+    Particles::SetEmitting(true);
+
+    auto micros = [](const Clock::duration duration) {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    };
+
+    std::cout << "[rollback] " << ticks << " ticks: save " << micros(restoreStart - saveStart)
+        << " us, restore " << micros(resimStart - restoreStart)
+        << " us, resimulate " << micros(end - resimStart)
+        << " us, " << (SameWorld(before, rollback.Slot(tick)) ? "deterministic" : "DIVERGED") << std::endl;
 }
 
-void Game::render() {
-    for(const auto& object : objects) {
-        if(auto render = std::dynamic_pointer_cast<Render>(
-            object->GetComponent("render").lock())) {
-            render->Draw(*window);
+void Game::applySnapshot(const net::Snapshot& snapshot) {
+    for(const auto& state : snapshot.players) {
+        if(state.id == client->GetPlayerId()) {
+            reconcile(state);
+            continue;
         }
+
+        auto& remote = remotePlayers[state.id];
+        if(!remote) remote = std::make_unique<Player>(state.movement.pos.x, state.movement.pos.y);
+
+        auto movement = std::dynamic_pointer_cast<Movement>(remote->GetComponent("movement").lock());
+        auto flashlight = std::dynamic_pointer_cast<FlashLight>(remote->GetComponent("flashlight").lock());
+        auto gun = std::dynamic_pointer_cast<Gun>(remote->GetComponent("gun").lock());
+
+        if(movement) movement->SetState(state.movement);
+        if(flashlight) flashlight->SetState(state.flashlight);
+        if(gun) gun->SetAmmo(state.ammo);
     }
 
-    std::dynamic_pointer_cast<Render>(
-        player->GetComponent("render").lock())->Draw(*window);
+    for(auto iter = remotePlayers.begin(); iter != remotePlayers.end();) {
+        const bool present = std::any_of(snapshot.players.begin(), snapshot.players.end(),
+            [id = iter->first](const net::PlayerState& state) { return state.id == id; });
 
-    auto flashlight = std::dynamic_pointer_cast<FlashLight>(player->GetComponent("flashlight").lock());
-    if(flashlight && flashlight->GetSwitch()) {
-        flashlight->Render(*window);
+        if(present) {
+            ++iter;
+            continue;
+        }
+
+        Particles::Emit(ParticleKind::Ghost, iter->second->GetCenter().GetWorldPosition(), {0.f, -1.f}, GHOST_PARTICLES);
+        iter = remotePlayers.erase(iter);
     }
 
-    auto gun = std::dynamic_pointer_cast<Gun>(player->GetComponent("gun").lock());
-    if(gun) {
-        if(gun->HasActiveBullets())
-            gun->Render(*window);
+    // Remote bullets are rebuilt from their trajectories; our own stay client-predicted.
+    for(const auto& [id, remote] : remotePlayers) {
+        auto gun = std::dynamic_pointer_cast<Gun>(remote->GetComponent("gun").lock());
+        if(!gun) continue;
+
+        remoteBullets.clear();
+        for(const auto& bullet : snapshot.bullets) {
+            if(bullet.GetOwner() != id) continue;
 
-        mouseCursorRender(gun.get());
+            const float age = static_cast<float>(snapshot.tick - bullet.spawnTick) * net::TICK_TIME;
+            if(age >= Gun::BULLET_LIFETIME) continue;
+
+            Gun::Bullet restored(bullet.origin + bullet.direction * Gun::BULLET_SPEED * age, bullet.direction, bullet.GetSerial());
+            restored.lifetime -= age;
+            remoteBullets.push_back(restored);
+        }
+
+        gun->SetBullets(remoteBullets);
     }
 }
 
-void Game::mouseCursorRender(Gun * gun) {
-    sf::Vector2i mousePos = sf::Mouse::getPosition(*window);
-    sf::Vector2f screenMousePos = static_cast<sf::Vector2f>(mousePos);
+void Game::reconcile(const net::PlayerState& state) {
+    Player& player = world->GetPlayer();
 
-    const float GAUGE_RADIUS = 20.f;
-    const float GAUGE_THICKNESS = 4.f;
-    const int POINT_COUNT = 60;
+    auto movement = std::dynamic_pointer_cast<Movement>(player.GetComponent("movement").lock());
+    auto flashlight = std::dynamic_pointer_cast<FlashLight>(player.GetComponent("flashlight").lock());
+    auto gun = std::dynamic_pointer_cast<Gun>(player.GetComponent("gun").lock());
 
-    int currentAmmo = gun->GetAmmo();
-    float ammoRatio = static_cast<float>(currentAmmo) / Gun::MAX_AMMO;
+    if(!movement) return;
 
-    sf::VertexArray gauge(sf::PrimitiveType::TriangleStrip, (static_cast<std::size_t>(POINT_COUNT * ammoRatio) + 1) * 2);
+    movement->SetState(state.movement);
+    if(flashlight) flashlight->SetState(state.flashlight);
+    if(gun) gun->SetAmmo(state.ammo);
 
-    sf::Color gaugeColor = sf::Color(
-        static_cast<std::uint8_t>(255 * (1.0f - ammoRatio)),
-        static_cast<std::uint8_t>(255 * ammoRatio),
-        0,
-        200
-    );
+    // Replay everything the server has not seen yet on top of its authoritative state.
+    for(const auto& pending : client->GetPendingInputs()) {
+        ApplyInput(player, pending, true);
+        movement->Update(deltaTime);
+        ResolveMapCollision(*movement, world->GetMap().GetDistanceField(), deltaTime);
+    }
+}
 
-    for(int i = 0; i <= POINT_COUNT * ammoRatio; ++i) {
-        float angle = (static_cast<float>(i) / POINT_COUNT) * 2.0f * PI - PI / 2.0f;
+void Game::render() {
+    if(auto render = std::dynamic_pointer_cast<Render>(world->GetMap().GetComponent("render").lock()))
+        render->Draw(*window);
 
-        sf::Vector2f outerPoint(
-            screenMousePos.x + std::cos(angle) * (GAUGE_RADIUS + GAUGE_THICKNESS / 2.0f),
-            screenMousePos.y + std::sin(angle) * (GAUGE_RADIUS + GAUGE_THICKNESS / 2.0f)
-        );
+    world->GetFog().Draw(*window);
+    Particles::Draw(*window);
+    world->GetGhosts().Draw(*window);
 
-        sf::Vector2f innerPoint(
-            screenMousePos.x + std::cos(angle) * (GAUGE_RADIUS - GAUGE_THICKNESS / 2.0f),
-            screenMousePos.y + std::sin(angle) * (GAUGE_RADIUS - GAUGE_THICKNESS / 2.0f)
-        );
+    for(const auto& [id, remote] : remotePlayers)
+        remote->Draw(*window);
 
-        gauge[static_cast<size_t>(i) * 2].position = outerPoint;
-        gauge[static_cast<size_t>(i) * 2].color = gaugeColor;
-        gauge[static_cast<size_t>(i) * 2 + 1].position = innerPoint;
-        gauge[static_cast<size_t>(i) * 2 + 1].color = gaugeColor;
-    }
+    Player& player = world->GetPlayer();
+    player.Draw(*window, latchedAim);
+
+    auto gun = std::dynamic_pointer_cast<Gun>(player.GetComponent("gun").lock());
+    renderHud(gun.get());
+}
+
+void Game::renderHud(Gun* gun) {
+    // The ammo ring is the mouse cursor; it only follows the mouse unless the ammo changed.
+    ammoGauge->SetVisible(gun != nullptr);
+    ammoGauge->SetPosition(static_cast<sf::Vector2f>(mousePos));
+    if(gun) ammoGauge->Bind(gun->GetAmmo());
+
+    zoomGauge->Bind((zoomLevel - MIN_ZOOM) / (MAX_ZOOM - MIN_ZOOM));
 
-    sf::View originalView = window->getView();
-    window->setView(window->getDefaultView());
-    
-    window->draw(gauge);
-    window->setView(originalView);
+    hud.Draw(*window);
 }
\ No newline at end of file
@@ -3,8 +3,11 @@
 #include <SFML/Graphics.hpp>
 
 #include <cstdint>
+#include <filesystem>
 #include <string>
 #include <memory>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include "Object.hpp"
@@ -12,6 +15,15 @@
 #include "Collision.hpp"
 #include "Gun.hpp"
 #include "FlashLight.hpp"
+#include "PlayerInput.hpp"
+#include "Client.hpp"
+#include "Rollback.hpp"
+#include "FramePacer.hpp"
+#include "Hud.hpp"
+#include "MemoryStats.hpp"
+#include "Autosave.hpp"
+#include "World.hpp"
+#include "SoundScene.hpp"
 
 namespace core {
     class Game {
@@ -30,16 +42,42 @@ namespace core {
         void Run();
         void Clear();
 
+        // Switches to networked play against an authoritative server; the map comes from the server.
+        bool Connect(const std::string& host, const unsigned short port);
+
+        // Paces frames with FramePacer instead of the window's framerate limit, and re-samples
+        // the mouse just before rendering for the cursor and flashlight cone. The camera follows
+        // the player, not the aim, so it does not use the late sample.
+        void SetLowLatency(const bool enabled);
+
+        // Offline only: resumes from the save in `directory` if there is one, then saves into it
+        // every AUTOSAVE_TICKS ticks and once more on Clear().
+        bool EnableAutosave(const std::filesystem::path& directory);
+
     private:
-        std::vector<std::unique_ptr<Object>> objects;
+        std::unique_ptr<World> world{nullptr};
+        std::unordered_map<std::uint16_t, std::unique_ptr<Player>> remotePlayers;
 
-        std::unique_ptr<Player> player{nullptr};
+        std::unique_ptr<net::Client> client{nullptr};
+        InputCommand input;
+        std::uint32_t inputSequence = 0;
+        std::vector<Gun::Bullet> remoteBullets;
+
+        RollbackBuffer rollback;
 
         std::unique_ptr<sf::RenderWindow> window{nullptr};
         std::unique_ptr<sf::View> view{nullptr};
 
         sf::Vector2f camPos{0.f, 0.f};
 
+        FramePacer pacer;
+        std::uint32_t frameCount = 0;
+        bool lowLatency = false;
+
+        // One mouse sample per frame, shared by aim and cursor; replaced late in low-latency mode.
+        sf::Vector2i mousePos{0, 0};
+        std::optional<sf::Vector2f> latchedAim;
+
         std::string windowTitle;
 
         std::uint16_t screenWidth;
@@ -50,12 +88,36 @@ namespace core {
 
         bool isFollowingPlayer = false;
 
+        HudLayer hud;
+        AmmoGauge* ammoGauge = nullptr;
+        ZoomGauge* zoomGauge = nullptr;
+
+        Autosave autosave;
+        std::uint32_t nextAutosaveTick = 0;
+
+        AudioMixer mixer;
+        SoundScene sounds{&mixer};
+        std::vector<SoundId> ghostSounds;
+        sf::Vector2f lastStep{0.f, 0.f};
+        float stride = 0.f;
+        int lastAmmo = Gun::MAX_AMMO;
+
         void handleEvents();
         void update();
+        void latchAim();
+        void updateCamera();
+        void emitImpacts();
+        void playSounds();
+        void reportFrameStats();
+        void reportMemoryStats();
+        void captureSave();
+        bool restoreSave(const SaveGame& save);
         void render();
-        void mouseCursorRender(Gun* gun);
+        void renderHud(Gun* gun);
         
-        void handleCollisions();
-        void checkFlashlightMapCollision(FlashLight* flashlight, Collision* mapCollision, const sf::Vector2f& playerPos);
+        void verifyRollback(const std::uint32_t ticks);
+
+        void applySnapshot(const net::Snapshot& snapshot);
+        void reconcile(const net::PlayerState& state);
     };
 }
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include "GhostCrowd.hpp"
+#include "Collision.hpp"
+#include "RenderStats.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+using namespace core;
+
+constexpr float PI = 3.141592f;
+constexpr std::size_t GHOST_SIDES = 6;
+constexpr std::size_t SPAWN_ATTEMPTS = 64;
+
+const sf::Color GHOST_COLOR = sf::Color{200, 230, 255, 170};
+
+void GhostCrowd::Populate(const Collision& walls, const std::size_t count) {
+    Clear();
+
+    const sf::FloatRect bounds = walls.GetBounds();
+    std::uniform_real_distribution<float> xDist(bounds.position.x, bounds.position.x + bounds.size.x);
+    std::uniform_real_distribution<float> yDist(bounds.position.y, bounds.position.y + bounds.size.y);
+
+    for(std::size_t i = 0; i < count; ++i) {
+        sf::Vector2f spawn = walls.GetCenter();
+        for(std::size_t attempt = 0; attempt < SPAWN_ATTEMPTS; ++attempt) {
+            const sf::Vector2f candidate{xDist(gen), yDist(gen)};
+            if(walls.ContainsPoint(candidate)) {
+                spawn = candidate;
+                break;
+            }
+        }
+
+        xs.push_back(spawn.x);
+        ys.push_back(spawn.y);
+        homes.push_back(spawn);
+    }
+
+    litTriggers = std::vector<Trigger>(count);
+    wakeTriggers = std::vector<Trigger>(count);
+    motions.resize(count);
+    moving.assign(count, 0);
+    lod.Reset(count);
+
+    // Ticking and lighting the crowd must not touch the heap once it is populated.
+    for(Trigger& trigger : litTriggers)
+        trigger.Reserve(1);
+    for(Trigger& trigger : wakeTriggers)
+        trigger.Reserve(1);
+
+    visible.reserve(count);
+    scheduler.Reserve(count);
+
+    for(std::uint32_t id = 0; id < count; ++id)
+        scheduler.Spawn(haunt(id));
+}
+
+void GhostCrowd::Clear() {
+    scheduler.Clear();
+
+    xs.clear();
+    ys.clear();
+    homes.clear();
+    litTriggers.clear();
+    wakeTriggers.clear();
+    motions.clear();
+    moving.clear();
+    lod.Reset(0);
+    visible.clear();
+}
+
+void GhostCrowd::Update(const float deltaTime) {
+    visible.clear();
+
+    lod.ClearFocus();
+    if(hasCamera) lod.AddFocus(camera);
+    if(prey) lod.AddFocus(prey->GetWorldPosition());
+
+    lod.Rebalance(xs.data(), ys.data(), xs.size() / LOD_REBALANCE_TICKS + 1);
+    for(const std::uint32_t id : lod.GetWoken())
+        wakeTriggers[id].Fire();
+
+    scheduler.Tick(deltaTime);
+    advance(deltaTime);
+}
+
+void GhostCrowd::Light(const std::vector<std::uint32_t>& lit, const sf::Vector2f& source) {
+    lightSource = source;
+
+    for(const std::uint32_t id : lit) {
+        visible.push_back(id);
+        litTriggers[id].Fire();
+    }
+}
+
+void GhostCrowd::Draw(sf::RenderTarget& target) {
+    if(visible.empty()) return;
+
+    std::array<sf::Vector2f, GHOST_SIDES> rim;
+    for(std::size_t side = 0; side < GHOST_SIDES; ++side) {
+        const float rad = 2.f * PI * static_cast<float>(side) / GHOST_SIDES;
+        rim[side] = DRAW_RADIUS * sf::Vector2f{std::cos(rad), std::sin(rad)};
+    }
+
+    stream.resize(visible.size() * GHOST_SIDES * 3);
+
+    sf::Vertex* out = stream.data();
+    for(const std::uint32_t id : visible) {
+        const sf::Vector2f center = position(id);
+
+        for(std::size_t side = 0; side < GHOST_SIDES; ++side) {
+            *out++ = sf::Vertex{center, GHOST_COLOR};
+            *out++ = sf::Vertex{center + rim[side], GHOST_COLOR};
+            *out++ = sf::Vertex{center + rim[(side + 1) % GHOST_SIDES], GHOST_COLOR};
+        }
+    }
+
+    target.draw(stream.data(), stream.size(), sf::PrimitiveType::Triangles);
+    CountDraw(stream.size());
+}
+
+Behavior GhostCrowd::haunt(const std::uint32_t id) {
+    bool lit = false;
+
+    for(;;) {
+        // Out of the loaded cells the ghost waits where it is until the LOD brings it back.
+        if(lod.GetTier(id) == LodTier::Suspended)
+            co_await WaitUntil(wakeTriggers[id]);
+
+        if(lit) {
+            // Flee straight away from the light, then lie low before haunting again.
+            sf::Vector2f away = position(id) - lightSource;
+            const float length = std::sqrt(away.x * away.x + away.y * away.y);
+            away = length > 0.f ? away / length : sf::Vector2f{1.f, 0.f};
+
+            co_await moveTo(id, position(id) + away * FLEE_DISTANCE, FLEE_SPEED, false);
+            co_await Wait(random(MIN_IDLE, MAX_IDLE));
+
+            lit = false;
+            continue;
+        }
+
+        if(prey) {
+            const sf::Vector2f toPrey = prey->GetWorldPosition() - position(id);
+            const float distance = std::sqrt(toPrey.x * toPrey.x + toPrey.y * toPrey.y);
+
+            // Short hops so the ghost re-aims at a moving target; once close it hovers.
+            if(distance < STALK_RADIUS) {
+                if(distance > STALK_STEP) {
+                    const sf::Vector2f step = toPrey / distance * std::min(STALK_STEP, distance - STALK_STEP * 0.5f);
+                    lit = co_await moveTo(id, position(id) + step, STALK_SPEED, true);
+                }
+                else
+                    lit = co_await WaitUntil(litTriggers[id], random(MIN_IDLE, MAX_IDLE));
+
+                continue;
+            }
+        }
+
+        const float rad = random(0.f, 2.f * PI);
+        const float reach = WANDER_RADIUS * std::sqrt(random(0.f, 1.f));
+        lit = co_await moveTo(id, homes[id] + reach * sf::Vector2f{std::cos(rad), std::sin(rad)}, WANDER_SPEED, true);
+
+        if(!lit)
+            lit = co_await WaitUntil(litTriggers[id], random(MIN_IDLE, MAX_IDLE));
+    }
+}
+
+GhostCrowd::MoveAwaiter GhostCrowd::moveTo(const std::uint32_t id, const sf::Vector2f& target, const float speed,
+                                           const bool interruptible) {
+    const sf::Vector2f from = position(id);
+    const sf::Vector2f to = walls ? walls->PushOut(target, DRAW_RADIUS) : target;
+    const sf::Vector2f delta = to - from;
+    const float duration = std::sqrt(delta.x * delta.x + delta.y * delta.y) / speed;
+
+    const double now = scheduler.GetTime();
+    motions[id] = Motion{from, to, now, now + duration};
+
+    if(!moving[id]) {
+        moving[id] = 1;
+        lod.SetActive(id, true);
+    }
+
+    return MoveAwaiter{*this, id, WaitAwaiter{duration, interruptible ? &litTriggers[id] : nullptr, {}}};
+}
+
+bool GhostCrowd::MoveAwaiter::await_resume() {
+    const bool lit = wait.await_resume();
+
+    // The behavior resumes on the scheduler's full-rate timer, but a ghost in a slower tier may
+    // not have been placed since its last due tick. Settle it before the next hop starts from it.
+    crowd.place(id, crowd.scheduler.GetTime());
+    crowd.stop(id);
+
+    return lit;
+}
+
+void GhostCrowd::advance(const float deltaTime) {
+    const double now = scheduler.GetTime();
+
+    // Only moving ghosts are active in the LOD. Motions are timed on the scheduler clock, so a
+    // ghost due every Nth tick follows the same path in coarser steps, and is put at its
+    // destination when its behavior resumes.
+    lod.Tick(deltaTime, [this, now](const std::uint32_t id, float) {
+        if(place(id, now)) stop(id);
+    });
+}
+
+bool GhostCrowd::place(const std::uint32_t id, const double now) {
+    const Motion& motion = motions[id];
+
+    const double span = motion.end - motion.start;
+    const float t = span > 0.0 ? static_cast<float>(std::clamp((now - motion.start) / span, 0.0, 1.0)) : 1.f;
+
+    xs[id] = motion.from.x + (motion.to.x - motion.from.x) * t;
+    ys[id] = motion.from.y + (motion.to.y - motion.from.y) * t;
+
+    return t >= 1.f;
+}
+
+void GhostCrowd::stop(const std::uint32_t id) {
+    if(!moving[id]) return;
+
+    moving[id] = 0;
+    lod.SetActive(id, false);
+}
+
+float GhostCrowd::random(const float min, const float max) {
+    return std::uniform_real_distribution<float>(min, max)(gen);
+}
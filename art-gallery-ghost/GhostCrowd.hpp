@@ -0,0 +1,123 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include "Behavior.hpp"
+#include "Transform.hpp"
+#include "DistanceField.hpp"
+#include "SimulationLod.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+class Collision;
+
+namespace core {
+    // Ghosts are scripted with Behavior coroutines rather than Components: a ghost that idles or
+    // glides toward a point is not touched again until its timer runs out or a flashlight hits it.
+    // Positions are kept as SoA arrays so they can feed EntityGrid directly. Ghosts far from the
+    // camera and the prey glide in coarser steps, and ghosts outside the loaded cells lie dormant.
+    class GhostCrowd {
+    public:
+        constexpr static float WANDER_RADIUS = 400.f;
+        constexpr static float WANDER_SPEED = 60.f;
+        constexpr static float STALK_RADIUS = 700.f;
+        constexpr static float STALK_STEP = 150.f;
+        constexpr static float STALK_SPEED = 140.f;
+        constexpr static float FLEE_DISTANCE = 500.f;
+        constexpr static float FLEE_SPEED = 400.f;
+        constexpr static float MIN_IDLE = 1.f;
+        constexpr static float MAX_IDLE = 4.f;
+        constexpr static float DRAW_RADIUS = 24.f;
+
+        // Every ghost's LOD tier is re-evaluated at least this often.
+        constexpr static std::size_t LOD_REBALANCE_TICKS = 16;
+
+        explicit GhostCrowd(const std::uint32_t seed = std::random_device{}()) : gen(seed) {}
+
+        // Replaces the crowd with `count` ghosts haunting random spots inside `walls`.
+        void Populate(const Collision& walls, const std::size_t count);
+        void Clear();
+
+        // Move targets are kept DRAW_RADIUS clear of the walls.
+        void SetWalls(const DistanceField* walls) { this->walls = walls; }
+
+        // Ghosts close to the prey stalk it; without one every ghost wanders.
+        void SetPrey(const Transform* prey) { this->prey = prey; }
+
+        // LOD focus besides the prey. Without camera or prey every ghost updates at full rate.
+        void SetCamera(const sf::Vector2f& center) {
+            camera = center;
+            hasCamera = true;
+        }
+
+        void Update(const float deltaTime);
+
+        // Ghost ids from a cone query. Lit ghosts are drawn this frame and flee from `source`.
+        void Light(const std::vector<std::uint32_t>& lit, const sf::Vector2f& source);
+
+        // Only ghosts lit since the last Update are visible; they go out in one draw call.
+        void Draw(sf::RenderTarget& target);
+
+        std::size_t GetCount() const { return xs.size(); }
+        const float* GetXs() const { return xs.data(); }
+        const float* GetYs() const { return ys.data(); }
+        const BehaviorScheduler& GetScheduler() const { return scheduler; }
+        const SimulationLod& GetLod() const { return lod; }
+
+    private:
+        struct Motion {
+            sf::Vector2f from;
+            sf::Vector2f to;
+            double start = 0.0;
+            double end = 0.0;
+        };
+
+        // Resumes with true when the ghost was lit on the way; it then stops where it is.
+        struct MoveAwaiter {
+            GhostCrowd& crowd;
+            std::uint32_t id;
+            WaitAwaiter wait;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(const Behavior::Handle handle) { wait.await_suspend(handle); }
+            bool await_resume();
+        };
+
+        std::vector<float> xs;
+        std::vector<float> ys;
+        std::vector<sf::Vector2f> homes;
+        std::vector<Trigger> litTriggers;
+        std::vector<Trigger> wakeTriggers;
+
+        std::vector<Motion> motions;
+        std::vector<std::uint8_t> moving;
+
+        SimulationLod lod;
+        sf::Vector2f camera;
+        bool hasCamera = false;
+
+        std::vector<std::uint32_t> visible;
+        sf::Vector2f lightSource;
+        std::vector<sf::Vertex> stream;
+
+        const Transform* prey = nullptr;
+        const DistanceField* walls = nullptr;
+        std::mt19937 gen;
+
+        // Declared last so coroutine frames go before the triggers and state they refer to.
+        BehaviorScheduler scheduler;
+
+        Behavior haunt(const std::uint32_t id);
+
+        MoveAwaiter moveTo(const std::uint32_t id, const sf::Vector2f& target, const float speed, const bool interruptible);
+        void stop(const std::uint32_t id);
+        void advance(const float deltaTime);
+        // Puts a moving ghost where its motion has it at `now`; true once it arrived.
+        bool place(const std::uint32_t id, const double now);
+
+        sf::Vector2f position(const std::uint32_t id) const { return {xs[id], ys[id]}; }
+        float random(const float min, const float max);
+    };
+}
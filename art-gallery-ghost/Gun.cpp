@@ -1,9 +1,10 @@
 #include "Gun.hpp"
-#include "Movement.hpp"
 #include "Object.hpp"
-#include "Player.hpp"
+#include "Tessellation.hpp"
+#include "EventLog.hpp"
+#include "Particles.hpp"
+#include "RenderStats.hpp"
 
-#include <iostream>
 #include <cmath>
 #include <algorithm>
 
@@ -27,36 +28,44 @@ void Gun::Update(const float deltaTime) {
         bullets.end());
 }
 
-void Gun::Fire(const sf::Vector2f& target) {
+bool Gun::Fire(const sf::Vector2f& target) {
+    if(bullets.size() >= MAX_BULLETS) return false;
+
+    const sf::Vector2f muzzle = getMuzzle();
+
     if(currAmmo <= 0) {
-        std::cout << "OUT OF AMMO!" << std::endl;
-        return;
+        EventLog::Emit(Event::OutOfAmmo, muzzle.x, muzzle.y);
+        return false;
     }
 
     --currAmmo;
 
-    auto movement = std::dynamic_pointer_cast<Movement>(owner->GetComponent("movement").lock());
-    if(!movement) return;
-
-    sf::Vector2f playerPos = movement->GetPos() + sf::Vector2f(Player::SHAPE_RADIUS, Player::SHAPE_RADIUS);
-    sf::Vector2f direction = target - playerPos;
+    sf::Vector2f direction = target - muzzle;
     
     float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
     if(length > 0) {
         direction = direction / length;
     }
 
-    bullets.emplace_back(playerPos, direction);
+    bullets.emplace_back(muzzle, direction, nextSerial++);
+    Particles::Emit(ParticleKind::MuzzleFlash, muzzle, direction, MUZZLE_PARTICLES);
+    return true;
 }
 
-void Gun::Render(sf::RenderWindow& window) const {
-    sf::CircleShape bulletShape(BULLET_RADIUS);
+sf::Vector2f Gun::getMuzzle() const {
+    return mount ? mount->GetWorldPosition() : owner->GetTransform().GetWorldPosition();
+}
+
+void Gun::Render(sf::RenderTarget& target) const {
+    bulletShape.setRadius(BULLET_RADIUS);
     bulletShape.setFillColor(BULLET_COLOR);
+    FitCircle(bulletShape, target);
 
     for(const auto& bullet : bullets) {
         if(bullet.active) {
             bulletShape.setPosition(bullet.position);
-            window.draw(bulletShape);
+            target.draw(bulletShape);
+            CountShape(bulletShape);
         }
     }
 }
@@ -64,4 +73,21 @@ void Gun::Render(sf::RenderWindow& window) const {
 bool Gun::HasActiveBullets() const {
     return std::any_of(bullets.begin(), bullets.end(),
         [](const Bullet& b) { return b.active; });
+}
+
+void Gun::SetBullets(const std::vector<Bullet>& other) {
+    bullets.assign(other.begin(), other.begin() + std::min(other.size(), MAX_BULLETS));
+}
+
+void Gun::GetState(State& state) const {
+    state.ammo = currAmmo;
+    state.nextSerial = nextSerial;
+    state.bulletCount = static_cast<std::uint32_t>(bullets.size());
+    std::copy(bullets.begin(), bullets.end(), state.bullets.begin());
+}
+
+void Gun::SetState(const State& state) {
+    SetAmmo(state.ammo);
+    nextSerial = state.nextSerial;
+    bullets.assign(state.bullets.begin(), state.bullets.begin() + std::min<std::size_t>(state.bulletCount, MAX_BULLETS));
 }
\ No newline at end of file
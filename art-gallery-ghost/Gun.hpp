@@ -2,7 +2,11 @@
 
 #include <SFML/Graphics.hpp>
 #include "Component.hpp"
+#include "Transform.hpp"
+#include <array>
 #include <vector>
+#include <algorithm>
+#include <cstdint>
 
 class Gun : public core::Component {
 public:
@@ -11,30 +15,51 @@ public:
     constexpr static float BULLET_SPEED = 3000.f;
     constexpr static int MAX_AMMO = 10;
     constexpr static float BULLET_LIFETIME = 3.0f;
+    constexpr static std::size_t MAX_BULLETS = 64;
+    constexpr static std::size_t MUZZLE_PARTICLES = 12;
 
     struct Bullet {
         sf::Vector2f position;
         sf::Vector2f direction;
-        float lifetime;
-        bool active;
+        float lifetime = 0.f;
+        bool active = false;
+        std::uint32_t serial = 0;
 
-        Bullet(sf::Vector2f pos, sf::Vector2f dir)
-            : position(pos), direction(dir), lifetime(BULLET_LIFETIME), active(true) {}
+        Bullet() = default;
+        Bullet(sf::Vector2f pos, sf::Vector2f dir, std::uint32_t serial = 0)
+            : position(pos), direction(dir), lifetime(BULLET_LIFETIME), active(true), serial(serial) {}
     };
 
-    Gun(core::Object* obj) : core::Component(obj) {}
+    struct State {
+        int ammo;
+        std::uint32_t nextSerial;
+        std::uint32_t bulletCount;
+        std::array<Bullet, MAX_BULLETS> bullets;
+    };
+
+    Gun(core::Object* obj) : core::Component(obj) {
+        bullets.reserve(MAX_BULLETS);
+    }
 
     void Update(const float deltaTime) override;
     std::string_view GetTag() const override { return tag; }
 
-    void Fire(const sf::Vector2f& target);
-    void Render(sf::RenderWindow& window) const;
+    // Bullets leave from the mount's world position, or from the owner's origin without one.
+    void Mount(const core::Transform* mount) { this->mount = mount; }
+
+    bool Fire(const sf::Vector2f& target);
+    void Render(sf::RenderTarget& target) const;
 
     bool HasActiveBullets() const;
     int GetAmmo() const { return currAmmo; }
+    void SetAmmo(const int ammo) { currAmmo = std::max(0, std::min(ammo, MAX_AMMO)); }
     void Reload() { currAmmo = MAX_AMMO; }
 
     const std::vector<Bullet>& GetBullets() const { return bullets; }
+    void SetBullets(const std::vector<Bullet>& other);
+
+    void GetState(State& state) const;
+    void SetState(const State& state);
 
     void DeactivateBullet(size_t index) {
         if(index < bullets.size()) bullets[index].active = false;
@@ -45,4 +70,11 @@ private:
 
     std::vector<Bullet> bullets;
     int currAmmo = MAX_AMMO;
+    std::uint32_t nextSerial = 0;
+    const core::Transform* mount = nullptr;
+
+    // Kept between frames so drawing the bullets reuses the shape's vertex storage.
+    mutable sf::CircleShape bulletShape;
+
+    sf::Vector2f getMuzzle() const;
 };
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include "Hud.hpp"
+#include "Gun.hpp"
+#include "Tessellation.hpp"
+#include "RenderStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace core;
+
+constexpr float PI = 3.141592f;
+
+const sf::Color ZOOM_TRACK_COLOR = sf::Color{255, 255, 255, 60};
+const sf::Color ZOOM_FILL_COLOR = sf::Color{255, 255, 255, 200};
+
+namespace {
+    // Unit directions around the gauge, clockwise from the top; the last one closes the ring.
+    const std::vector<sf::Vector2f>& gaugeDirections() {
+        static const std::vector<sf::Vector2f> directions = [] {
+            // The gauge is drawn in screen space, so its outer edge radius is already in pixels.
+            const std::size_t pointCount = ArcSegments(AMMO_GAUGE_RADIUS + AMMO_GAUGE_THICKNESS / 2.0f, 2.0f * PI, MIN_CIRCLE_SEGMENTS);
+
+            std::vector<sf::Vector2f> result(pointCount + 1);
+            for(std::size_t i = 0; i <= pointCount; ++i) {
+                const float angle = (static_cast<float>(i) / pointCount) * 2.0f * PI - PI / 2.0f;
+                result[i] = {std::cos(angle), std::sin(angle)};
+            }
+
+            return result;
+        }();
+
+        return directions;
+    }
+
+    void appendQuad(std::vector<sf::Vertex>& out, const sf::Vector2f& a, const sf::Vector2f& b,
+                    const sf::Vector2f& c, const sf::Vector2f& d, const sf::Color& color) {
+        out.push_back({a, color});
+        out.push_back({b, color});
+        out.push_back({c, color});
+        out.push_back({c, color});
+        out.push_back({b, color});
+        out.push_back({d, color});
+    }
+}
+
+void HudWidget::SetPosition(const sf::Vector2f& position) {
+    if(this->position == position) return;
+
+    this->position = position;
+    moved = true;
+}
+
+void HudWidget::SetVisible(const bool visible) {
+    if(this->visible == visible) return;
+
+    this->visible = visible;
+    changed = true;
+}
+
+void AmmoGauge::Bind(const int ammo) {
+    if(this->ammo == ammo) return;
+    this->ammo = ammo;
+
+    const auto& directions = gaugeDirections();
+    const float ammoRatio = std::clamp(static_cast<float>(ammo) / Gun::MAX_AMMO, 0.f, 1.f);
+    const std::size_t segments = static_cast<std::size_t>((directions.size() - 1) * ammoRatio);
+
+    const sf::Color gaugeColor = sf::Color(
+        static_cast<std::uint8_t>(255 * (1.0f - ammoRatio)),
+        static_cast<std::uint8_t>(255 * ammoRatio),
+        0,
+        200
+    );
+
+    const float outer = AMMO_GAUGE_RADIUS + AMMO_GAUGE_THICKNESS / 2.0f;
+    const float inner = AMMO_GAUGE_RADIUS - AMMO_GAUGE_THICKNESS / 2.0f;
+
+    geometry.clear();
+    for(std::size_t i = 0; i < segments; ++i) {
+        appendQuad(geometry,
+            directions[i] * outer, directions[i] * inner,
+            directions[i + 1] * outer, directions[i + 1] * inner,
+            gaugeColor);
+    }
+
+    invalidate();
+}
+
+void ZoomGauge::Bind(const float ratio) {
+    const float clamped = std::clamp(ratio, 0.f, 1.f);
+    if(this->ratio == clamped) return;
+    this->ratio = clamped;
+
+    const float fill = SIZE.y * clamped;
+
+    geometry.clear();
+    appendQuad(geometry, {0.f, 0.f}, {SIZE.x, 0.f}, {0.f, SIZE.y - fill}, {SIZE.x, SIZE.y - fill}, ZOOM_TRACK_COLOR);
+    appendQuad(geometry, {0.f, SIZE.y - fill}, {SIZE.x, SIZE.y - fill}, {0.f, SIZE.y}, {SIZE.x, SIZE.y}, ZOOM_FILL_COLOR);
+
+    invalidate();
+}
+
+void HudLayer::Clear() {
+    widgets.clear();
+    stream.clear();
+}
+
+void HudLayer::Draw(sf::RenderTarget& target) {
+    const bool changed = std::any_of(widgets.begin(), widgets.end(),
+        [](const std::unique_ptr<HudWidget>& widget) { return widget->changed; });
+
+    if(changed)
+        rebuild();
+    else {
+        for(const auto& widget : widgets) {
+            if(!widget->moved) continue;
+            widget->moved = false;
+            if(!widget->visible) continue;
+
+            sf::Vertex* out = stream.data() + widget->first;
+            for(const sf::Vertex& vertex : widget->geometry)
+                (out++)->position = vertex.position + widget->position;
+        }
+    }
+
+    if(stream.empty()) return;
+
+    const sf::View originalView = target.getView();
+    target.setView(target.getDefaultView());
+
+    target.draw(stream.data(), stream.size(), sf::PrimitiveType::Triangles);
+    CountDraw(stream.size());
+
+    target.setView(originalView);
+}
+
+void HudLayer::rebuild() {
+    stream.clear();
+
+    for(const auto& widget : widgets) {
+        widget->changed = false;
+        widget->moved = false;
+        widget->first = stream.size();
+        if(!widget->visible) continue;
+
+        for(const sf::Vertex& vertex : widget->geometry)
+            stream.push_back({vertex.position + widget->position, vertex.color});
+    }
+}
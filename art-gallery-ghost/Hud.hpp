@@ -0,0 +1,91 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace core {
+    constexpr float AMMO_GAUGE_RADIUS = 20.f;
+    constexpr float AMMO_GAUGE_THICKNESS = 4.f;
+
+    // Screen-space triangles built around the widget's own origin. A widget rebuilds them only when
+    // its bound value changes; moving it just re-translates the vertices in the layer's stream.
+    class HudWidget {
+    public:
+        virtual ~HudWidget() = default;
+
+        void SetPosition(const sf::Vector2f& position);
+        void SetVisible(const bool visible);
+
+        const sf::Vector2f& GetPosition() const { return position; }
+        bool IsVisible() const { return visible; }
+        std::size_t GetVertexCount() const { return geometry.size(); }
+
+    protected:
+        std::vector<sf::Vertex> geometry;
+
+        // Call after changing `geometry`.
+        void invalidate() { changed = true; }
+
+    private:
+        friend class HudLayer;
+
+        sf::Vector2f position;
+        bool visible = true;
+        bool changed = true;
+        bool moved = false;
+
+        // Where this widget's vertices start in the layer's stream.
+        std::size_t first = 0;
+    };
+
+    // Ring filled clockwise from the top by the remaining ammo, fading from green to red.
+    class AmmoGauge : public HudWidget {
+    public:
+        void Bind(const int ammo);
+
+    private:
+        int ammo = -1;
+    };
+
+    // Vertical bar filled by how far the camera is zoomed out, from the bottom.
+    class ZoomGauge : public HudWidget {
+    public:
+        constexpr static sf::Vector2f SIZE{6.f, 80.f};
+
+        // `ratio` is 0 at the closest zoom and 1 at the farthest.
+        void Bind(const float ratio);
+
+    private:
+        float ratio = -1.f;
+    };
+
+    // Owns the HUD widgets and draws all of them with the target's default view in one call.
+    // The combined stream is only re-assembled on frames where a widget's geometry or visibility
+    // changed; a widget that only moved re-translates its own range of the stream.
+    class HudLayer {
+    public:
+        template <typename T>
+        T& Add() {
+            auto widget = std::make_unique<T>();
+            T& added = *widget;
+
+            widgets.push_back(std::move(widget));
+            return added;
+        }
+
+        void Clear();
+
+        // The current view is restored afterwards.
+        void Draw(sf::RenderTarget& target);
+
+        std::size_t GetVertexCount() const { return stream.size(); }
+
+    private:
+        std::vector<std::unique_ptr<HudWidget>> widgets;
+        std::vector<sf::Vertex> stream;
+
+        void rebuild();
+    };
+}
@@ -7,9 +7,20 @@
 #include "Map.hpp"
 #include "Render.hpp"
 #include "Collision.hpp"
+#include "WallShape.hpp"
+#include "Player.hpp"
 
 const sf::Color MAP_COLOR = sf::Color::White;
-const std::uint8_t EDGE_POINT = 6;
+const sf::Color WALL_COLOR = sf::Color{40, 40, 48};
+const std::uint8_t EDGE_POINT = 12;
+const std::uint8_t PILLAR_COUNT = 6;
+const std::uint8_t PILLAR_ATTEMPTS = 64;
+
+// Alternate wall corners are pulled in to this fraction of the map size, giving a concave floor plan.
+constexpr float ALCOVE_DEPTH = 0.75f;
+constexpr float MIN_PILLAR_SIZE = 60.f;
+constexpr float MAX_PILLAR_SIZE = 160.f;
+constexpr float SPAWN_CLEARANCE = 300.f;
 
 constexpr float PI = 3.141592f;
 
@@ -19,32 +30,122 @@ struct PolarPoint {
 };
 
 void Map::generateRandomWalls() {
-    std::vector<sf::Vector2f> points;
-    generateRandomPoints(points);
+    core::PolygonWithHoles floor;
+    generateRandomPoints(floor.outer);
+    generateRandomPillars(floor.holes);
+
+    WallShape shape(floor);
+    shape.SetFillColor(MAP_COLOR);
+    shape.SetWallColor(WALL_COLOR);
+
+    auto render = std::make_shared<Render>(this, std::move(shape));
+    walls = render->GetShape<WallShape>();
+
+    this->AddComponent(std::move(render));
+
+    auto wallCollision = std::make_shared<Collision>(this);
+    collision = wallCollision.get();
+    field.Bake(*collision);
+
+    this->AddComponent(std::move(wallCollision));
+}
+
+bool Map::CarveWall(const sf::Vector2f& impact) {
+    if(!walls) return false;
+
+    // Bullets are culled a step past the surface, so the crater is centered back on it.
+    const sf::Vector2f local = impact - transform.GetWorldPosition();
+    sf::Vector2f surface;
+    if(!walls->GetClosestSurfacePoint(local, surface)) return false;
+
+    const sf::Vector2f corner = surface + transform.GetWorldPosition() - sf::Vector2f{CRATER_RADIUS, CRATER_RADIUS};
+    const sf::FloatRect area{corner, {CRATER_RADIUS * 2.f, CRATER_RADIUS * 2.f}};
 
-    std::unique_ptr<sf::ConvexShape> convex = std::make_unique<sf::ConvexShape>();
-    convex->setPointCount(EDGE_POINT);
+    walls->GetChunksNear(surface, CRATER_RADIUS, nearChunks);
+    for(const std::uint32_t chunk : nearChunks) {
+        WallUndo& undo = pushUndo();
+        undo.revision = wallRevision + 1;
+        undo.chunk = chunk;
+        undo.area = area;
+        undo.bytes.clear();
 
-    for(std::size_t i = 0; i < EDGE_POINT; ++i)
-        convex->setPoint(i, points[i]);
+        core::ByteWriter out(undo.bytes);
+        walls->WriteChunk(chunk, out);
+    }
+
+    if(!walls->Carve(surface, CRATER_RADIUS)) {
+        for(std::size_t i = 0; i < nearChunks.size(); ++i) popUndo();
+        return false;
+    }
+
+    ++wallRevision;
+    field.Rebake(*collision, area);
+    return true;
+}
 
-    convex->setFillColor(MAP_COLOR);
+bool Map::RewindWalls(const std::uint32_t revision) {
+    if(revision == wallRevision) return true;
+    if(!walls || revision > wallRevision || revision < rewindFloor) return false;
 
-    this->AddComponent(std::make_unique<Render>(this, std::move(convex)));
-    this->AddComponent(std::make_unique<Collision>(this));
+    while(journalCount > 0) {
+        const WallUndo& undo = journal[(journalEnd + WALL_JOURNAL_CAPACITY - 1) % WALL_JOURNAL_CAPACITY];
+        if(undo.revision <= revision) break;
+
+        core::ByteReader in(undo.bytes);
+        walls->ReadChunk(undo.chunk, in);
+        field.Rebake(*collision, undo.area);
+        popUndo();
+    }
+
+    wallRevision = revision;
+    return true;
+}
+
+bool Map::RestoreWalls(const std::vector<std::vector<std::uint8_t>>& chunks) {
+    if(!walls || chunks.size() != walls->GetChunkCount()) return false;
+
+    for(std::size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+        core::ByteReader in(chunks[chunk]);
+        if(!walls->ReadChunk(chunk, in)) return false;
+    }
+
+    journalCount = 0;
+    rewindFloor = wallRevision;
+
+    field.Bake(*collision);
+    return true;
+}
+
+Map::WallUndo& Map::pushUndo() {
+    WallUndo& undo = journal[journalEnd];
+
+    // Overwriting the oldest entry loses the means to undo its carve.
+    if(journalCount == WALL_JOURNAL_CAPACITY)
+        rewindFloor = std::max(rewindFloor, undo.revision);
+    else
+        ++journalCount;
+
+    journalEnd = (journalEnd + 1) % WALL_JOURNAL_CAPACITY;
+    return undo;
+}
+
+void Map::popUndo() {
+    journalEnd = (journalEnd + WALL_JOURNAL_CAPACITY - 1) % WALL_JOURNAL_CAPACITY;
+    --journalCount;
 }
 
 void Map::generateRandomPoints(std::vector<sf::Vector2f>& points) const {
-    std::mt19937 gen{std::random_device{}()};
+    std::mt19937 gen{seed};
     std::uniform_real_distribution<float> noiseDist(-PI / 24.f, PI / 24.f);
 
     std::vector<PolarPoint> polarPoints;
 
     for(std::size_t i = 0; i < EDGE_POINT; ++i) {
         float rad = static_cast<float>(i) * (2.f * PI / EDGE_POINT) + noiseDist(gen);
+        float distance = i % 2 == 0 ? size : size * ALCOVE_DEPTH;
 
         polarPoints.emplace_back(PolarPoint{
-            size * sf::Vector2f{std::cos(rad), std::sin(rad)},
+            distance * sf::Vector2f{std::cos(rad), std::sin(rad)},
             rad});
     }
 
@@ -55,4 +156,39 @@ void Map::generateRandomPoints(std::vector<sf::Vector2f>& points) const {
 
     for(const auto& point : polarPoints)
         points.emplace_back(point.Pos);
+}
+
+void Map::generateRandomPillars(std::vector<std::vector<sf::Vector2f>>& pillars) const {
+    const float maxDistance = size * ALCOVE_DEPTH * 0.6f;
+    if(maxDistance <= SPAWN_CLEARANCE + MAX_PILLAR_SIZE) return;
+
+    std::mt19937 gen{seed ^ 0x9e3779b9u};
+    std::uniform_real_distribution<float> angleDist(0.f, 2.f * PI);
+    std::uniform_real_distribution<float> distanceDist(SPAWN_CLEARANCE + MAX_PILLAR_SIZE, maxDistance);
+    std::uniform_real_distribution<float> sizeDist(MIN_PILLAR_SIZE, MAX_PILLAR_SIZE);
+
+    std::vector<std::pair<sf::Vector2f, float>> placed;
+
+    for(std::size_t attempt = 0; attempt < PILLAR_ATTEMPTS && placed.size() < PILLAR_COUNT; ++attempt) {
+        const float rad = angleDist(gen);
+        const float distance = distanceDist(gen);
+        const sf::Vector2f center = distance * sf::Vector2f{std::cos(rad), std::sin(rad)};
+        const sf::Vector2f half{sizeDist(gen) * 0.5f, sizeDist(gen) * 0.5f};
+        const float extent = std::sqrt(half.x * half.x + half.y * half.y);
+
+        const bool overlaps = std::any_of(placed.begin(), placed.end(), [&](const auto& other) {
+            const sf::Vector2f diff = other.first - center;
+            const float gap = extent + other.second + Player::SHAPE_RADIUS * 4.f;
+            return diff.x * diff.x + diff.y * diff.y < gap * gap;
+        });
+
+        if(overlaps) continue;
+
+        placed.emplace_back(center, extent);
+        pillars.push_back({
+            center + sf::Vector2f{-half.x, -half.y},
+            center + sf::Vector2f{half.x, -half.y},
+            center + sf::Vector2f{half.x, half.y},
+            center + sf::Vector2f{-half.x, half.y}});
+    }
 }
\ No newline at end of file
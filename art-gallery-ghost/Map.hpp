@@ -3,19 +3,80 @@
 #include <SFML/Graphics.hpp>
 
 #include <cstdint>
+#include <random>
+#include <vector>
 
 #include "Object.hpp"
+#include "DistanceField.hpp"
+
+class WallShape;
+class Collision;
 
 class Map : public core::Object {
 public:
-    Map(const float size) : size(size) {
+    constexpr static float DEFAULT_SIZE = 3000.f;
+    constexpr static float CRATER_RADIUS = 14.f;
+    // Chunks saved before carves, for RewindWalls. A crater touches one chunk, rarely up to four.
+    constexpr static std::size_t WALL_JOURNAL_CAPACITY = 64;
+
+    Map(const float size) : Map(size, std::random_device{}()) {}
+
+    Map(const float size, const std::uint32_t seed) : size(size), seed(seed) {
         generateRandomWalls();
     }
 
     void Update(const float deltaTime) override {};
+
+    float GetSize() const { return size; }
+    std::uint32_t GetSeed() const { return seed; }
+
+    // Signed distance to the walls in world space, kept up to date as they are carved.
+    const core::DistanceField& GetDistanceField() const { return field; }
+
+    // Chips a crater out of the wall surface nearest to `impact`. False when nothing solid was hit.
+    bool CarveWall(const sf::Vector2f& impact);
+
+    const WallShape* GetWalls() const { return walls; }
+
+    // Bumped by every carve that hits; rollback records it with the rest of the world.
+    std::uint32_t GetWallRevision() const { return wallRevision; }
+
+    // Undoes the carves made since `revision`. False, leaving the walls alone, when the journal
+    // does not reach back that far.
+    bool RewindWalls(const std::uint32_t revision);
+
+    // Replaces every wall chunk with saved ones, one per WallShape chunk, and re-bakes the field.
+    // Carves made before cannot be rewound any more.
+    bool RestoreWalls(const std::vector<std::vector<std::uint8_t>>& chunks);
+
 private:
     float size = 0.f;
+    std::uint32_t seed = 0;
+    WallShape* walls = nullptr;
+    const Collision* collision = nullptr;
+    core::DistanceField field;
+
+    // A chunk as it was before the carve that made `revision`.
+    struct WallUndo {
+        std::uint32_t revision = 0;
+        std::uint32_t chunk = 0;
+        sf::FloatRect area;
+        std::vector<std::uint8_t> bytes;
+    };
+
+    // Ring of the newest WALL_JOURNAL_CAPACITY entries; the buffers keep their capacity.
+    std::vector<WallUndo> journal = std::vector<WallUndo>(WALL_JOURNAL_CAPACITY);
+    std::size_t journalEnd = 0;
+    std::size_t journalCount = 0;
+    std::uint32_t wallRevision = 0;
+    // The oldest revision RewindWalls can still go back to.
+    std::uint32_t rewindFloor = 0;
+    std::vector<std::uint32_t> nearChunks;
+
+    WallUndo& pushUndo();
+    void popUndo();
 
     void generateRandomWalls();
     void generateRandomPoints(std::vector<sf::Vector2f>& points) const;
+    void generateRandomPillars(std::vector<std::vector<sf::Vector2f>>& pillars) const;
 };
\ No newline at end of file
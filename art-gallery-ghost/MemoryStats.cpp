@@ -0,0 +1,252 @@
+#include "MemoryStats.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <ostream>
+
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+using namespace core;
+
+namespace {
+    struct alignas(64) TagCounters {
+        std::atomic<std::int64_t> liveBytes{0};
+        std::atomic<std::int64_t> peakBytes{0};
+        std::atomic<std::uint64_t> totalAllocations{0};
+        std::atomic<std::uint64_t> totalBytes{0};
+        std::atomic<std::uint64_t> frameAllocations{0};
+        std::atomic<std::uint64_t> frameBytes{0};
+        std::atomic<std::uint64_t> lastFrameAllocations{0};
+        std::atomic<std::uint64_t> lastFrameBytes{0};
+    };
+
+    struct alignas(64) HeapCounters {
+        std::atomic<std::int64_t> liveBytes{0};
+        std::atomic<std::int64_t> liveBlocks{0};
+        std::atomic<std::int64_t> peakBytes{0};
+    };
+
+    // Constant-initialized, so allocations made during static initialization are counted too.
+    constinit std::array<TagCounters, MEMORY_TAG_COUNT> counters{};
+    constinit HeapCounters heap{};
+
+    constexpr std::array<std::string_view, MEMORY_TAG_COUNT> TAG_NAMES = {
+        "general", "world", "collision", "rendering", "particles", "gameplay", "network", "save", "audio", "log"};
+
+    void raisePeak(std::atomic<std::int64_t>& peakBytes, const std::int64_t live) {
+        std::int64_t peak = peakBytes.load(std::memory_order_relaxed);
+        while(live > peak && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    }
+
+    // Blocks are plain malloc blocks, so one freed by another module's delete (SFML's DLLs) stays
+    // valid. The allocator's own size is used both ways, since unsized delete knows no other.
+    std::size_t blockSize(void* block) {
+#if defined(_WIN32)
+        return _msize(block);
+#elif defined(__APPLE__)
+        return malloc_size(block);
+#else
+        return malloc_usable_size(block);
+#endif
+    }
+
+    // Over-aligned blocks come from the aligned allocator, which on Windows needs its own free.
+    void* alignedMalloc(const std::size_t size, const std::size_t alignment) {
+#if defined(_WIN32)
+        return _aligned_malloc(size, alignment);
+#else
+        // aligned_alloc wants a whole number of alignments.
+        return std::aligned_alloc(alignment, (std::max<std::size_t>(size, 1) + alignment - 1) / alignment * alignment);
+#endif
+    }
+
+    void alignedFree(void* block) {
+#if defined(_WIN32)
+        _aligned_free(block);
+#else
+        std::free(block);
+#endif
+    }
+
+    std::size_t alignedBlockSize(void* block, const std::size_t alignment) {
+#if defined(_WIN32)
+        return _aligned_msize(block, alignment, 0);
+#else
+        static_cast<void>(alignment);
+        return blockSize(block);
+#endif
+    }
+
+    void countBlock(const std::size_t size) {
+        const auto bytes = static_cast<std::int64_t>(size);
+        ++memory::threadAllocations;
+
+        TagCounters& tag = counters[static_cast<std::size_t>(memory::currentTag)];
+        tag.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+        tag.totalBytes.fetch_add(static_cast<std::uint64_t>(bytes), std::memory_order_relaxed);
+        tag.frameAllocations.fetch_add(1, std::memory_order_relaxed);
+        tag.frameBytes.fetch_add(static_cast<std::uint64_t>(bytes), std::memory_order_relaxed);
+
+        const std::int64_t live = heap.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        heap.liveBlocks.fetch_add(1, std::memory_order_relaxed);
+        raisePeak(heap.peakBytes, live);
+    }
+
+    void uncountBlock(const std::size_t size) {
+        heap.liveBytes.fetch_sub(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+        heap.liveBlocks.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void* allocate(const std::size_t size) {
+        void* block = std::malloc(size);
+        if(block) countBlock(blockSize(block));
+        return block;
+    }
+
+    void release(void* block) {
+        if(!block) return;
+
+        uncountBlock(blockSize(block));
+        std::free(block);
+    }
+
+    void* allocateAligned(const std::size_t size, const std::align_val_t alignment) {
+        void* block = alignedMalloc(size, static_cast<std::size_t>(alignment));
+        if(block) countBlock(alignedBlockSize(block, static_cast<std::size_t>(alignment)));
+        return block;
+    }
+
+    void releaseAligned(void* block, const std::align_val_t alignment) {
+        if(!block) return;
+
+        uncountBlock(alignedBlockSize(block, static_cast<std::size_t>(alignment)));
+        alignedFree(block);
+    }
+
+    void* allocateOrThrow(const std::size_t size) {
+        if(void* block = allocate(size)) return block;
+        throw std::bad_alloc();
+    }
+
+    void* allocateAlignedOrThrow(const std::size_t size, const std::align_val_t alignment) {
+        if(void* block = allocateAligned(size, alignment)) return block;
+        throw std::bad_alloc();
+    }
+}
+
+void core::memory::AddLiveBytes(const MemoryTag tag, const std::size_t bytes) {
+    TagCounters& counter = counters[static_cast<std::size_t>(tag)];
+    const auto size = static_cast<std::int64_t>(bytes);
+    raisePeak(counter.peakBytes, counter.liveBytes.fetch_add(size, std::memory_order_relaxed) + size);
+}
+
+void core::memory::RemoveLiveBytes(const MemoryTag tag, const std::size_t bytes) {
+    counters[static_cast<std::size_t>(tag)].liveBytes.fetch_sub(static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+}
+
+void* operator new(const std::size_t size) { return allocateOrThrow(size); }
+void* operator new[](const std::size_t size) { return allocateOrThrow(size); }
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+
+void operator delete(void* block) noexcept { release(block); }
+void operator delete[](void* block) noexcept { release(block); }
+void operator delete(void* block, std::size_t) noexcept { release(block); }
+void operator delete[](void* block, std::size_t) noexcept { release(block); }
+void operator delete(void* block, const std::nothrow_t&) noexcept { release(block); }
+void operator delete[](void* block, const std::nothrow_t&) noexcept { release(block); }
+
+void* operator new(const std::size_t size, const std::align_val_t alignment) { return allocateAlignedOrThrow(size, alignment); }
+void* operator new[](const std::size_t size, const std::align_val_t alignment) { return allocateAlignedOrThrow(size, alignment); }
+void* operator new(const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+void* operator new[](const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* block, const std::align_val_t alignment) noexcept { releaseAligned(block, alignment); }
+void operator delete[](void* block, const std::align_val_t alignment) noexcept { releaseAligned(block, alignment); }
+void operator delete(void* block, std::size_t, const std::align_val_t alignment) noexcept { releaseAligned(block, alignment); }
+void operator delete[](void* block, std::size_t, const std::align_val_t alignment) noexcept { releaseAligned(block, alignment); }
+void operator delete(void* block, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    releaseAligned(block, alignment);
+}
+void operator delete[](void* block, const std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    releaseAligned(block, alignment);
+}
+
+std::string_view core::GetMemoryTagName(const MemoryTag tag) {
+    return TAG_NAMES[static_cast<std::size_t>(tag)];
+}
+
+MemoryTagStats core::GetMemoryStats(const MemoryTag tag) {
+    const TagCounters& counter = counters[static_cast<std::size_t>(tag)];
+
+    MemoryTagStats stats;
+    stats.liveBytes = counter.liveBytes.load(std::memory_order_relaxed);
+    stats.peakBytes = counter.peakBytes.load(std::memory_order_relaxed);
+    stats.totalAllocations = counter.totalAllocations.load(std::memory_order_relaxed);
+    stats.totalBytes = counter.totalBytes.load(std::memory_order_relaxed);
+    stats.frameAllocations = counter.lastFrameAllocations.load(std::memory_order_relaxed);
+    stats.frameBytes = counter.lastFrameBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+HeapStats core::GetHeapStats() {
+    HeapStats stats;
+    stats.liveBytes = heap.liveBytes.load(std::memory_order_relaxed);
+    stats.liveBlocks = heap.liveBlocks.load(std::memory_order_relaxed);
+    stats.peakBytes = heap.peakBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void core::EndMemoryFrame() {
+    for(auto& counter : counters) {
+        counter.lastFrameAllocations.store(counter.frameAllocations.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        counter.lastFrameBytes.store(counter.frameBytes.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+void core::WriteMemoryReport(std::ostream& out) {
+    MemoryTagStats total;
+
+    out << std::left << std::setw(12) << "tag" << std::right
+        << std::setw(12) << "live KB" << std::setw(12) << "peak KB" << std::setw(12) << "KB/frame"
+        << std::setw(14) << "allocs/frame" << std::setw(12) << "total KB" << std::setw(12) << "allocs" << '\n';
+
+    out << std::fixed << std::setprecision(1);
+    for(std::size_t i = 0; i < MEMORY_TAG_COUNT; ++i) {
+        const MemoryTag tag = static_cast<MemoryTag>(i);
+        const MemoryTagStats stats = GetMemoryStats(tag);
+
+        out << std::left << std::setw(12) << GetMemoryTagName(tag) << std::right
+            << std::setw(12) << static_cast<double>(stats.liveBytes) / 1024.0
+            << std::setw(12) << static_cast<double>(stats.peakBytes) / 1024.0
+            << std::setw(12) << static_cast<double>(stats.frameBytes) / 1024.0 << std::setw(14) << stats.frameAllocations
+            << std::setw(12) << static_cast<double>(stats.totalBytes) / 1024.0 << std::setw(12) << stats.totalAllocations << '\n';
+
+        total.liveBytes += stats.liveBytes;
+        total.totalAllocations += stats.totalAllocations;
+        total.totalBytes += stats.totalBytes;
+        total.frameAllocations += stats.frameAllocations;
+        total.frameBytes += stats.frameBytes;
+    }
+
+    // Peaks of different tags need not coincide, so there is no total peak.
+    out << std::left << std::setw(12) << "total" << std::right
+        << std::setw(12) << static_cast<double>(total.liveBytes) / 1024.0 << std::setw(12) << "-"
+        << std::setw(12) << static_cast<double>(total.frameBytes) / 1024.0 << std::setw(14) << total.frameAllocations
+        << std::setw(12) << static_cast<double>(total.totalBytes) / 1024.0 << std::setw(12) << total.totalAllocations << '\n';
+
+    const HeapStats heap = GetHeapStats();
+    out << "heap: " << static_cast<double>(heap.liveBytes) / 1024.0 << " KB live in " << heap.liveBlocks
+        << " blocks, " << static_cast<double>(heap.peakBytes) / 1024.0 << " KB peak\n";
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <new>
+#include <string_view>
+
+namespace core {
+    // Subsystems allocations are charged to. Allocations outside any MemoryScope are General.
+    enum class MemoryTag : std::uint8_t {
+        General,
+        World,
+        Collision,
+        Rendering,
+        Particles,
+        Gameplay,
+        Network,
+        Save,
+        Audio,
+        Log,
+    };
+
+    constexpr std::size_t MEMORY_TAG_COUNT = static_cast<std::size_t>(MemoryTag::Log) + 1;
+
+    // Blocks carry no tag, so a tag counts everything it allocated but only knows what is still live
+    // in the containers that pin it with TaggedAllocator, which size their frees. HeapStats has
+    // the live bytes of everything.
+    struct MemoryTagStats {
+        std::int64_t liveBytes = 0;
+        std::int64_t peakBytes = 0;
+        std::uint64_t totalAllocations = 0;
+        std::uint64_t totalBytes = 0;
+        // Allocations during the last frame closed by EndMemoryFrame.
+        std::uint64_t frameAllocations = 0;
+        std::uint64_t frameBytes = 0;
+    };
+
+    struct HeapStats {
+        std::int64_t liveBytes = 0;
+        std::int64_t liveBlocks = 0;
+        std::int64_t peakBytes = 0;
+    };
+
+    namespace memory {
+        // MemoryStats.cpp replaces the global operator new and delete; every allocation is charged
+        // to the allocating thread's current tag.
+        inline thread_local MemoryTag currentTag = MemoryTag::General;
+        inline thread_local std::uint64_t threadAllocations = 0;
+
+        void AddLiveBytes(const MemoryTag tag, const std::size_t bytes);
+        void RemoveLiveBytes(const MemoryTag tag, const std::size_t bytes);
+    }
+
+    // Charges allocations made on this thread to `tag` until it goes out of scope. Scopes nest.
+    class MemoryScope {
+    public:
+        explicit MemoryScope(const MemoryTag tag) : previous(memory::currentTag) { memory::currentTag = tag; }
+        ~MemoryScope() { memory::currentTag = previous; }
+
+        MemoryScope(const MemoryScope&) = delete;
+        MemoryScope& operator=(const MemoryScope&) = delete;
+
+    private:
+        MemoryTag previous;
+    };
+
+    // Counts the allocations made on this thread while it is alive, so a steady-state tick can be
+    // asserted not to touch the heap.
+    class NoAllocationScope {
+    public:
+        NoAllocationScope() : start(memory::threadAllocations) {}
+
+        std::uint64_t GetAllocations() const { return memory::threadAllocations - start; }
+
+    private:
+        std::uint64_t start;
+    };
+
+    // For containers that belong to one subsystem wherever they happen to grow.
+    template <typename T, MemoryTag Tag>
+    struct TaggedAllocator {
+        using value_type = T;
+
+        template <typename U>
+        struct rebind {
+            using other = TaggedAllocator<U, Tag>;
+        };
+
+        TaggedAllocator() = default;
+
+        template <typename U>
+        TaggedAllocator(const TaggedAllocator<U, Tag>&) noexcept {}
+
+        T* allocate(const std::size_t count) {
+            MemoryScope scope(Tag);
+            T* block = static_cast<T*>(::operator new(count * sizeof(T)));
+            memory::AddLiveBytes(Tag, count * sizeof(T));
+            return block;
+        }
+
+        void deallocate(T* block, const std::size_t count) noexcept {
+            memory::RemoveLiveBytes(Tag, count * sizeof(T));
+            ::operator delete(block);
+        }
+
+        template <typename U>
+        bool operator==(const TaggedAllocator<U, Tag>&) const noexcept { return true; }
+    };
+
+    std::string_view GetMemoryTagName(const MemoryTag tag);
+    MemoryTagStats GetMemoryStats(const MemoryTag tag);
+    HeapStats GetHeapStats();
+
+    // Closes a frame: the allocations counted since the previous call become frameAllocations.
+    void EndMemoryFrame();
+
+    // One line per tag with live, peak, per-frame and total numbers, then the totals and the heap's
+    // live and peak bytes.
+    void WriteMemoryReport(std::ostream& out);
+}
@@ -4,15 +4,21 @@
 #include <string_view>
 
 #include "Component.hpp"
+#include "Object.hpp"
 
 class Movement : public core::Component{
 public:
+    struct State {
+        sf::Vector2f pos;
+        sf::Vector2f velocity;
+    };
+
     Movement(core::Object* obj) : Component(obj) {}
 
     Movement(core::Object* obj, const sf::Vector2f& pos)
         : Component(obj)
         , pos(pos)
-        , velocity({0.f, 0.f}) {}
+        , velocity({0.f, 0.f}) { syncTransform(); }
 
     Movement(const Movement& other) 
         : Component(other.owner)
@@ -23,21 +29,41 @@ public:
         this->owner = other.owner;
         this->pos = other.pos;
         this->velocity = other.velocity;
+        syncTransform();
     }
 
-    void Update(const float deltaTime) override { pos += deltaTime * velocity; }
+    void Update(const float deltaTime) override {
+        pos += deltaTime * velocity;
+        syncTransform();
+    }
 
     std::string_view GetTag() const override { return tag; }
 
-    void SetPos(const sf::Vector2f& pos) { this->pos = pos; }
+    void SetPos(const sf::Vector2f& pos) {
+        this->pos = pos;
+        syncTransform();
+    }
+
     void SetVel(const sf::Vector2f& vel) { this->velocity = vel; }
 
     sf::Vector2f GetPos() const { return pos; }
     sf::Vector2f GetVel() const { return velocity; }
 
+    State GetState() const { return {pos, velocity}; }
+    void SetState(const State& state) {
+        pos = state.pos;
+        velocity = state.velocity;
+        syncTransform();
+    }
+
 private:
     constexpr static std::string_view tag = "movement";
 
     sf::Vector2f pos;
     sf::Vector2f velocity;
+
+    // Movement stays the simulated state; the owner's transform mirrors it for render and collision.
+    void syncTransform() {
+        if(owner) owner->GetTransform().SetPosition(pos);
+    }
 };
\ No newline at end of file
@@ -0,0 +1,297 @@
+#include "NetProtocol.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+using namespace net;
+using core::ByteReader;
+using core::ByteWriter;
+
+// Fields go out as their native bytes, which only matches the wire format on little-endian hosts.
+static_assert(std::endian::native == std::endian::little, "the network protocol is little-endian");
+
+namespace {
+    enum PlayerField : std::uint8_t {
+        FieldPosition = 1 << 0,
+        FieldVelocity = 1 << 1,
+        FieldAim = 1 << 2,
+        FieldLight = 1 << 3,
+        FieldAmmo = 1 << 4,
+        FieldAll = 0x1F
+    };
+
+    bool sameBits(const float lhs, const float rhs) {
+        return std::memcmp(&lhs, &rhs, sizeof(float)) == 0;
+    }
+
+    bool sameVec(const sf::Vector2f& lhs, const sf::Vector2f& rhs) {
+        return sameBits(lhs.x, rhs.x) && sameBits(lhs.y, rhs.y);
+    }
+
+    std::uint8_t changedFields(const PlayerState& current, const PlayerState* base) {
+        if(!base) return FieldAll;
+
+        std::uint8_t mask = 0;
+
+        if(!sameVec(current.movement.pos, base->movement.pos))
+            mask |= FieldPosition;
+        if(!sameVec(current.movement.velocity, base->movement.velocity))
+            mask |= FieldVelocity;
+        if(!sameBits(current.flashlight.startAngle, base->flashlight.startAngle))
+            mask |= FieldAim;
+        if(!sameBits(current.flashlight.fanWidth, base->flashlight.fanWidth)
+            || !sameBits(current.flashlight.radius, base->flashlight.radius)
+            || current.flashlight.alpha != base->flashlight.alpha
+            || current.flashlight.isSwitchOn != base->flashlight.isSwitchOn)
+            mask |= FieldLight;
+        if(current.ammo != base->ammo)
+            mask |= FieldAmmo;
+
+        return mask;
+    }
+
+    std::size_t playerBytes(const std::uint8_t mask) {
+        if(mask == 0) return 0;
+
+        std::size_t bytes = 2 + 1;
+        if(mask & FieldPosition) bytes += 8;
+        if(mask & FieldVelocity) bytes += 8;
+        if(mask & FieldAim) bytes += 4;
+        if(mask & FieldLight) bytes += 4 + 4 + 1 + 1;
+        if(mask & FieldAmmo) bytes += 1;
+        return bytes;
+    }
+
+    void writeVec(ByteWriter& writer, const sf::Vector2f& value) {
+        writer.Write(value.x);
+        writer.Write(value.y);
+    }
+
+    sf::Vector2f readVec(ByteReader& reader) {
+        const float x = reader.Take<float>();
+        return {x, reader.Take<float>()};
+    }
+
+    template <typename T, typename Key>
+    const T* findSorted(const std::vector<T>& items, const Key key, Key T::* member) {
+        auto iter = std::lower_bound(items.begin(), items.end(), key,
+            [member](const T& item, const Key value) { return item.*member < value; });
+
+        return iter != items.end() && (*iter).*member == key ? &*iter : nullptr;
+    }
+}
+
+void net::WriteInputs(ByteWriter& writer, const std::uint32_t ackedTick, const InputCommand* inputs, const std::size_t count) {
+    writer.Write<std::uint8_t>(static_cast<std::uint8_t>(MessageType::Input));
+    writer.Write<std::uint32_t>(ackedTick);
+    writer.Write<std::uint8_t>(static_cast<std::uint8_t>(count));
+
+    for(std::size_t i = 0; i < count; ++i) {
+        writer.Write<std::uint32_t>(inputs[i].sequence);
+        writer.Write<std::uint8_t>(inputs[i].buttons);
+        writeVec(writer, inputs[i].aim);
+        writer.Write<std::uint8_t>(static_cast<std::uint8_t>(static_cast<std::int8_t>(inputs[i].wheel)));
+    }
+}
+
+bool net::ReadInputs(ByteReader& reader, std::uint32_t& ackedTick, std::vector<InputCommand>& inputs) {
+    ackedTick = reader.Take<std::uint32_t>();
+    const std::uint8_t count = reader.Take<std::uint8_t>();
+
+    inputs.clear();
+    for(std::uint8_t i = 0; i < count && reader.Ok(); ++i) {
+        InputCommand input;
+        input.sequence = reader.Take<std::uint32_t>();
+        input.buttons = reader.Take<std::uint8_t>();
+        input.aim = readVec(reader);
+        input.wheel = static_cast<float>(static_cast<std::int8_t>(reader.Take<std::uint8_t>()));
+        inputs.push_back(input);
+    }
+
+    return reader.Ok();
+}
+
+void net::FitSnapshot(Snapshot& current, const Snapshot* baseline) {
+    std::size_t bytes = SNAPSHOT_HEADER_BYTES;
+
+    for(const auto& player : current.players) {
+        const PlayerState* base = baseline ? findSorted(baseline->players, player.id, &PlayerState::id) : nullptr;
+        bytes += playerBytes(changedFields(player, base));
+    }
+
+    if(baseline) {
+        for(const auto& player : baseline->players)
+            if(!findSorted(current.players, player.id, &PlayerState::id)) bytes += REMOVED_PLAYER_BYTES;
+
+        for(const auto& bullet : baseline->bullets)
+            if(!findSorted(current.bullets, bullet.key, &BulletState::key)) bytes += EXPIRED_BULLET_BYTES;
+    }
+
+    const std::size_t room = bytes < MAX_PACKET_SIZE ? (MAX_PACKET_SIZE - bytes) / SPAWNED_BULLET_BYTES : 0;
+    std::size_t spawned = 0;
+
+    auto kept = current.bullets.begin();
+    for(auto iter = current.bullets.begin(); iter != current.bullets.end(); ++iter) {
+        const bool known = baseline && findSorted(baseline->bullets, iter->key, &BulletState::key);
+        if(!known && spawned++ >= room) continue;
+
+        *kept++ = *iter;
+    }
+
+    current.bullets.erase(kept, current.bullets.end());
+}
+
+void net::WriteSnapshot(ByteWriter& writer, const Snapshot& current, const Snapshot* baseline) {
+    writer.Write<std::uint8_t>(static_cast<std::uint8_t>(MessageType::Snapshot));
+    writer.Write<std::uint32_t>(current.tick);
+    writer.Write<std::uint32_t>(baseline ? baseline->tick : 0);
+    writer.Write<std::uint32_t>(current.lastProcessedInput);
+
+    // Players whose fields differ from the baseline, with a bitmask of what follows.
+    std::uint8_t changed = 0;
+    for(const auto& player : current.players) {
+        const PlayerState* base = baseline ? findSorted(baseline->players, player.id, &PlayerState::id) : nullptr;
+        if(changedFields(player, base) != 0) ++changed;
+    }
+
+    writer.Write<std::uint8_t>(changed);
+    for(const auto& player : current.players) {
+        const PlayerState* base = baseline ? findSorted(baseline->players, player.id, &PlayerState::id) : nullptr;
+        const std::uint8_t mask = changedFields(player, base);
+        if(mask == 0) continue;
+
+        writer.Write<std::uint16_t>(player.id);
+        writer.Write<std::uint8_t>(mask);
+
+        if(mask & FieldPosition) writeVec(writer, player.movement.pos);
+        if(mask & FieldVelocity) writeVec(writer, player.movement.velocity);
+        if(mask & FieldAim) writer.Write<float>(player.flashlight.startAngle);
+        if(mask & FieldLight) {
+            writer.Write<float>(player.flashlight.fanWidth);
+            writer.Write<float>(player.flashlight.radius);
+            writer.Write<std::uint8_t>(player.flashlight.alpha);
+            writer.Write<std::uint8_t>(player.flashlight.isSwitchOn ? 1 : 0);
+        }
+        if(mask & FieldAmmo) writer.Write<std::uint8_t>(player.ammo);
+    }
+
+    // Players that left the client's relevant set.
+    std::uint8_t removed = 0;
+    if(baseline) {
+        for(const auto& player : baseline->players)
+            if(!findSorted(current.players, player.id, &PlayerState::id)) ++removed;
+    }
+
+    writer.Write<std::uint8_t>(removed);
+    if(baseline) {
+        for(const auto& player : baseline->players)
+            if(!findSorted(current.players, player.id, &PlayerState::id)) writer.Write<std::uint16_t>(player.id);
+    }
+
+    // Bullets travel in straight lines, so only spawns and removals are sent.
+    std::uint8_t spawned = 0;
+    for(const auto& bullet : current.bullets)
+        if(!baseline || !findSorted(baseline->bullets, bullet.key, &BulletState::key)) ++spawned;
+
+    writer.Write<std::uint8_t>(spawned);
+    for(const auto& bullet : current.bullets) {
+        if(baseline && findSorted(baseline->bullets, bullet.key, &BulletState::key)) continue;
+
+        writer.Write<std::uint64_t>(bullet.key);
+        writeVec(writer, bullet.origin);
+        writeVec(writer, bullet.direction);
+        writer.Write<std::uint32_t>(bullet.spawnTick);
+    }
+
+    std::uint8_t expired = 0;
+    if(baseline) {
+        for(const auto& bullet : baseline->bullets)
+            if(!findSorted(current.bullets, bullet.key, &BulletState::key)) ++expired;
+    }
+
+    writer.Write<std::uint8_t>(expired);
+    if(baseline) {
+        for(const auto& bullet : baseline->bullets)
+            if(!findSorted(current.bullets, bullet.key, &BulletState::key)) writer.Write<std::uint64_t>(bullet.key);
+    }
+}
+
+bool net::ReadSnapshotHeader(ByteReader& reader, std::uint32_t& tick, std::uint32_t& baselineTick) {
+    tick = reader.Take<std::uint32_t>();
+    baselineTick = reader.Take<std::uint32_t>();
+    return reader.Ok();
+}
+
+bool net::ReadSnapshotBody(ByteReader& reader, const Snapshot* baseline, Snapshot& out) {
+    out.lastProcessedInput = reader.Take<std::uint32_t>();
+    out.players.clear();
+    out.bullets.clear();
+
+    if(baseline) {
+        out.players = baseline->players;
+        out.bullets = baseline->bullets;
+    }
+
+    const std::uint8_t changed = reader.Take<std::uint8_t>();
+    for(std::uint8_t i = 0; i < changed && reader.Ok(); ++i) {
+        const std::uint16_t id = reader.Take<std::uint16_t>();
+        const std::uint8_t mask = reader.Take<std::uint8_t>();
+
+        auto iter = std::lower_bound(out.players.begin(), out.players.end(), id,
+            [](const PlayerState& player, const std::uint16_t value) { return player.id < value; });
+
+        if(iter == out.players.end() || iter->id != id) {
+            PlayerState joined;
+            joined.id = id;
+            iter = out.players.insert(iter, joined);
+        }
+
+        PlayerState& player = *iter;
+        if(mask & FieldPosition) player.movement.pos = readVec(reader);
+        if(mask & FieldVelocity) player.movement.velocity = readVec(reader);
+        if(mask & FieldAim) player.flashlight.startAngle = reader.Take<float>();
+        if(mask & FieldLight) {
+            player.flashlight.fanWidth = reader.Take<float>();
+            player.flashlight.radius = reader.Take<float>();
+            player.flashlight.alpha = reader.Take<std::uint8_t>();
+            player.flashlight.isSwitchOn = reader.Take<std::uint8_t>() != 0;
+        }
+        if(mask & FieldAmmo) player.ammo = reader.Take<std::uint8_t>();
+    }
+
+    const std::uint8_t removed = reader.Take<std::uint8_t>();
+    for(std::uint8_t i = 0; i < removed && reader.Ok(); ++i) {
+        const std::uint16_t id = reader.Take<std::uint16_t>();
+        out.players.erase(
+            std::remove_if(out.players.begin(), out.players.end(),
+                [id](const PlayerState& player) { return player.id == id; }),
+            out.players.end());
+    }
+
+    const std::uint8_t spawned = reader.Take<std::uint8_t>();
+    for(std::uint8_t i = 0; i < spawned && reader.Ok(); ++i) {
+        BulletState bullet;
+        bullet.key = reader.Take<std::uint64_t>();
+        bullet.origin = readVec(reader);
+        bullet.direction = readVec(reader);
+        bullet.spawnTick = reader.Take<std::uint32_t>();
+
+        auto iter = std::lower_bound(out.bullets.begin(), out.bullets.end(), bullet.key,
+            [](const BulletState& item, const std::uint64_t value) { return item.key < value; });
+
+        if(iter == out.bullets.end() || iter->key != bullet.key)
+            out.bullets.insert(iter, bullet);
+    }
+
+    const std::uint8_t expired = reader.Take<std::uint8_t>();
+    for(std::uint8_t i = 0; i < expired && reader.Ok(); ++i) {
+        const std::uint64_t key = reader.Take<std::uint64_t>();
+        out.bullets.erase(
+            std::remove_if(out.bullets.begin(), out.bullets.end(),
+                [key](const BulletState& bullet) { return bullet.key == key; }),
+            out.bullets.end());
+    }
+
+    return reader.Ok();
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "ByteStream.hpp"
+#include "Movement.hpp"
+#include "FlashLight.hpp"
+#include "PlayerInput.hpp"
+
+namespace net {
+    constexpr std::uint32_t PROTOCOL_ID = 0x41474732;
+    constexpr unsigned short DEFAULT_PORT = 47810;
+    constexpr float TICK_RATE = 60.f;
+    constexpr float TICK_TIME = 1.f / TICK_RATE;
+    constexpr float TIMEOUT_SECONDS = 5.f;
+
+    constexpr std::size_t SNAPSHOT_HISTORY = 32;
+    constexpr std::size_t INPUT_REDUNDANCY = 4;
+    constexpr std::size_t MAX_PACKET_SIZE = 1200;
+
+    // Interest management: every client receives at most this many players and bullets,
+    // so per-client bandwidth does not grow with the total player count.
+    constexpr std::size_t MAX_SNAPSHOT_PLAYERS = 8;
+    constexpr std::size_t MAX_SNAPSHOT_BULLETS = 32;
+    constexpr float RELEVANCE_RADIUS = 2500.f;
+
+    // Encoded sizes of the snapshot pieces, for keeping a delta inside one datagram. The header
+    // is the message type, three ticks and the four entry counts.
+    constexpr std::size_t SNAPSHOT_HEADER_BYTES = 1 + 3 * 4 + 4;
+    constexpr std::size_t PLAYER_DELTA_MAX_BYTES = 2 + 1 + 8 + 8 + 4 + 4 + 4 + 1 + 1 + 1;
+    constexpr std::size_t REMOVED_PLAYER_BYTES = 2;
+    constexpr std::size_t SPAWNED_BULLET_BYTES = 8 + 8 + 8 + 4;
+    constexpr std::size_t EXPIRED_BULLET_BYTES = 8;
+
+    // Every player entry and every expiry always fits; spawned bullets get the rest of the packet.
+    constexpr std::size_t SNAPSHOT_FIXED_MAX_BYTES = SNAPSHOT_HEADER_BYTES
+        + MAX_SNAPSHOT_PLAYERS * (PLAYER_DELTA_MAX_BYTES + REMOVED_PLAYER_BYTES)
+        + MAX_SNAPSHOT_BULLETS * EXPIRED_BULLET_BYTES;
+    static_assert(SNAPSHOT_FIXED_MAX_BYTES + SPAWNED_BULLET_BYTES <= MAX_PACKET_SIZE,
+        "a worst-case snapshot must still fit at least one spawned bullet");
+
+    enum class MessageType : std::uint8_t {
+        Hello = 1,
+        Welcome,
+        Input,
+        Snapshot,
+        Bye
+    };
+
+    struct PlayerState {
+        std::uint16_t id = 0;
+        Movement::State movement{};
+        FlashLight::State flashlight{};
+        std::uint8_t ammo = 0;
+    };
+
+    struct BulletState {
+        std::uint64_t key = 0;
+        sf::Vector2f origin{0.f, 0.f};
+        sf::Vector2f direction{0.f, 0.f};
+        std::uint32_t spawnTick = 0;
+
+        // The full owner id and serial, so keys stay unique however many peers joined or shots were fired.
+        static std::uint64_t MakeKey(const std::uint16_t owner, const std::uint32_t serial) {
+            return (static_cast<std::uint64_t>(owner) << 32) | serial;
+        }
+
+        std::uint16_t GetOwner() const { return static_cast<std::uint16_t>(key >> 32); }
+        std::uint32_t GetSerial() const { return static_cast<std::uint32_t>(key); }
+    };
+
+    struct Snapshot {
+        std::uint32_t tick = 0;
+        std::uint32_t lastProcessedInput = 0;
+        std::vector<PlayerState> players;
+        std::vector<BulletState> bullets;
+
+        void Clear() {
+            tick = 0;
+            lastProcessedInput = 0;
+            players.clear();
+            bullets.clear();
+        }
+    };
+
+    // Packets are the raw little-endian bytes of each field, written with core::ByteWriter.
+    void WriteInputs(core::ByteWriter& writer, const std::uint32_t ackedTick, const InputCommand* inputs, const std::size_t count);
+    bool ReadInputs(core::ByteReader& reader, std::uint32_t& ackedTick, std::vector<InputCommand>& inputs);
+
+    // Drops spawned bullets from current until its delta against baseline fits MAX_PACKET_SIZE.
+    // Call it on the snapshot that is kept as a future baseline: the dropped bullets are then
+    // still missing from it and go out with the next snapshot instead.
+    void FitSnapshot(Snapshot& current, const Snapshot* baseline);
+
+    // Encodes current against baseline (nullptr sends everything). Only changed player fields,
+    // joined/left players and spawned/expired bullets are written; the decoder starts from its
+    // copy of the same baseline.
+    void WriteSnapshot(core::ByteWriter& writer, const Snapshot& current, const Snapshot* baseline);
+    bool ReadSnapshotHeader(core::ByteReader& reader, std::uint32_t& tick, std::uint32_t& baselineTick);
+    bool ReadSnapshotBody(core::ByteReader& reader, const Snapshot* baseline, Snapshot& out);
+}
@@ -8,6 +8,7 @@
 #include <string_view>
 
 #include "Component.hpp"
+#include "Transform.hpp"
 
 namespace core {
     class Object {
@@ -28,7 +29,13 @@ namespace core {
             return {};
         }
 
+        // Root of the object's attachments; render and collision read its world matrix.
+        Transform& GetTransform() { return transform; }
+        const Transform& GetTransform() const { return transform; }
+
     protected:
+        Transform transform;
+
         std::unordered_map<std::string, std::shared_ptr<Component>> components;
     };
 }
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include "AudioMixer.hpp"
+
+// Only the game links OpenAL, and only when vcpkg installed it for the `audio` feature. The
+// benchmarks leave this file out and mix into a NullAudioBackend.
+#if __has_include(<AL/al.h>) && __has_include(<AL/alc.h>)
+#define AUDIO_OPENAL
+#endif
+
+#if defined(AUDIO_OPENAL)
+#include <AL/al.h>
+#include <AL/alc.h>
+
+#include <algorithm>
+#include <iostream>
+
+using namespace core;
+
+namespace {
+    // Four blocks in flight: about 46 ms of latency at 44.1 kHz.
+    constexpr std::size_t STREAM_BUFFERS = 4;
+
+    class OpenAlBackend : public AudioBackend {
+    public:
+        bool Open(const unsigned sampleRate) override {
+            device = alcOpenDevice(nullptr);
+            if(!device) {
+                std::cerr << "[audio] no output device" << std::endl;
+                return false;
+            }
+
+            context = alcCreateContext(device, nullptr);
+            if(!context || !alcMakeContextCurrent(context)) {
+                std::cerr << "[audio] failed to create an OpenAL context" << std::endl;
+                Close();
+                return false;
+            }
+
+            this->sampleRate = sampleRate;
+            alGenSources(1, &source);
+            alGenBuffers(static_cast<ALsizei>(STREAM_BUFFERS), buffers);
+            return alGetError() == AL_NO_ERROR;
+        }
+
+        // Fills the next free buffer, waiting for the device to finish one when all are queued.
+        void Submit(const float* frames, const std::size_t frameCount) override {
+            pcm.resize(frameCount * 2);
+            for(std::size_t i = 0; i < pcm.size(); ++i)
+                pcm[i] = static_cast<ALshort>(std::clamp(frames[i], -1.f, 1.f) * 32767.f);
+
+            ALuint buffer = 0;
+            if(queued < STREAM_BUFFERS) {
+                buffer = buffers[queued++];
+            }
+            else {
+                ALint processed = 0;
+                while(alGetSourcei(source, AL_BUFFERS_PROCESSED, &processed), processed == 0)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+                alSourceUnqueueBuffers(source, 1, &buffer);
+            }
+
+            alBufferData(buffer, AL_FORMAT_STEREO16, pcm.data(),
+                static_cast<ALsizei>(pcm.size() * sizeof(ALshort)), static_cast<ALsizei>(sampleRate));
+            alSourceQueueBuffers(source, 1, &buffer);
+
+            // Also restarts the stream after an underrun.
+            ALint state = 0;
+            alGetSourcei(source, AL_SOURCE_STATE, &state);
+            if(state != AL_PLAYING) alSourcePlay(source);
+        }
+
+        void Close() override {
+            if(source) {
+                alSourceStop(source);
+                alDeleteSources(1, &source);
+                alDeleteBuffers(static_cast<ALsizei>(STREAM_BUFFERS), buffers);
+                source = 0;
+            }
+
+            alcMakeContextCurrent(nullptr);
+            if(context) alcDestroyContext(context);
+            if(device) alcCloseDevice(device);
+
+            context = nullptr;
+            device = nullptr;
+            queued = 0;
+        }
+
+    private:
+        ALCdevice* device = nullptr;
+        ALCcontext* context = nullptr;
+        ALuint source = 0;
+        ALuint buffers[STREAM_BUFFERS] = {};
+        std::size_t queued = 0;
+        unsigned sampleRate = 0;
+
+        std::vector<ALshort> pcm;
+    };
+}
+
+std::unique_ptr<AudioBackend> core::MakeDeviceBackend() {
+    return std::make_unique<OpenAlBackend>();
+}
+#else
+std::unique_ptr<core::AudioBackend> core::MakeDeviceBackend() {
+    return nullptr;
+}
+#endif
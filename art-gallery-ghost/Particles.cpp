@@ -0,0 +1,264 @@
+#include "Particles.hpp"
+#include "RenderStats.hpp"
+#include "MemoryStats.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define PARTICLES_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define PARTICLES_SSE2
+#endif
+
+using namespace core;
+
+constexpr float PI = 3.141592f;
+
+namespace {
+    // Pools are padded to this many floats so the vector loops never need a scalar tail.
+    constexpr std::size_t PAD = 8;
+
+    template <typename T>
+    using ParticleArray = std::vector<T, TaggedAllocator<T, MemoryTag::Particles>>;
+
+    // Spawn and ageing parameters shared by every particle of a kind.
+    struct ParticleStyle {
+        std::size_t capacity;
+        sf::Color color;
+        float size;
+        float minSpeed;
+        float maxSpeed;
+        float spread;       // degrees either side of the emit direction
+        float minLifetime;
+        float maxLifetime;
+        float drag;         // fraction of velocity lost per second
+        float rise;         // added to the y velocity per second
+    };
+
+    constexpr std::array<ParticleStyle, PARTICLE_KINDS> STYLES = {{
+        {16384, sf::Color{255, 220, 120}, 4.f, 300.f, 900.f, 12.f, 0.05f, 0.15f, 6.f, 0.f},
+        {32768, sf::Color{210, 210, 200}, 3.f, 150.f, 600.f, 70.f, 0.2f, 0.5f, 4.f, 0.f},
+        {65536, sf::Color{180, 220, 255, 160}, 6.f, 10.f, 60.f, 180.f, 0.8f, 2.f, 0.5f, -20.f},
+    }};
+
+    class ParticlePool {
+    public:
+        explicit ParticlePool(const ParticleStyle& style)
+            : style(style)
+            , xs(padded(style.capacity))
+            , ys(padded(style.capacity))
+            , vxs(padded(style.capacity))
+            , vys(padded(style.capacity))
+            , lives(padded(style.capacity))
+            , invLifetimes(padded(style.capacity)) {}
+
+        std::size_t GetCount() const { return count; }
+        std::size_t GetCapacity() const { return style.capacity; }
+        void Clear() { count = 0; }
+
+        void Spawn(const sf::Vector2f& position, const sf::Vector2f& direction, std::size_t spawnCount,
+                   std::uint32_t& seed) {
+            spawnCount = std::min(spawnCount, style.capacity - count);
+
+            const float heading = std::atan2(direction.y, direction.x);
+            const float spread = style.spread * PI / 180.f;
+
+            for(std::size_t n = 0; n < spawnCount; ++n, ++count) {
+                const float rad = heading + spread * (2.f * random(seed) - 1.f);
+                const float speed = style.minSpeed + (style.maxSpeed - style.minSpeed) * random(seed);
+                const float lifetime = style.minLifetime + (style.maxLifetime - style.minLifetime) * random(seed);
+
+                xs[count] = position.x;
+                ys[count] = position.y;
+                vxs[count] = std::cos(rad) * speed;
+                vys[count] = std::sin(rad) * speed;
+                lives[count] = lifetime;
+                invLifetimes[count] = 1.f / lifetime;
+            }
+        }
+
+        void Update(const float deltaTime) {
+            const float damping = std::max(0.f, 1.f - style.drag * deltaTime);
+            integrate(deltaTime, damping, style.rise * deltaTime);
+
+            // Swap-remove keeps the live range packed; order carries no meaning.
+            for(std::size_t i = 0; i < count;) {
+                if(lives[i] > 0.f) {
+                    ++i;
+                    continue;
+                }
+
+                --count;
+                xs[i] = xs[count];
+                ys[i] = ys[count];
+                vxs[i] = vxs[count];
+                vys[i] = vys[count];
+                lives[i] = lives[count];
+                invLifetimes[i] = invLifetimes[count];
+            }
+        }
+
+        // One triangle per particle, its alpha fading with the remaining lifetime.
+        sf::Vertex* Append(sf::Vertex* out) const {
+            const float size = style.size;
+            const sf::Vector2f top{0.f, -size};
+            const sf::Vector2f right{0.866f * size, 0.5f * size};
+            const sf::Vector2f left{-0.866f * size, 0.5f * size};
+
+            sf::Color color = style.color;
+            const float alpha = static_cast<float>(style.color.a);
+
+            for(std::size_t i = 0; i < count; ++i) {
+                const sf::Vector2f position{xs[i], ys[i]};
+                color.a = static_cast<std::uint8_t>(alpha * std::min(1.f, lives[i] * invLifetimes[i]));
+
+                *out++ = sf::Vertex{position + top, color};
+                *out++ = sf::Vertex{position + right, color};
+                *out++ = sf::Vertex{position + left, color};
+            }
+
+            return out;
+        }
+
+    private:
+        const ParticleStyle& style;
+        std::size_t count = 0;
+
+        ParticleArray<float> xs;
+        ParticleArray<float> ys;
+        ParticleArray<float> vxs;
+        ParticleArray<float> vys;
+        ParticleArray<float> lives;
+        ParticleArray<float> invLifetimes;
+
+        static std::size_t padded(const std::size_t capacity) { return (capacity + PAD - 1) / PAD * PAD; }
+
+        // xorshift32 mapped to [0, 1); effects only need to look random.
+        static float random(std::uint32_t& seed) {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            return static_cast<float>(seed >> 8) * (1.f / 16777216.f);
+        }
+
+        // Lanes past `count` hold stale data inside the padding and are integrated harmlessly.
+        void integrate(const float deltaTime, const float damping, const float rise) {
+#if defined(PARTICLES_AVX2)
+            const __m256 dt = _mm256_set1_ps(deltaTime);
+            const __m256 damp = _mm256_set1_ps(damping);
+            const __m256 up = _mm256_set1_ps(rise);
+
+            for(std::size_t i = 0; i < count; i += 8) {
+                const __m256 vx = _mm256_mul_ps(_mm256_loadu_ps(&vxs[i]), damp);
+                const __m256 vy = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&vys[i]), damp), up);
+
+                _mm256_storeu_ps(&vxs[i], vx);
+                _mm256_storeu_ps(&vys[i], vy);
+                _mm256_storeu_ps(&xs[i], _mm256_add_ps(_mm256_loadu_ps(&xs[i]), _mm256_mul_ps(vx, dt)));
+                _mm256_storeu_ps(&ys[i], _mm256_add_ps(_mm256_loadu_ps(&ys[i]), _mm256_mul_ps(vy, dt)));
+                _mm256_storeu_ps(&lives[i], _mm256_sub_ps(_mm256_loadu_ps(&lives[i]), dt));
+            }
+#elif defined(PARTICLES_SSE2)
+            const __m128 dt = _mm_set1_ps(deltaTime);
+            const __m128 damp = _mm_set1_ps(damping);
+            const __m128 up = _mm_set1_ps(rise);
+
+            for(std::size_t i = 0; i < count; i += 4) {
+                const __m128 vx = _mm_mul_ps(_mm_loadu_ps(&vxs[i]), damp);
+                const __m128 vy = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&vys[i]), damp), up);
+
+                _mm_storeu_ps(&vxs[i], vx);
+                _mm_storeu_ps(&vys[i], vy);
+                _mm_storeu_ps(&xs[i], _mm_add_ps(_mm_loadu_ps(&xs[i]), _mm_mul_ps(vx, dt)));
+                _mm_storeu_ps(&ys[i], _mm_add_ps(_mm_loadu_ps(&ys[i]), _mm_mul_ps(vy, dt)));
+                _mm_storeu_ps(&lives[i], _mm_sub_ps(_mm_loadu_ps(&lives[i]), dt));
+            }
+#else
+            for(std::size_t i = 0; i < count; ++i) {
+                vxs[i] *= damping;
+                vys[i] = vys[i] * damping + rise;
+                xs[i] += vxs[i] * deltaTime;
+                ys[i] += vys[i] * deltaTime;
+                lives[i] -= deltaTime;
+            }
+#endif
+        }
+    };
+
+    struct ParticleWorld {
+        std::array<ParticlePool, PARTICLE_KINDS> pools{
+            ParticlePool(STYLES[0]), ParticlePool(STYLES[1]), ParticlePool(STYLES[2])};
+
+        ParticleArray<sf::Vertex> stream;
+        std::uint32_t seed = 0x9E3779B9u;
+        bool emitting = false;
+    };
+
+    ParticleWorld& world() {
+        static ParticleWorld instance;
+        return instance;
+    }
+
+    ParticlePool& pool(const ParticleKind kind) { return world().pools[static_cast<std::size_t>(kind)]; }
+}
+
+void Particles::SetEmitting(const bool emitting) {
+    world().emitting = emitting;
+}
+
+void Particles::Emit(const ParticleKind kind, const sf::Vector2f& position, const sf::Vector2f& direction,
+                     const std::size_t count) {
+    ParticleWorld& particles = world();
+    if(!particles.emitting) return;
+
+    pool(kind).Spawn(position, direction, count, particles.seed);
+}
+
+void Particles::Update(const float deltaTime) {
+    for(auto& pool : world().pools)
+        pool.Update(deltaTime);
+}
+
+void Particles::Draw(sf::RenderTarget& target) {
+    ParticleWorld& particles = world();
+
+    const std::size_t vertices = GetCount() * 3;
+    if(vertices == 0) return;
+
+    // Grows to the peak particle count once and is reused afterwards.
+    if(particles.stream.size() < vertices)
+        particles.stream.resize(vertices);
+
+    sf::Vertex* out = particles.stream.data();
+    for(const auto& pool : particles.pools)
+        out = pool.Append(out);
+
+    target.draw(particles.stream.data(), vertices, sf::PrimitiveType::Triangles);
+    CountDraw(vertices);
+}
+
+void Particles::Clear() {
+    for(auto& pool : world().pools)
+        pool.Clear();
+}
+
+std::size_t Particles::GetCount() {
+    std::size_t count = 0;
+    for(const auto& pool : world().pools)
+        count += pool.GetCount();
+
+    return count;
+}
+
+std::size_t Particles::GetCount(const ParticleKind kind) {
+    return pool(kind).GetCount();
+}
+
+std::size_t Particles::GetCapacity(const ParticleKind kind) {
+    return pool(kind).GetCapacity();
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace core {
+    enum class ParticleKind : std::uint8_t {
+        MuzzleFlash,
+        Impact,
+        Ghost,
+    };
+
+    constexpr std::size_t PARTICLE_KINDS = 3;
+
+    // Cosmetic particles kept out of the Object/Component model. Each kind owns a preallocated
+    // structure-of-arrays pool with live particles packed at the front, so a frame is one vector
+    // pass over floats per kind plus a single draw call for everything.
+    class Particles {
+    public:
+        // Off by default so the server and headless tools never pay for effects.
+        static void SetEmitting(const bool emitting);
+
+        // Spawns up to `count` particles heading along `direction` within the kind's spread.
+        // Particles that do not fit in the pool are dropped.
+        static void Emit(const ParticleKind kind, const sf::Vector2f& position, const sf::Vector2f& direction,
+                         const std::size_t count);
+
+        static void Update(const float deltaTime);
+        static void Draw(sf::RenderTarget& target);
+        static void Clear();
+
+        static std::size_t GetCount();
+        static std::size_t GetCount(const ParticleKind kind);
+        static std::size_t GetCapacity(const ParticleKind kind);
+    };
+}
@@ -0,0 +1,59 @@
+#include "Physics.hpp"
+
+#include "Movement.hpp"
+#include "Collision.hpp"
+#include "Gun.hpp"
+#include "Player.hpp"
+#include "DistanceField.hpp"
+
+void core::ResolveMapCollision(Movement& movement, const DistanceField& walls, const float deltaTime) {
+    if (!walls.IsBaked()) return;
+
+    const sf::Vector2f offset{Player::SHAPE_RADIUS, Player::SHAPE_RADIUS};
+    const sf::Vector2f center = movement.GetPos() + offset;
+    const sf::Vector2f velocity = movement.GetVel();
+    const DistanceSample here = walls.Sample(center);
+
+    // Already inside a wall: back onto the floor, keeping only the velocity along the surface.
+    if (here.distance < 0.f) {
+        movement.SetPos(center + here.normal * (Player::SHAPE_RADIUS + 2.f - here.distance) - offset);
+
+        const sf::Vector2f tangent{-here.normal.y, here.normal.x};
+        const float tangentSpeed = velocity.x * tangent.x + velocity.y * tangent.y;
+        movement.SetVel(tangent * tangentSpeed * 0.8f);
+        return;
+    }
+
+    const float minDistance = Player::SHAPE_RADIUS + 1.f;
+    const DistanceSample next = walls.Sample(center + velocity * deltaTime);
+    if (next.distance >= minDistance) return;
+
+    // Slide: drop the part of the velocity heading into the wall and keep the body clear of it.
+    const float intoWall = velocity.x * next.normal.x + velocity.y * next.normal.y;
+    if (intoWall < 0.f)
+        movement.SetVel(velocity - next.normal * intoWall);
+
+    if (here.distance < minDistance)
+        movement.SetPos(center + here.normal * (minDistance - here.distance) - offset);
+}
+
+void core::CullBullets(Gun& gun, const Collision& map, BulletScratch& scratch) {
+    const auto& bullets = gun.GetBullets();
+    const std::size_t bulletCount = bullets.size();
+
+    scratch.xs.resize(bulletCount);
+    scratch.ys.resize(bulletCount);
+    scratch.inside.resize(bulletCount);
+
+    for (size_t i = 0; i < bulletCount; ++i) {
+        scratch.xs[i] = bullets[i].position.x + Gun::BULLET_RADIUS;
+        scratch.ys[i] = bullets[i].position.y + Gun::BULLET_RADIUS;
+    }
+
+    map.ContainsPoints(scratch.xs.data(), scratch.ys.data(), bulletCount, scratch.inside.data());
+
+    for (size_t i = 0; i < bulletCount; ++i) {
+        if (bullets[i].active && !scratch.inside[i])
+            gun.DeactivateBullet(i);
+    }
+}
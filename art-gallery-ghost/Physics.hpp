@@ -0,0 +1,24 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstdint>
+#include <vector>
+
+class Movement;
+class Collision;
+class Gun;
+
+namespace core {
+    class DistanceField;
+
+    struct BulletScratch {
+        std::vector<float> xs;
+        std::vector<float> ys;
+        std::vector<std::uint8_t> inside;
+    };
+
+    // Pushes a player that ended up in a wall back out and slides it along walls it runs into.
+    void ResolveMapCollision(Movement& movement, const DistanceField& walls, const float deltaTime);
+    void CullBullets(Gun& gun, const Collision& map, BulletScratch& scratch);
+}
@@ -6,10 +6,14 @@
 #include "Collision.hpp"
 #include "Gun.hpp"
 #include "FlashLight.hpp"
+#include "Tessellation.hpp"
 
 using namespace core;
 
 Player::Player(const float x, const float y) {
+    center.SetParent(&transform);
+    center.SetPosition({SHAPE_RADIUS, SHAPE_RADIUS});
+
     this->AddComponent(std::make_unique<Movement>(
         this,
         sf::Vector2f{x, y}));
@@ -19,27 +23,40 @@ Player::Player(const float x, const float y) {
     sf::CircleShape shape(SHAPE_RADIUS);
     shape.setFillColor(PLAYER_COLOR);
 
-    this->AddComponent(std::make_unique<Render>(
-        this,
-        std::make_unique<sf::CircleShape>(shape)));
+    this->AddComponent(std::make_unique<Render>(this, shape));
 
     this->AddComponent(std::make_unique<Collision>(this));
 
-    this->AddComponent(std::make_unique<Gun>(this));
-    this->AddComponent(std::make_unique<FlashLight>(this));
+    auto gun = std::make_unique<Gun>(this);
+    gun->Mount(&center);
+    this->AddComponent(std::move(gun));
+
+    auto flashlight = std::make_unique<FlashLight>(this);
+    flashlight->Mount(&center);
+    this->AddComponent(std::move(flashlight));
 }
 
 void Player::Update(const float deltaTime) {
-    auto movement = std::dynamic_pointer_cast<Movement>(this->GetComponent("movement").lock());
-    auto render = std::dynamic_pointer_cast<Render>(this->GetComponent("render").lock());
-
-    if(movement && render) {
-        sf::CircleShape* circle = render->GetShape<sf::CircleShape>();
-        if(circle) circle->setPosition(movement->GetPos());
-    }
-
     this->components["movement"]->Update(deltaTime);
     this->components["collision"]->Update(deltaTime);
     this->components["gun"]->Update(deltaTime);
     this->components["flashlight"]->Update(deltaTime);
-}
\ No newline at end of file
+}
+
+void Player::Draw(sf::RenderTarget& target, const std::optional<sf::Vector2f>& aim) {
+    if(auto render = std::dynamic_pointer_cast<Render>(this->GetComponent("render").lock())) {
+        if(auto circle = render->GetShape<sf::CircleShape>())
+            FitCircle(*circle, target);
+
+        render->Draw(target);
+    }
+
+    auto flashlight = std::dynamic_pointer_cast<FlashLight>(this->GetComponent("flashlight").lock());
+    if(flashlight && flashlight->GetSwitch()) {
+        flashlight->Render(target, aim);
+    }
+
+    auto gun = std::dynamic_pointer_cast<Gun>(this->GetComponent("gun").lock());
+    if(gun && gun->HasActiveBullets())
+        gun->Render(target);
+}
@@ -5,6 +5,7 @@
 #include "Object.hpp"
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 class Player : public core::Object {
@@ -18,4 +19,13 @@ public:
     Player(const float x, const float y);
 
     void Update(const float deltaTime) override;
+
+    // Body, flashlight cone and bullets. `aim` overrides the drawn flashlight direction.
+    void Draw(sf::RenderTarget& target, const std::optional<sf::Vector2f>& aim = std::nullopt);
+
+    // Middle of the body; the gun and flashlight are mounted here.
+    const core::Transform& GetCenter() const { return center; }
+
+private:
+    core::Transform center;
 };
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "PlayerInput.hpp"
+
+#include "Player.hpp"
+#include "Movement.hpp"
+#include "Gun.hpp"
+#include "FlashLight.hpp"
+
+#include <cmath>
+
+using namespace core;
+
+constexpr float PI = 3.141592f;
+
+sf::Vector2f InputCommand::GetVelocity() const {
+    sf::Vector2f velocity{0.f, 0.f};
+
+    if(IsDown(Up))
+        velocity.y -= Player::MOVE_SPEED;
+    if(IsDown(Down))
+        velocity.y += Player::MOVE_SPEED;
+    if(IsDown(Left))
+        velocity.x -= Player::MOVE_SPEED;
+    if(IsDown(Right))
+        velocity.x += Player::MOVE_SPEED;
+
+    return velocity;
+}
+
+void ApplyInput(Player& player, const InputCommand& input, const bool replay) {
+    auto movement = std::dynamic_pointer_cast<Movement>(player.GetComponent("movement").lock());
+    auto gun = std::dynamic_pointer_cast<Gun>(player.GetComponent("gun").lock());
+    auto flashlight = std::dynamic_pointer_cast<FlashLight>(player.GetComponent("flashlight").lock());
+
+    if(!movement) return;
+
+    movement->SetVel(input.GetVelocity());
+
+    if(gun) {
+        if(input.IsDown(InputCommand::Reload))
+            gun->Reload();
+
+        if(input.IsDown(InputCommand::Fire)) {
+            if(replay) gun->SetAmmo(gun->GetAmmo() - 1);
+            else gun->Fire(input.aim);
+        }
+    }
+
+    if(flashlight) {
+        if(input.IsDown(InputCommand::ToggleLight))
+            flashlight->ToggleSwitch();
+
+        if(input.wheel != 0.f && flashlight->GetSwitch()) {
+            flashlight->AdjustRadius(input.wheel);
+            flashlight->AdjustWidth(-input.wheel);
+            flashlight->AdjustAlpha(static_cast<int>(input.wheel));
+        }
+
+        sf::Vector2f direction = input.aim - player.GetCenter().GetWorldPosition();
+
+        flashlight->SetAngles(std::atan2(direction.y, direction.x) * 180.0f / PI);
+    }
+}
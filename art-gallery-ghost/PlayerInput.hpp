@@ -0,0 +1,31 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstdint>
+
+class Player;
+
+struct InputCommand {
+    enum Button : std::uint8_t {
+        Up = 1 << 0,
+        Down = 1 << 1,
+        Left = 1 << 2,
+        Right = 1 << 3,
+        Fire = 1 << 4,
+        ToggleLight = 1 << 5,
+        Reload = 1 << 6
+    };
+
+    std::uint32_t sequence = 0;
+    std::uint8_t buttons = 0;
+    sf::Vector2f aim{0.f, 0.f};
+    float wheel = 0.f;
+
+    bool IsDown(const Button button) const { return (buttons & button) != 0; }
+    sf::Vector2f GetVelocity() const;
+};
+
+// Applies one tick of input to the player's components. A replayed command (client-side
+// reconciliation) restores state changes but never spawns bullets a second time.
+void ApplyInput(Player& player, const InputCommand& input, const bool replay = false);
@@ -0,0 +1,24 @@
+#include "PolygonShape.hpp"
+
+using namespace core;
+
+PolygonShape::PolygonShape(PolygonWithHoles polygon) {
+    std::vector<sf::Vector2f> corners;
+    valid = Triangulate(polygon, corners);
+
+    triangles.resize(corners.size());
+    for (std::size_t i = 0; i < corners.size(); ++i)
+        triangles[i].position = corners[i];
+
+    MergeConvexPieces(corners, pieces);
+
+    rings.reserve(polygon.holes.size() + 1);
+    rings.push_back(std::move(polygon.outer));
+    for (auto& hole : polygon.holes)
+        rings.push_back(std::move(hole));
+}
+
+void PolygonShape::SetFillColor(const sf::Color& color) {
+    for (std::size_t i = 0; i < triangles.getVertexCount(); ++i)
+        triangles[i].color = color;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <vector>
+
+#include "Triangulation.hpp"
+
+// Concave polygon with holes, triangulated and split into convex pieces once at construction.
+class PolygonShape : public sf::Drawable {
+public:
+    explicit PolygonShape(core::PolygonWithHoles polygon);
+
+    void SetFillColor(const sf::Color& color);
+
+    bool IsValid() const { return valid; }
+
+    // Ring 0 is the outer boundary, the rest are holes.
+    const std::vector<core::Ring>& GetRings() const { return rings; }
+    const std::vector<core::Ring>& GetConvexPieces() const { return pieces; }
+    std::size_t GetTriangleCount() const { return triangles.getVertexCount() / 3; }
+
+private:
+    std::vector<core::Ring> rings;
+    std::vector<core::Ring> pieces;
+    sf::VertexArray triangles{sf::PrimitiveType::Triangles};
+    bool valid = false;
+
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override {
+        target.draw(triangles, states);
+    }
+};
@@ -3,10 +3,26 @@
 #include <SFML/Graphics.hpp>
 
 #include "Component.hpp"
+#include "Object.hpp"
+#include "PolygonShape.hpp"
+#include "WallShape.hpp"
+#include "RenderStats.hpp"
+
+#include <variant>
+
+namespace core {
+    // Closed set of shapes an object can be drawn and collided as. Adding an alternative is a
+    // compile error wherever a std::visit or the collision dispatch table has no handler for it.
+    using RenderShape = std::variant<sf::CircleShape, sf::RectangleShape, sf::ConvexShape, PolygonShape, WallShape>;
+
+    // Names a shape kind in overload sets without constructing one.
+    template <typename T>
+    struct ShapeTag {};
+}
 
 class Render : public core::Component {
 public:
-    Render(core::Object* obj, std::unique_ptr<sf::Drawable> shape)
+    Render(core::Object* obj, core::RenderShape shape)
         : core::Component(obj)
         , shape(std::move(shape)) {}
 
@@ -15,14 +31,38 @@ public:
     std::string_view GetTag() const override { return tag; }
 
     template <typename T>
-    T* GetShape() const { return dynamic_cast<T*>(shape.get()); }
+    T* GetShape() { return std::get_if<T>(&shape); }
+
+    template <typename T>
+    const T* GetShape() const { return std::get_if<T>(&shape); }
 
-    void Draw(sf::RenderWindow& window) {
-        if(shape) window.draw(*shape);
+    const core::RenderShape& GetShapeVariant() const { return shape; }
+
+    // Shapes are stored in local space and placed by the owner's cached world transform.
+    void Draw(sf::RenderTarget& target) {
+        sf::RenderStates states;
+        states.transform = owner->GetTransform().GetWorld();
+
+        std::visit([&target, &states](const auto& drawable) {
+            target.draw(drawable, states);
+            countDraw(drawable);
+        }, shape);
     }
 
 private:
     constexpr static std::string_view tag = "render";
 
-    std::unique_ptr<sf::Drawable> shape;
-};
\ No newline at end of file
+    core::RenderShape shape;
+
+    static void countDraw(const PolygonShape& polygon) { core::CountDraw(polygon.GetTriangleCount() * 3); }
+    static void countDraw(const sf::Shape& basic) { core::CountShape(basic); }
+
+    // The floor quad, then one draw per render chunk that still has wall in it.
+    static void countDraw(const WallShape& walls) {
+        core::CountDraw(4);
+        for (std::size_t chunk = 0; chunk < walls.GetChunkCount(); ++chunk) {
+            if (const std::size_t vertices = walls.GetChunkVertexCount(chunk))
+                core::CountDraw(vertices);
+        }
+    }
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace core {
+    // Draw calls and vertices submitted by the game's draw paths since the last reset.
+    struct RenderStats {
+        std::uint64_t drawCalls = 0;
+        std::uint64_t vertices = 0;
+    };
+
+    inline RenderStats renderStats;
+
+    inline void CountDraw(const std::size_t vertices) {
+        ++renderStats.drawCalls;
+        renderStats.vertices += vertices;
+    }
+
+    // SFML draws a shape's fill as a fan and, when it has one, its outline as a separate strip.
+    inline void CountShape(const sf::Shape& shape) {
+        const std::size_t points = shape.getPointCount();
+        CountDraw(points + 2);
+
+        if(shape.getOutlineThickness() != 0.f)
+            CountDraw((points + 1) * 2);
+    }
+}
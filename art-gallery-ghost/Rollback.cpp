@@ -0,0 +1,56 @@
+#include "Rollback.hpp"
+
+#include "Player.hpp"
+#include "Map.hpp"
+
+void core::CaptureWorld(const Player& player, const Map* map, const std::uint32_t tick, WorldState& state) {
+    state.tick = tick;
+    state.mapSeed = map ? map->GetSeed() : 0;
+    state.wallRevision = map ? map->GetWallRevision() : 0;
+
+    if(auto movement = std::dynamic_pointer_cast<Movement>(player.GetComponent("movement").lock()))
+        state.movement = movement->GetState();
+
+    if(auto flashlight = std::dynamic_pointer_cast<FlashLight>(player.GetComponent("flashlight").lock()))
+        state.flashlight = flashlight->GetState();
+
+    if(auto gun = std::dynamic_pointer_cast<Gun>(player.GetComponent("gun").lock()))
+        gun->GetState(state.gun);
+}
+
+void core::RestoreWorld(Player& player, const WorldState& state) {
+    if(auto movement = std::dynamic_pointer_cast<Movement>(player.GetComponent("movement").lock()))
+        movement->SetState(state.movement);
+
+    if(auto flashlight = std::dynamic_pointer_cast<FlashLight>(player.GetComponent("flashlight").lock()))
+        flashlight->SetState(state.flashlight);
+
+    if(auto gun = std::dynamic_pointer_cast<Gun>(player.GetComponent("gun").lock()))
+        gun->SetState(state.gun);
+}
+
+bool core::SameWorld(const WorldState& lhs, const WorldState& rhs) {
+    if(lhs.movement.pos != rhs.movement.pos || lhs.movement.velocity != rhs.movement.velocity)
+        return false;
+
+    if(lhs.flashlight.fanWidth != rhs.flashlight.fanWidth
+        || lhs.flashlight.radius != rhs.flashlight.radius
+        || lhs.flashlight.startAngle != rhs.flashlight.startAngle
+        || lhs.flashlight.alpha != rhs.flashlight.alpha
+        || lhs.flashlight.isSwitchOn != rhs.flashlight.isSwitchOn)
+        return false;
+
+    if(lhs.gun.ammo != rhs.gun.ammo || lhs.gun.bulletCount != rhs.gun.bulletCount)
+        return false;
+
+    for(std::uint32_t i = 0; i < lhs.gun.bulletCount; ++i) {
+        const Gun::Bullet& left = lhs.gun.bullets[i];
+        const Gun::Bullet& right = rhs.gun.bullets[i];
+
+        if(left.position != right.position || left.direction != right.direction || left.lifetime != right.lifetime
+            || left.active != right.active || left.serial != right.serial)
+            return false;
+    }
+
+    return lhs.gun.nextSerial == rhs.gun.nextSerial && lhs.mapSeed == rhs.mapSeed && lhs.wallRevision == rhs.wallRevision;
+}
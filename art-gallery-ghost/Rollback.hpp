@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#include "Movement.hpp"
+#include "FlashLight.hpp"
+#include "Gun.hpp"
+#include "PlayerInput.hpp"
+
+class Player;
+class Map;
+
+namespace core {
+    // Everything the simulation needs to resume from a tick, as one flat block.
+    struct WorldState {
+        std::uint32_t tick = 0;
+        std::uint32_t mapSeed = 0;
+        // Map::GetWallRevision; restoring rewinds the walls to it.
+        std::uint32_t wallRevision = 0;
+        Movement::State movement{};
+        FlashLight::State flashlight{};
+        Gun::State gun{};
+    };
+
+    static_assert(std::is_trivially_copyable_v<WorldState>, "WorldState must stay memcpy-able");
+
+    void CaptureWorld(const Player& player, const Map* map, const std::uint32_t tick, WorldState& state);
+    void RestoreWorld(Player& player, const WorldState& state);
+    bool SameWorld(const WorldState& lhs, const WorldState& rhs);
+
+    // Preallocated ring of the last CAPACITY ticks and the inputs that produced them.
+    class RollbackBuffer {
+    public:
+        constexpr static std::size_t CAPACITY = 16;
+
+        WorldState& Slot(const std::uint32_t tick) { return states[tick % CAPACITY]; }
+
+        const WorldState* Find(const std::uint32_t tick) const {
+            const WorldState& state = states[tick % CAPACITY];
+            return state.tick == tick ? &state : nullptr;
+        }
+
+        void RecordInput(const std::uint32_t tick, const InputCommand& input) { inputs[tick % CAPACITY] = input; }
+        const InputCommand& GetInput(const std::uint32_t tick) const { return inputs[tick % CAPACITY]; }
+
+    private:
+        std::array<WorldState, CAPACITY> states{};
+        std::array<InputCommand, CAPACITY> inputs{};
+    };
+}
@@ -0,0 +1,34 @@
+#include "ScriptedInput.hpp"
+
+using namespace core;
+
+InputCommand ScriptedInput::Next(const float tickTime, const sf::Vector2f& position) {
+    timer -= tickTime;
+
+    InputCommand input;
+    input.sequence = ++sequence;
+
+    if(timer <= 0.f) {
+        std::uniform_real_distribution<float> duration(0.5f, 2.5f);
+        std::uniform_int_distribution<int> direction(0, 15);
+
+        timer = duration(rng);
+        buttons = static_cast<std::uint8_t>(direction(rng));
+
+        if(direction(rng) < 6)
+            input.buttons |= InputCommand::Fire;
+        if(direction(rng) == 0)
+            input.buttons |= InputCommand::Reload | InputCommand::ToggleLight;
+    }
+
+    std::uniform_real_distribution<float> aim(-500.f, 500.f);
+    input.buttons |= buttons;
+    input.aim = position + sf::Vector2f{aim(rng), aim(rng)};
+
+    return input;
+}
+
+sf::Vector2f ScriptedInput::SpawnOffset(const float radius) {
+    std::uniform_real_distribution<float> offset(-radius, radius);
+    return {offset(rng), offset(rng)};
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstdint>
+#include <random>
+
+#include "PlayerInput.hpp"
+
+namespace core {
+    // Plays like the server's bots: walks one way for a random while, fires now and then and aims
+    // around the player. The server drives its bots with it and the batch runner its worlds, so
+    // the two cannot drift apart. The same seed always produces the same inputs.
+    class ScriptedInput {
+    public:
+        explicit ScriptedInput(const std::uint32_t seed) : rng(seed) {}
+
+        // One tick of `tickTime` seconds for a player standing at `position`.
+        InputCommand Next(const float tickTime, const sf::Vector2f& position);
+
+        // Drawn from the same stream, so where a bot starts follows from its seed too.
+        sf::Vector2f SpawnOffset(const float radius);
+
+    private:
+        std::mt19937 rng;
+        float timer = 0.f;
+        std::uint8_t buttons = 0;
+        std::uint32_t sequence = 0;
+    };
+}
@@ -0,0 +1,377 @@
+#include "Server.hpp"
+
+#include "Map.hpp"
+#include "Player.hpp"
+#include "Movement.hpp"
+#include "Collision.hpp"
+#include "Gun.hpp"
+#include "FlashLight.hpp"
+#include "EventLog.hpp"
+#include "MemoryStats.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+using namespace net;
+
+namespace {
+    constexpr float BOT_SPAWN_RADIUS = 1500.f;
+
+    std::int64_t makeCellKey(const std::int64_t cellX, const std::int64_t cellY) {
+        return (cellX << 32) ^ (cellY & 0xFFFFFFFF);
+    }
+
+    std::uint64_t makeEndpointKey(const sf::IpAddress& address, const unsigned short port) {
+        return (static_cast<std::uint64_t>(address.toInteger()) << 16) | port;
+    }
+
+    std::int64_t cellCoord(const float value) {
+        return static_cast<std::int64_t>(std::floor(value / RELEVANCE_RADIUS));
+    }
+
+    sf::Vector2f positionOf(const Player& player) {
+        auto movement = std::dynamic_pointer_cast<Movement>(player.GetComponent("movement").lock());
+        return movement ? movement->GetPos() : sf::Vector2f{0.f, 0.f};
+    }
+}
+
+Server::Peer::Peer(const std::uint16_t id, const sf::IpAddress& address, const unsigned short port)
+    : id(id)
+    , address(address)
+    , port(port)
+    , bot(id) {}
+
+Server::Server(const unsigned short port, const std::size_t botCount, const bool printStats)
+    : port(port)
+    , botCount(botCount)
+    , printStats(printStats) {}
+
+Server::~Server() = default;
+
+bool Server::Start() {
+    if(socket.bind(port) != sf::Socket::Status::Done) {
+        std::cerr << "[server] cannot bind UDP port " << port << std::endl;
+        return false;
+    }
+
+    socket.setBlocking(false);
+
+    map = std::make_unique<Map>(Map::DEFAULT_SIZE, std::random_device{}());
+    mapCollision = std::dynamic_pointer_cast<Collision>(map->GetComponent("collision").lock());
+
+    for(std::size_t i = 0; i < botCount; ++i)
+        addPeer(sf::IpAddress::LocalHost, 0, true);
+
+    running = true;
+
+    std::cout << "[server] listening on UDP " << port
+        << ", map seed " << map->GetSeed()
+        << ", " << botCount << " bots" << std::endl;
+
+    return true;
+}
+
+void Server::Run() {
+    using Clock = std::chrono::steady_clock;
+
+    const auto tickDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(TICK_TIME));
+    auto nextTick = Clock::now();
+    auto nextReport = nextTick + std::chrono::seconds(1);
+
+    while(running) {
+        Tick();
+
+        if(printStats && Clock::now() >= nextReport) {
+            const std::size_t clients = static_cast<std::size_t>(std::count_if(peers.begin(), peers.end(),
+                [](const std::unique_ptr<Peer>& peer) { return !peer->isBot; }));
+
+            const double ticks = static_cast<double>(std::max<std::size_t>(stats.ticks, 1));
+            const double snapshots = static_cast<double>(std::max<std::size_t>(stats.snapshots, 1));
+
+            std::cout << "[server] tick " << tick
+                << " | players " << peers.size() << " (" << clients << " remote)"
+                << " | tick cost " << stats.tickMicros / ticks << " us"
+                << " | snapshot " << stats.snapshotBytes / snapshots << " B avg, "
+                << stats.maxSnapshotBytes << " B max"
+                << " | " << (clients ? stats.snapshotBytes / clients : 0) << " B/s per client"
+                << " | " << stats.allocations / ticks << " allocs/tick"
+                << std::endl;
+
+            stats.Reset();
+            nextReport += std::chrono::seconds(1);
+        }
+
+        nextTick += tickDuration;
+        std::this_thread::sleep_until(nextTick);
+    }
+}
+
+void Server::Tick() {
+    const auto start = std::chrono::steady_clock::now();
+    core::MemoryScope scope(core::MemoryTag::Gameplay);
+
+    {
+        core::MemoryScope network(core::MemoryTag::Network);
+        receivePackets();
+    }
+
+    for(auto& peer : peers) {
+        if(peer->isBot) driveBot(*peer);
+        else peer->silence += TICK_TIME;
+    }
+
+    peers.erase(
+        std::remove_if(peers.begin(), peers.end(),
+            [this](const std::unique_ptr<Peer>& peer) {
+                if(peer->isBot || peer->silence <= TIMEOUT_SECONDS) return false;
+
+                core::EventLog::Emit(core::Event::PlayerLeft, peer->id, peer->silence);
+                endpoints.erase(makeEndpointKey(peer->address, peer->port));
+                return true;
+            }),
+        peers.end());
+
+    for(auto& peer : peers) {
+        auto gun = std::dynamic_pointer_cast<Gun>(peer->player->GetComponent("gun").lock());
+        if(!gun) continue;
+
+        gun->Update(TICK_TIME);
+        if(mapCollision) core::CullBullets(*gun, *mapCollision, bulletScratch);
+    }
+
+    ++tick;
+
+    buildRelevanceGrid();
+
+    {
+        core::MemoryScope network(core::MemoryTag::Network);
+        for(auto& peer : peers) {
+            if(!peer->isBot) sendSnapshot(*peer);
+        }
+    }
+
+    core::EndMemoryFrame();
+    for(std::size_t tag = 0; tag < core::MEMORY_TAG_COUNT; ++tag)
+        stats.allocations += core::GetMemoryStats(static_cast<core::MemoryTag>(tag)).frameAllocations;
+
+    ++stats.ticks;
+    stats.tickMicros += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+Server::Peer* Server::findPeer(const sf::IpAddress& address, const unsigned short port) {
+    const auto iter = endpoints.find(makeEndpointKey(address, port));
+    return iter != endpoints.end() ? iter->second : nullptr;
+}
+
+Server::Peer& Server::addPeer(const sf::IpAddress& address, const unsigned short port, const bool isBot) {
+    auto peer = std::make_unique<Peer>(nextPeerId++, address, port);
+    peer->isBot = isBot;
+
+    sf::Vector2f spawn{0.f, 0.f};
+    if(isBot) spawn = peer->bot.SpawnOffset(BOT_SPAWN_RADIUS);
+
+    peer->player = std::make_unique<Player>(spawn.x, spawn.y);
+
+    if(!isBot) endpoints.emplace(makeEndpointKey(address, port), peer.get());
+
+    peers.emplace_back(std::move(peer));
+    return *peers.back();
+}
+
+void Server::receivePackets() {
+    std::array<std::uint8_t, MAX_PACKET_SIZE> buffer{};
+    std::size_t received = 0;
+    std::optional<sf::IpAddress> sender;
+    unsigned short senderPort = 0;
+
+    while(socket.receive(buffer.data(), buffer.size(), received, sender, senderPort) == sf::Socket::Status::Done) {
+        if(!sender || received == 0) continue;
+
+        core::ByteReader reader(buffer.data(), received);
+        const auto type = reader.Take<MessageType>();
+        Peer* peer = findPeer(*sender, senderPort);
+
+        switch(type) {
+            case MessageType::Hello:
+                if(reader.Take<std::uint32_t>() != PROTOCOL_ID) break;
+                if(!peer) {
+                    peer = &addPeer(*sender, senderPort, false);
+                    core::EventLog::Emit(core::Event::PlayerJoined, peer->id, sender->toInteger(), senderPort);
+                }
+                peer->silence = 0.f;
+                sendWelcome(*peer);
+                break;
+
+            case MessageType::Input: {
+                if(!peer) break;
+
+                std::uint32_t ackedTick = 0;
+                if(!ReadInputs(reader, ackedTick, inputs)) break;
+
+                peer->silence = 0.f;
+                if(ackedTick > peer->ackedTick && ackedTick < tick)
+                    peer->ackedTick = ackedTick;
+
+                handleInputs(*peer);
+                break;
+            }
+
+            case MessageType::Bye:
+                if(peer) peer->silence = TIMEOUT_SECONDS + 1.f;
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+void Server::handleInputs(Peer& peer) {
+    for(const auto& input : inputs) {
+        if(input.sequence <= peer.lastProcessedInput) continue;
+
+        simulateInput(peer, input);
+        peer.lastProcessedInput = input.sequence;
+    }
+}
+
+void Server::driveBot(Peer& peer) {
+    const InputCommand input = peer.bot.Next(TICK_TIME, positionOf(*peer.player));
+
+    simulateInput(peer, input);
+    peer.lastProcessedInput = input.sequence;
+}
+
+void Server::simulateInput(Peer& peer, const InputCommand& input) {
+    ApplyInput(*peer.player, input);
+
+    auto movement = std::dynamic_pointer_cast<Movement>(peer.player->GetComponent("movement").lock());
+    if(!movement) return;
+
+    movement->Update(TICK_TIME);
+    if(map) core::ResolveMapCollision(*movement, map->GetDistanceField(), TICK_TIME);
+}
+
+void Server::buildRelevanceGrid() {
+    relevanceGrid.clear();
+
+    for(auto& peer : peers) {
+        const sf::Vector2f pos = positionOf(*peer->player);
+        relevanceGrid.emplace_back(makeCellKey(cellCoord(pos.x), cellCoord(pos.y)), peer.get());
+    }
+
+    std::sort(relevanceGrid.begin(), relevanceGrid.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+}
+
+void Server::buildSnapshot(const Peer& client, Snapshot& snapshot) {
+    snapshot.Clear();
+    snapshot.tick = tick;
+    snapshot.lastProcessedInput = client.lastProcessedInput;
+
+    const sf::Vector2f center = positionOf(*client.player);
+    const std::int64_t cellX = cellCoord(center.x);
+    const std::int64_t cellY = cellCoord(center.y);
+
+    candidates.clear();
+
+    for(std::int64_t dy = -1; dy <= 1; ++dy) {
+        for(std::int64_t dx = -1; dx <= 1; ++dx) {
+            const std::int64_t key = makeCellKey(cellX + dx, cellY + dy);
+
+            auto range = std::equal_range(relevanceGrid.begin(), relevanceGrid.end(), std::make_pair(key, nullptr),
+                [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+            for(auto iter = range.first; iter != range.second; ++iter) {
+                const sf::Vector2f offset = positionOf(*iter->second->player) - center;
+                const float distanceSq = offset.x * offset.x + offset.y * offset.y;
+
+                if(distanceSq <= RELEVANCE_RADIUS * RELEVANCE_RADIUS)
+                    candidates.emplace_back(iter->second == &client ? -1.f : distanceSq, iter->second);
+            }
+        }
+    }
+
+    const std::size_t relevant = std::min(candidates.size(), MAX_SNAPSHOT_PLAYERS);
+    std::partial_sort(candidates.begin(), candidates.begin() + relevant, candidates.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    for(std::size_t i = 0; i < relevant; ++i) {
+        const Peer& peer = *candidates[i].second;
+
+        auto movement = std::dynamic_pointer_cast<Movement>(peer.player->GetComponent("movement").lock());
+        auto gun = std::dynamic_pointer_cast<Gun>(peer.player->GetComponent("gun").lock());
+        auto flashlight = std::dynamic_pointer_cast<FlashLight>(peer.player->GetComponent("flashlight").lock());
+
+        PlayerState state;
+        state.id = peer.id;
+        if(movement) state.movement = movement->GetState();
+        if(flashlight) state.flashlight = flashlight->GetState();
+        if(gun) state.ammo = static_cast<std::uint8_t>(gun->GetAmmo());
+        snapshot.players.push_back(state);
+
+        if(!gun) continue;
+
+        for(const auto& bullet : gun->GetBullets()) {
+            if(snapshot.bullets.size() >= MAX_SNAPSHOT_BULLETS) break;
+            if(!bullet.active) continue;
+
+            snapshot.bullets.push_back(BulletState{
+                BulletState::MakeKey(peer.id, bullet.serial), bullet.position, bullet.direction, tick});
+        }
+    }
+
+    std::sort(snapshot.players.begin(), snapshot.players.end(),
+        [](const PlayerState& lhs, const PlayerState& rhs) { return lhs.id < rhs.id; });
+    std::sort(snapshot.bullets.begin(), snapshot.bullets.end(),
+        [](const BulletState& lhs, const BulletState& rhs) { return lhs.key < rhs.key; });
+}
+
+void Server::sendSnapshot(Peer& client) {
+    Snapshot& current = client.history[tick % SNAPSHOT_HISTORY];
+    buildSnapshot(client, current);
+
+    const Snapshot* baseline = nullptr;
+    if(client.ackedTick != 0 && tick - client.ackedTick < SNAPSHOT_HISTORY) {
+        const Snapshot& candidate = client.history[client.ackedTick % SNAPSHOT_HISTORY];
+        if(candidate.tick == client.ackedTick) baseline = &candidate;
+    }
+
+    // Bullets the client already holds keep the trajectory it was sent, so the stored
+    // snapshot matches what the client reconstructs from it.
+    if(baseline) {
+        auto base = baseline->bullets.begin();
+        for(auto& bullet : current.bullets) {
+            while(base != baseline->bullets.end() && base->key < bullet.key) ++base;
+            if(base != baseline->bullets.end() && base->key == bullet.key) bullet = *base;
+        }
+    }
+
+    FitSnapshot(current, baseline);
+
+    packet.clear();
+    core::ByteWriter writer(packet);
+    WriteSnapshot(writer, current, baseline);
+
+    if(socket.send(packet.data(), packet.size(), client.address, client.port) != sf::Socket::Status::Done)
+        return;
+
+    ++stats.snapshots;
+    stats.snapshotBytes += packet.size();
+    stats.maxSnapshotBytes = std::max(stats.maxSnapshotBytes, packet.size());
+}
+
+void Server::sendWelcome(const Peer& peer) {
+    packet.clear();
+    core::ByteWriter writer(packet);
+    writer.Write(MessageType::Welcome);
+    writer.Write<std::uint16_t>(peer.id);
+    writer.Write<std::uint32_t>(map->GetSeed());
+    writer.Write<float>(map->GetSize());
+    writer.Write<std::uint32_t>(tick);
+
+    static_cast<void>(socket.send(packet.data(), packet.size(), peer.address, peer.port));
+}
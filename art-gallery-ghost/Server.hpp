@@ -0,0 +1,101 @@
+#pragma once
+
+#include <SFML/Network.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "NetProtocol.hpp"
+#include "Physics.hpp"
+#include "ScriptedInput.hpp"
+
+class Map;
+class Player;
+class Collision;
+
+namespace net {
+    struct NetStats {
+        std::size_t ticks = 0;
+        double tickMicros = 0.0;
+        std::size_t snapshots = 0;
+        std::size_t snapshotBytes = 0;
+        std::size_t maxSnapshotBytes = 0;
+        std::size_t allocations = 0;
+
+        void Reset() { *this = NetStats{}; }
+    };
+
+    // Authoritative headless simulation. Clients send input commands over UDP and receive
+    // per-client snapshots delta-compressed against the last snapshot they acknowledged.
+    class Server {
+    public:
+        Server(const unsigned short port, const std::size_t botCount = 0, const bool printStats = true);
+        ~Server();
+
+        bool Start();
+        void Run();
+        void Stop() { running = false; }
+
+        void Tick();
+
+        const NetStats& GetStats() const { return stats; }
+
+    private:
+        struct Peer {
+            std::uint16_t id = 0;
+            sf::IpAddress address;
+            unsigned short port = 0;
+            bool isBot = false;
+
+            std::unique_ptr<Player> player;
+            std::uint32_t lastProcessedInput = 0;
+            std::uint32_t ackedTick = 0;
+            float silence = 0.f;
+
+            std::array<Snapshot, SNAPSHOT_HISTORY> history;
+
+            core::ScriptedInput bot;
+
+            Peer(const std::uint16_t id, const sf::IpAddress& address, const unsigned short port);
+        };
+
+        sf::UdpSocket socket;
+        unsigned short port = DEFAULT_PORT;
+        std::size_t botCount = 0;
+        bool printStats = true;
+        std::atomic<bool> running{false};
+
+        std::unique_ptr<Map> map;
+        std::shared_ptr<Collision> mapCollision;
+
+        std::vector<std::unique_ptr<Peer>> peers;
+        // Remote peers by address and port, looked up for every received datagram.
+        std::unordered_map<std::uint64_t, Peer*> endpoints;
+        std::uint16_t nextPeerId = 1;
+        std::uint32_t tick = 1;
+
+        std::vector<std::pair<std::int64_t, Peer*>> relevanceGrid;
+        std::vector<std::pair<float, Peer*>> candidates;
+        std::vector<InputCommand> inputs;
+        std::vector<std::uint8_t> packet;
+        core::BulletScratch bulletScratch;
+
+        NetStats stats;
+
+        Peer* findPeer(const sf::IpAddress& address, const unsigned short port);
+        Peer& addPeer(const sf::IpAddress& address, const unsigned short port, const bool isBot);
+
+        void receivePackets();
+        void handleInputs(Peer& peer);
+        void driveBot(Peer& peer);
+        void simulateInput(Peer& peer, const InputCommand& input);
+
+        void buildRelevanceGrid();
+        void buildSnapshot(const Peer& client, Snapshot& snapshot);
+        void sendSnapshot(Peer& client);
+        void sendWelcome(const Peer& peer);
+    };
+}
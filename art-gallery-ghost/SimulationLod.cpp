@@ -0,0 +1,117 @@
+#include "SimulationLod.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+using namespace core;
+
+namespace {
+    sf::Vector2i cellOf(const float x, const float y) {
+        return {static_cast<int>(std::floor(x / SimulationLod::CELL_SIZE)), static_cast<int>(std::floor(y / SimulationLod::CELL_SIZE))};
+    }
+}
+
+void SimulationLod::Reset(const std::size_t count) {
+    for(auto& bucket : buckets) {
+        bucket.ids.clear();
+        bucket.since.clear();
+        bucket.ids.reserve(count);
+        bucket.since.reserve(count);
+    }
+
+    entries.assign(count, Entry{});
+    tierCounts = {};
+    tierCounts[static_cast<std::size_t>(LodTier::Full)] = count;
+
+    woken.clear();
+    woken.reserve(count);
+    cursor = 0;
+}
+
+void SimulationLod::SetActive(const std::uint32_t id, const bool active) {
+    Entry& entry = entries[id];
+    if(entry.active == active) return;
+
+    if(active) {
+        entry.active = true;
+        link(id);
+    }
+    else {
+        unlink(id);
+        entry.active = false;
+    }
+}
+
+void SimulationLod::AddFocus(const sf::Vector2f& point) {
+    if(focusCount < MAX_FOCI) foci[focusCount++] = cellOf(point.x, point.y);
+}
+
+void SimulationLod::Rebalance(const float* xs, const float* ys, const std::size_t budget) {
+    woken.clear();
+
+    // Without a focus everything is Full, and once it is there is nothing left to move.
+    if(entries.empty() || (focusCount == 0 && tierCounts[static_cast<std::size_t>(LodTier::Full)] == entries.size())) return;
+
+    const std::size_t count = std::min(budget, entries.size());
+    for(std::size_t i = 0; i < count; ++i) {
+        const std::uint32_t id = static_cast<std::uint32_t>(cursor);
+        cursor = (cursor + 1) % entries.size();
+
+        const LodTier tier = tierAt(xs[id], ys[id]);
+        Entry& entry = entries[id];
+        const LodTier previous = entry.tier;
+        if(tier == previous) continue;
+
+        if(entry.active) unlink(id);
+
+        --tierCounts[static_cast<std::size_t>(previous)];
+        ++tierCounts[static_cast<std::size_t>(tier)];
+        entry.tier = tier;
+
+        if(entry.active) link(id);
+        if(previous == LodTier::Suspended) woken.push_back(id);
+    }
+}
+
+LodTier SimulationLod::tierAt(const float x, const float y) const {
+    if(focusCount == 0) return LodTier::Full;
+
+    const sf::Vector2i cell = cellOf(x, y);
+
+    int ring = std::numeric_limits<int>::max();
+    for(std::size_t i = 0; i < focusCount; ++i)
+        ring = std::min(ring, std::max(std::abs(cell.x - foci[i].x), std::abs(cell.y - foci[i].y)));
+
+    for(std::size_t tier = 0; tier < TIER_RINGS.size(); ++tier)
+        if(ring <= TIER_RINGS[tier]) return static_cast<LodTier>(tier);
+
+    return LodTier::Suspended;
+}
+
+void SimulationLod::link(const std::uint32_t id) {
+    Entry& entry = entries[id];
+    const std::size_t index = static_cast<std::size_t>(entry.tier);
+    const std::uint32_t phase = entry.tier == LodTier::Suspended ? 0 : id % TIER_STRIDES[index];
+
+    entry.bucket = BUCKET_OFFSETS[index] + phase;
+
+    Bucket& bucket = buckets[entry.bucket];
+    entry.slot = static_cast<std::uint32_t>(bucket.ids.size());
+    bucket.ids.push_back(id);
+    bucket.since.push_back(time);
+}
+
+void SimulationLod::unlink(const std::uint32_t id) {
+    const Entry& entry = entries[id];
+    Bucket& bucket = buckets[entry.bucket];
+
+    const std::uint32_t last = bucket.ids.back();
+    bucket.ids[entry.slot] = last;
+    bucket.since[entry.slot] = bucket.since.back();
+    entries[last].slot = entry.slot;
+
+    bucket.ids.pop_back();
+    bucket.since.pop_back();
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace core {
+    enum class LodTier : std::uint8_t {
+        Full,       // every tick
+        Half,       // every 2nd tick
+        Eighth,     // every 8th tick
+        Suspended,  // outside the loaded cells; never updated
+    };
+
+    constexpr std::size_t LOD_TIER_COUNT = static_cast<std::size_t>(LodTier::Suspended) + 1;
+
+    // Spreads entity updates over ticks by how far each entity is from the focus points (camera,
+    // player). The world is cut into CELL_SIZE cells, matching the wall chunks, and an entity's
+    // tier comes from the ring of cells between it and the nearest focus. Each slower tier keeps
+    // one bucket per phase and idle entities sit in none, so a tick only visits active entities
+    // in the buckets that are due: the per-tick cost follows what is busy near the focus rather
+    // than the whole population.
+    class SimulationLod {
+    public:
+        constexpr static float CELL_SIZE = 1024.f;
+        constexpr static std::size_t MAX_FOCI = 4;
+
+        // Largest ring, in cells from the focus, that still gets each tier.
+        constexpr static std::array<int, LOD_TIER_COUNT - 1> TIER_RINGS = {1, 2, 4};
+        constexpr static std::array<std::uint32_t, LOD_TIER_COUNT - 1> TIER_STRIDES = {1, 2, 8};
+
+        // `count` idle entities, all Full until Rebalance() places them.
+        void Reset(const std::size_t count);
+
+        // Only active entities are ever due. An entity that becomes active, changes tier or leaves
+        // Suspended starts its next delta from then.
+        void SetActive(const std::uint32_t id, const bool active);
+
+        // Without a focus every entity is Full.
+        void ClearFocus() { focusCount = 0; }
+        void AddFocus(const sf::Vector2f& point);
+
+        // Re-tiers the next `budget` entities round-robin from their positions. Entities leaving
+        // Suspended are listed in GetWoken() until the next call.
+        void Rebalance(const float* xs, const float* ys, const std::size_t budget);
+
+        // Advances one tick and calls update(id, deltaTime) for every entity due, with the time
+        // since its last update so slower tiers take proportionally larger steps. `update` may
+        // deactivate the entity it is given but must not touch any other.
+        template <typename Update>
+        void Tick(const float deltaTime, Update&& update) {
+            ++tick;
+            time += deltaTime;
+
+            for(std::size_t tier = 0; tier + 1 < LOD_TIER_COUNT; ++tier) {
+                Bucket& bucket = buckets[BUCKET_OFFSETS[tier] + tick % TIER_STRIDES[tier]];
+                const double lastDue = bucket.lastDue;
+                bucket.lastDue = time;
+
+                // Backwards, so an entity deactivated here is replaced by one already visited.
+                for(std::size_t i = bucket.ids.size(); i-- > 0;)
+                    update(bucket.ids[i], static_cast<float>(time - std::max(lastDue, bucket.since[i])));
+            }
+        }
+
+        const std::vector<std::uint32_t>& GetWoken() const { return woken; }
+
+        LodTier GetTier(const std::uint32_t id) const { return entries[id].tier; }
+        bool IsActive(const std::uint32_t id) const { return entries[id].active; }
+        std::size_t GetTierCount(const LodTier tier) const { return tierCounts[static_cast<std::size_t>(tier)]; }
+        std::size_t GetCount() const { return entries.size(); }
+
+    private:
+        // Buckets are laid out tier by tier, one per phase: Full, Half x2, Eighth x8, Suspended.
+        constexpr static std::array<std::uint32_t, LOD_TIER_COUNT> BUCKET_OFFSETS = {0, 1, 3, 11};
+        constexpr static std::size_t BUCKET_COUNT = 12;
+
+        struct Entry {
+            LodTier tier = LodTier::Full;
+            bool active = false;
+            std::uint32_t bucket = 0;
+            std::uint32_t slot = 0;
+        };
+
+        // since[i] is when ids[i] joined, so its first delta does not reach back past that.
+        struct Bucket {
+            std::vector<std::uint32_t> ids;
+            std::vector<double> since;
+            double lastDue = 0.0;
+        };
+
+        std::vector<Entry> entries;
+        std::array<Bucket, BUCKET_COUNT> buckets;
+        std::array<std::size_t, LOD_TIER_COUNT> tierCounts{};
+
+        std::array<sf::Vector2i, MAX_FOCI> foci;
+        std::size_t focusCount = 0;
+
+        std::vector<std::uint32_t> woken;
+
+        std::size_t cursor = 0;
+        std::uint64_t tick = 0;
+        double time = 0.0;
+
+        LodTier tierAt(const float x, const float y) const;
+        void link(const std::uint32_t id);
+        void unlink(const std::uint32_t id);
+    };
+}
@@ -0,0 +1,237 @@
+#include "SoundScene.hpp"
+
+#include "Collision.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace core;
+
+namespace {
+    constexpr std::uint16_t NO_OWNER = 0xFFFF;
+    constexpr std::uint32_t SLOT_BITS = 8;
+    static_assert(SoundScene::MAX_SOURCES == 1u << SLOT_BITS);
+
+    // Smaller changes are not worth a command; the mixer ramps over them anyway.
+    constexpr float GAIN_EPSILON = 0.002f;
+    constexpr float PAN_EPSILON = 0.01f;
+}
+
+SoundScene::SoundScene(AudioMixer* mixer) : mixer(mixer) {
+    voiceOwners.fill(NO_OWNER);
+
+    traced.reserve(MAX_SOURCES);
+    tracedXs.reserve(MAX_SOURCES);
+    tracedYs.reserve(MAX_SOURCES);
+    blocked.reserve(MAX_SOURCES);
+    candidates.reserve(MAX_SOURCES);
+}
+
+SoundId SoundScene::Play(const SoundKind kind, const sf::Vector2f& position, const float gain) {
+    return start(kind, position, gain, false);
+}
+
+SoundId SoundScene::Loop(const SoundKind kind, const sf::Vector2f& position, const float gain) {
+    return start(kind, position, gain, true);
+}
+
+void SoundScene::Move(const SoundId id, const sf::Vector2f& position) {
+    if(Source* source = find(id))
+        source->position = position;
+}
+
+void SoundScene::Stop(const SoundId id) {
+    if(Source* source = find(id))
+        release(*source);
+}
+
+void SoundScene::Clear() {
+    for(Source& source : sources)
+        if(source.id != NO_SOUND) release(source);
+}
+
+void SoundScene::Update(const float deltaTime) {
+    ++tick;
+
+    for(Source& source : sources)
+        if(source.id != NO_SOUND && !source.loop && source.elapsed >= SoundBank::GetDuration(source.kind))
+            release(source);
+
+    traceOcclusion(tick % OCCLUSION_TICKS == 0);
+
+    const float fade = std::min(1.f, OCCLUSION_FADE * deltaTime);
+
+    for(Source& source : sources) {
+        if(source.id == NO_SOUND) continue;
+
+        source.occlusion += (source.targetOcclusion - source.occlusion) * fade;
+
+        const sf::Vector2f offset = source.position - listener;
+        const float distance = std::sqrt(offset.x * offset.x + offset.y * offset.y);
+        const float attenuation = distance >= MAX_DISTANCE ? 0.f : REFERENCE_DISTANCE / std::max(distance, REFERENCE_DISTANCE);
+
+        source.audibility = source.gain * attenuation * source.occlusion;
+    }
+
+    assignVoices();
+
+    // After the voices started, so a new sound starts at its first sample.
+    for(Source& source : sources)
+        if(source.id != NO_SOUND) source.elapsed += deltaTime;
+}
+
+SoundId SoundScene::start(const SoundKind kind, const sf::Vector2f& position, const float gain, const bool loop) {
+    const auto free = std::find_if(sources.begin(), sources.end(), [](const Source& source) { return source.id == NO_SOUND; });
+    if(free == sources.end()) {
+        ++dropped;
+        return NO_SOUND;
+    }
+
+    const auto slot = static_cast<std::uint32_t>(free - sources.begin());
+
+    Source& source = *free;
+    source = Source{};
+    source.id = (++serial << SLOT_BITS) | slot;
+    source.kind = kind;
+    source.loop = loop;
+    source.position = position;
+    source.gain = gain;
+
+    ++sourceCount;
+    return source.id;
+}
+
+SoundScene::Source* SoundScene::find(const SoundId id) {
+    Source& source = sources[id & (MAX_SOURCES - 1)];
+    return id != NO_SOUND && source.id == id ? &source : nullptr;
+}
+
+void SoundScene::release(Source& source) {
+    if(source.voice >= 0) {
+        VoiceCommand command;
+        command.type = VoiceCommand::Type::Stop;
+        command.voice = static_cast<std::uint8_t>(source.voice);
+        send(command);
+
+        voiceOwners[static_cast<std::size_t>(source.voice)] = NO_OWNER;
+    }
+
+    source = Source{};
+    --sourceCount;
+}
+
+// One batched segment test per source, listener to source; sources out of earshot are skipped.
+void SoundScene::traceOcclusion(const bool all) {
+    traced.clear();
+    tracedXs.clear();
+    tracedYs.clear();
+
+    for(std::size_t slot = 0; slot < MAX_SOURCES; ++slot) {
+        const Source& source = sources[slot];
+        if(source.id == NO_SOUND || (source.traced && !all)) continue;
+
+        const sf::Vector2f offset = source.position - listener;
+        if(offset.x * offset.x + offset.y * offset.y >= MAX_DISTANCE * MAX_DISTANCE) continue;
+
+        traced.push_back(static_cast<std::uint16_t>(slot));
+        tracedXs.push_back(source.position.x);
+        tracedYs.push_back(source.position.y);
+    }
+
+    if(traced.empty()) return;
+
+    blocked.resize(traced.size());
+    if(walls)
+        walls->SegmentsBlocked(listener, tracedXs.data(), tracedYs.data(), traced.size(), blocked.data());
+    else
+        std::fill(blocked.begin(), blocked.end(), std::uint8_t{0});
+
+    for(std::size_t i = 0; i < traced.size(); ++i) {
+        Source& source = sources[traced[i]];
+        source.targetOcclusion = blocked[i] ? OCCLUDED_GAIN : 1.f;
+
+        // A new sound is heard through the wall from its first sample, not faded into it.
+        if(!source.traced) source.occlusion = source.targetOcclusion;
+        source.traced = true;
+    }
+}
+
+void SoundScene::assignVoices() {
+    candidates.clear();
+    for(std::size_t slot = 0; slot < MAX_SOURCES; ++slot) {
+        const Source& source = sources[slot];
+        if(source.id != NO_SOUND && source.audibility > AUDIBLE_GAIN)
+            candidates.push_back(static_cast<std::uint16_t>(slot));
+    }
+
+    if(candidates.size() > VOICE_COUNT) {
+        auto rank = [this](const std::uint16_t slot) {
+            const Source& source = sources[slot];
+            return source.voice >= 0 ? source.audibility * VOICE_HYSTERESIS : source.audibility;
+        };
+
+        std::nth_element(candidates.begin(), candidates.begin() + VOICE_COUNT, candidates.end(),
+            [&rank](const std::uint16_t lhs, const std::uint16_t rhs) { return rank(lhs) > rank(rhs); });
+        candidates.resize(VOICE_COUNT);
+    }
+
+    for(const std::uint16_t slot : candidates)
+        sources[slot].selected = tick;
+
+    // Sources that lost their place go virtual.
+    for(std::size_t voice = 0; voice < VOICE_COUNT; ++voice) {
+        const std::uint16_t owner = voiceOwners[voice];
+        if(owner == NO_OWNER || sources[owner].selected == tick) continue;
+
+        VoiceCommand command;
+        command.type = VoiceCommand::Type::Stop;
+        command.voice = static_cast<std::uint8_t>(voice);
+        send(command);
+
+        sources[owner].voice = -1;
+        voiceOwners[voice] = NO_OWNER;
+    }
+
+    for(const std::uint16_t slot : candidates) {
+        Source& source = sources[slot];
+        const float pan = std::clamp((source.position.x - listener.x) / PAN_WIDTH, -1.f, 1.f);
+
+        if(source.voice < 0) {
+            // May be a voice stopped above; the mixer fades its old sound out under this one.
+            const auto voice = static_cast<std::size_t>(std::find(voiceOwners.begin(), voiceOwners.end(), NO_OWNER) - voiceOwners.begin());
+
+            VoiceCommand command;
+            command.type = VoiceCommand::Type::Start;
+            command.voice = static_cast<std::uint8_t>(voice);
+            command.kind = source.kind;
+            command.loop = source.loop;
+            command.gain = source.audibility;
+            command.pan = pan;
+            command.offset = static_cast<std::uint32_t>(source.elapsed * static_cast<float>(AudioMixer::SAMPLE_RATE));
+            send(command);
+
+            source.voice = static_cast<std::int16_t>(voice);
+            voiceOwners[voice] = slot;
+        }
+        else if(std::abs(source.audibility - source.sentGain) > GAIN_EPSILON || std::abs(pan - source.sentPan) > PAN_EPSILON) {
+            VoiceCommand command;
+            command.type = VoiceCommand::Type::Update;
+            command.voice = static_cast<std::uint8_t>(source.voice);
+            command.gain = source.audibility;
+            command.pan = pan;
+            send(command);
+        }
+        else {
+            continue;
+        }
+
+        source.sentGain = source.audibility;
+        source.sentPan = pan;
+    }
+
+    playing = candidates.size();
+}
+
+void SoundScene::send(const VoiceCommand& command) {
+    if(mixer) mixer->Send(command);
+}
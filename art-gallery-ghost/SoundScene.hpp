@@ -0,0 +1,104 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "AudioMixer.hpp"
+
+class Collision;
+
+namespace core {
+    using SoundId = std::uint32_t;
+    constexpr SoundId NO_SOUND = 0;
+
+    // Every sound the game wants heard, played through the mixer's few voices. Sources fade with
+    // distance and are muffled when a wall stands between them and the listener; each tick only
+    // the VOICE_COUNT most audible get a voice. The others stay virtual: they keep their place in
+    // the clip and cost nothing in the mixer until they are loud enough again.
+    class SoundScene {
+    public:
+        constexpr static std::size_t MAX_SOURCES = 256;
+        constexpr static std::size_t VOICE_COUNT = AudioMixer::VOICE_COUNT;
+
+        // Full volume up to the reference distance, then falling off as 1 / distance.
+        constexpr static float REFERENCE_DISTANCE = 150.f;
+        constexpr static float MAX_DISTANCE = 2400.f;
+        constexpr static float PAN_WIDTH = 600.f;
+        constexpr static float OCCLUDED_GAIN = 0.3f;
+        // Occlusion of every source is re-traced this often; new sources are traced on their first tick.
+        constexpr static std::uint32_t OCCLUSION_TICKS = 6;
+        constexpr static float OCCLUSION_FADE = 8.f;
+        constexpr static float AUDIBLE_GAIN = 0.002f;
+        // A playing source keeps its voice until a virtual one is this much louder.
+        constexpr static float VOICE_HYSTERESIS = 1.25f;
+
+        explicit SoundScene(AudioMixer* mixer = nullptr);
+
+        // Without a mixer the scene still picks voices but nothing is heard.
+        void SetMixer(AudioMixer* mixer) { this->mixer = mixer; }
+
+        // Without walls nothing is occluded.
+        void SetWalls(const Collision* walls) { this->walls = walls; }
+        void SetListener(const sf::Vector2f& position) { listener = position; }
+
+        // NO_SOUND when all MAX_SOURCES sources are taken.
+        SoundId Play(const SoundKind kind, const sf::Vector2f& position, const float gain = 1.f);
+        SoundId Loop(const SoundKind kind, const sf::Vector2f& position, const float gain = 1.f);
+        void Move(const SoundId id, const sf::Vector2f& position);
+        void Stop(const SoundId id);
+        void Clear();
+
+        void Update(const float deltaTime);
+
+        std::size_t GetSourceCount() const { return sourceCount; }
+        std::size_t GetPlayingCount() const { return playing; }
+        std::size_t GetDroppedCount() const { return dropped; }
+
+    private:
+        struct Source {
+            SoundId id = NO_SOUND;
+            SoundKind kind = SoundKind::Gunshot;
+            bool loop = false;
+            bool traced = false;
+            sf::Vector2f position;
+            float gain = 0.f;
+            float elapsed = 0.f;
+            float occlusion = 1.f;
+            float targetOcclusion = 1.f;
+            float audibility = 0.f;
+            float sentGain = 0.f;
+            float sentPan = 0.f;
+            std::int16_t voice = -1;
+            std::uint32_t selected = 0;
+        };
+
+        AudioMixer* mixer;
+        const Collision* walls = nullptr;
+        sf::Vector2f listener;
+
+        std::array<Source, MAX_SOURCES> sources;
+        std::array<std::uint16_t, VOICE_COUNT> voiceOwners;
+        std::size_t sourceCount = 0;
+        std::size_t playing = 0;
+        std::size_t dropped = 0;
+        std::uint32_t serial = 0;
+        std::uint32_t tick = 0;
+
+        // Per-tick scratch, reserved up front so Update never allocates.
+        std::vector<std::uint16_t> traced;
+        std::vector<float> tracedXs;
+        std::vector<float> tracedYs;
+        std::vector<std::uint8_t> blocked;
+        std::vector<std::uint16_t> candidates;
+
+        SoundId start(const SoundKind kind, const sf::Vector2f& position, const float gain, const bool loop);
+        Source* find(const SoundId id);
+        void release(Source& source);
+        void traceOcclusion(const bool all);
+        void assignVoices();
+        void send(const VoiceCommand& command);
+    };
+}
@@ -0,0 +1,33 @@
+#include "Tessellation.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+constexpr float PI = 3.141592f;
+
+float core::PixelsPerUnit(const sf::RenderTarget& target) {
+    const sf::View& view = target.getView();
+    const float viewWidth = view.getSize().x;
+    if(viewWidth <= 0.f) return 1.f;
+
+    return view.getViewport().size.x * static_cast<float>(target.getSize().x) / viewWidth;
+}
+
+std::size_t core::ArcSegments(const float radiusInPixels, const float arcRadians, const std::size_t minSegments) {
+    if(radiusInPixels <= TESSELLATION_MAX_ERROR)
+        return minSegments;
+
+    // A chord spanning angle a deviates from its arc by r * (1 - cos(a / 2)).
+    const float maxStep = 2.f * std::acos(1.f - TESSELLATION_MAX_ERROR / radiusInPixels);
+    const auto segments = static_cast<std::size_t>(std::ceil(std::abs(arcRadians) / maxStep));
+
+    return std::max(minSegments, std::min(segments, MAX_ARC_SEGMENTS));
+}
+
+void core::FitCircle(sf::CircleShape& circle, const sf::RenderTarget& target) {
+    const std::size_t segments = ArcSegments(
+        circle.getRadius() * PixelsPerUnit(target), 2.f * PI, MIN_CIRCLE_SEGMENTS);
+
+    if(circle.getPointCount() != segments)
+        circle.setPointCount(segments);
+}
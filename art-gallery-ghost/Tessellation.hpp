@@ -0,0 +1,22 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstddef>
+
+namespace core {
+    // Largest distance, in screen pixels, a tessellated curve may sit inside the true curve.
+    constexpr float TESSELLATION_MAX_ERROR = 0.5f;
+    constexpr std::size_t MIN_ARC_SEGMENTS = 2;
+    constexpr std::size_t MIN_CIRCLE_SEGMENTS = 6;
+    constexpr std::size_t MAX_ARC_SEGMENTS = 256;
+
+    // Screen pixels covered by one world unit under the target's current view and viewport.
+    float PixelsPerUnit(const sf::RenderTarget& target);
+
+    // Fewest segments for an arc of the given projected radius and angle to stay within TESSELLATION_MAX_ERROR.
+    std::size_t ArcSegments(const float radiusInPixels, const float arcRadians, const std::size_t minSegments = MIN_ARC_SEGMENTS);
+
+    // Sets the circle's point count for how big it is on the target; only rebuilds the shape when the count changes.
+    void FitCircle(sf::CircleShape& circle, const sf::RenderTarget& target);
+}
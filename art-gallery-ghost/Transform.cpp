@@ -0,0 +1,63 @@
+#include "Transform.hpp"
+
+#include <algorithm>
+
+using namespace core;
+
+Transform::~Transform() {
+    SetParent(nullptr);
+
+    for(Transform* child : children) {
+        child->parent = nullptr;
+        child->markDirty();
+    }
+}
+
+void Transform::SetParent(Transform* parent) {
+    if(this->parent == parent) return;
+
+    if(this->parent) {
+        auto& siblings = this->parent->children;
+        siblings.erase(std::remove(siblings.begin(), siblings.end(), this), siblings.end());
+    }
+
+    this->parent = parent;
+    if(parent) parent->children.push_back(this);
+
+    markDirty();
+}
+
+void Transform::SetPosition(const sf::Vector2f& position) {
+    if(this->position == position) return;
+
+    this->position = position;
+    markDirty();
+}
+
+void Transform::SetRotation(const sf::Angle rotation) {
+    if(this->rotation == rotation) return;
+
+    this->rotation = rotation;
+    markDirty();
+}
+
+const sf::Transform& Transform::GetWorld() const {
+    if(dirty) {
+        sf::Transform local;
+        local.translate(position);
+        local.rotate(rotation);
+
+        world = parent ? parent->GetWorld() * local : local;
+        dirty = false;
+    }
+
+    return world;
+}
+
+void Transform::markDirty() {
+    if(dirty) return;
+
+    dirty = true;
+    for(Transform* child : children)
+        child->markDirty();
+}
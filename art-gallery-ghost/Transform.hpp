@@ -0,0 +1,44 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <vector>
+
+namespace core {
+    // Node in the object hierarchy. The world matrix is cached and only rebuilt after this node or
+    // one of its ancestors changed, so a hierarchy that does not move costs nothing per frame.
+    class Transform {
+    public:
+        Transform() = default;
+        ~Transform();
+
+        Transform(const Transform&) = delete;
+        Transform& operator=(const Transform&) = delete;
+
+        // Children follow their parent; the parent must outlive the link or be reset first.
+        void SetParent(Transform* parent);
+        Transform* GetParent() const { return parent; }
+
+        void SetPosition(const sf::Vector2f& position);
+        void SetRotation(const sf::Angle rotation);
+
+        sf::Vector2f GetPosition() const { return position; }
+        sf::Angle GetRotation() const { return rotation; }
+
+        const sf::Transform& GetWorld() const;
+        sf::Vector2f GetWorldPosition() const { return GetWorld().transformPoint({0.f, 0.f}); }
+
+    private:
+        Transform* parent = nullptr;
+        std::vector<Transform*> children;
+
+        sf::Vector2f position{0.f, 0.f};
+        sf::Angle rotation = sf::Angle::Zero;
+
+        // A dirty node's descendants are always dirty too, so propagation stops at the first one.
+        mutable sf::Transform world;
+        mutable bool dirty = true;
+
+        void markDirty();
+    };
+}
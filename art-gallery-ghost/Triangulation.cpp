@@ -0,0 +1,358 @@
+#include "Triangulation.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <numeric>
+
+namespace {
+    constexpr double EPSILON = 1e-4;
+
+    // Orientation tests run in double: map coordinates are in the thousands, where float products lose the sign.
+    double cross(const sf::Vector2f& origin, const sf::Vector2f& a, const sf::Vector2f& b) {
+        return (static_cast<double>(a.x) - origin.x) * (static_cast<double>(b.y) - origin.y) -
+               (static_cast<double>(a.y) - origin.y) * (static_cast<double>(b.x) - origin.x);
+    }
+
+    float distanceSq(const sf::Vector2f& a, const sf::Vector2f& b) {
+        return (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y);
+    }
+
+    bool pointInTriangle(const sf::Vector2f& p, const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c) {
+        return cross(a, b, p) >= -EPSILON && cross(b, c, p) >= -EPSILON && cross(c, a, p) >= -EPSILON;
+    }
+
+    // Probes a short step along from -> to, in double so a probe lying on a triangle edge stays on it.
+    bool edgeEntersTriangle(const sf::Vector2f& from, const sf::Vector2f& to, const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c) {
+        const double dx = static_cast<double>(to.x) - from.x;
+        const double dy = static_cast<double>(to.y) - from.y;
+        const double length = std::sqrt(dx * dx + dy * dy);
+        if (length < EPSILON) return false;
+
+        const double step = std::min(length * 0.5, 1.0) / length;
+        const double px = from.x + dx * step;
+        const double py = from.y + dy * step;
+
+        auto side = [px, py](const sf::Vector2f& origin, const sf::Vector2f& end) {
+            const double ex = static_cast<double>(end.x) - origin.x;
+            const double ey = static_cast<double>(end.y) - origin.y;
+            return (ex * (py - origin.y) - ey * (px - origin.x)) / std::sqrt(ex * ex + ey * ey);
+        };
+
+        return side(a, b) > EPSILON && side(b, c) > EPSILON && side(c, a) > EPSILON;
+    }
+
+    bool pointOnSegment(const sf::Vector2f& p, const sf::Vector2f& a, const sf::Vector2f& b) {
+        const sf::Vector2f ab = b - a;
+        const float lengthSq = ab.x * ab.x + ab.y * ab.y;
+        if (lengthSq < EPSILON) return distanceSq(p, a) < EPSILON;
+
+        const float t = ((p.x - a.x) * ab.x + (p.y - a.y) * ab.y) / lengthSq;
+        return t > 0.f && t < 1.f && distanceSq(p, a + ab * t) < EPSILON;
+    }
+
+    bool segmentsCross(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c, const sf::Vector2f& d) {
+        const double d1 = cross(c, d, a);
+        const double d2 = cross(c, d, b);
+        const double d3 = cross(a, b, c);
+        const double d4 = cross(a, b, d);
+
+        return ((d1 > EPSILON && d2 < -EPSILON) || (d1 < -EPSILON && d2 > EPSILON)) &&
+               ((d3 > EPSILON && d4 < -EPSILON) || (d3 < -EPSILON && d4 > EPSILON));
+    }
+
+    // True when the segment from -> to touches no ring edge or vertex other than at its own endpoints.
+    bool segmentIsClear(const sf::Vector2f& from, const sf::Vector2f& to, const core::Ring& ring) {
+        for (std::size_t i = 0; i < ring.size(); ++i) {
+            const sf::Vector2f& a = ring[i];
+            const sf::Vector2f& b = ring[(i + 1) % ring.size()];
+
+            if (a != from && a != to && pointOnSegment(a, from, to))
+                return false;
+
+            if (a == from || a == to || b == from || b == to)
+                continue;
+
+            if (segmentsCross(from, to, a, b))
+                return false;
+        }
+
+        return true;
+    }
+
+    // Index of the closest outer vertex the anchor can see, skipping vertices that already end a bridge.
+    std::size_t findBridgeTarget(const core::Ring& outer, const sf::Vector2f& anchor, const core::Ring& hole, const std::vector<core::Ring>& pending) {
+        std::vector<std::size_t> candidates(outer.size());
+        std::iota(candidates.begin(), candidates.end(), std::size_t{0});
+        std::sort(candidates.begin(), candidates.end(), [&](const std::size_t lhs, const std::size_t rhs) {
+            return distanceSq(outer[lhs], anchor) < distanceSq(outer[rhs], anchor);
+        });
+
+        for (const std::size_t candidate : candidates) {
+            const sf::Vector2f& target = outer[candidate];
+
+            // Reusing an existing bridge end would stack three copies of one vertex, which ear clipping cannot untangle.
+            if (std::count(outer.begin(), outer.end(), target) > 1) continue;
+
+            bool visible = segmentIsClear(anchor, target, outer) && segmentIsClear(anchor, target, hole);
+            for (std::size_t p = 0; visible && p < pending.size(); ++p)
+                visible = segmentIsClear(anchor, target, pending[p]);
+
+            if (visible) return candidate;
+        }
+
+        return outer.size();
+    }
+
+    // Splits the first outer edge hit by a ray cast in +x from the anchor and returns the new vertex.
+    // Pending holes all lie left of the anchor, so nothing can block this bridge.
+    std::size_t splitEdgeRightOf(core::Ring& outer, const sf::Vector2f& anchor) {
+        float bestX = std::numeric_limits<float>::max();
+        std::size_t bestEdge = outer.size();
+
+        for (std::size_t i = 0; i < outer.size(); ++i) {
+            const sf::Vector2f& a = outer[i];
+            const sf::Vector2f& b = outer[(i + 1) % outer.size()];
+
+            // Only edges running in +y face the anchor's side on a positively wound ring.
+            if (!(a.y <= anchor.y && anchor.y < b.y)) continue;
+
+            const float x = a.x + (anchor.y - a.y) * (b.x - a.x) / (b.y - a.y);
+            if (x > anchor.x && x < bestX) {
+                bestX = x;
+                bestEdge = i;
+            }
+        }
+
+        if (bestEdge == outer.size()) return outer.size();
+
+        outer.insert(outer.begin() + static_cast<std::ptrdiff_t>(bestEdge) + 1, sf::Vector2f{bestX, anchor.y});
+        return bestEdge + 1;
+    }
+
+    // Splices hole into outer through a bridge from the hole's rightmost vertex to a visible outer vertex.
+    bool bridgeHole(core::Ring& outer, const core::Ring& hole, const std::vector<core::Ring>& pending) {
+        const std::size_t holeStart = static_cast<std::size_t>(std::distance(hole.begin(),
+            std::max_element(hole.begin(), hole.end(),
+                [](const sf::Vector2f& lhs, const sf::Vector2f& rhs) { return lhs.x < rhs.x; })));
+        const sf::Vector2f anchor = hole[holeStart];
+
+        std::size_t candidate = findBridgeTarget(outer, anchor, hole, pending);
+        if (candidate == outer.size())
+            candidate = splitEdgeRightOf(outer, anchor);
+
+        if (candidate == outer.size())
+            return false;
+
+        const sf::Vector2f target = outer[candidate];
+
+        core::Ring merged;
+        merged.reserve(outer.size() + hole.size() + 2);
+        merged.insert(merged.end(), outer.begin(), outer.begin() + static_cast<std::ptrdiff_t>(candidate) + 1);
+
+        for (std::size_t i = 0; i <= hole.size(); ++i)
+            merged.push_back(hole[(holeStart + i) % hole.size()]);
+
+        merged.push_back(target);
+        merged.insert(merged.end(), outer.begin() + static_cast<std::ptrdiff_t>(candidate) + 1, outer.end());
+
+        outer = std::move(merged);
+        return true;
+    }
+
+    // Joins rhs onto lhs across lhs's edge i when the union is still convex. Only the two shared corners
+    // change angle, so only those are tested; rhs's other vertices are spliced in between them.
+    bool tryMerge(core::Ring& lhs, const std::size_t i, const core::Ring& rhs) {
+        const std::size_t lhsCount = lhs.size();
+        const std::size_t rhsCount = rhs.size();
+        const sf::Vector2f a = lhs[i];
+        const sf::Vector2f b = lhs[(i + 1) % lhsCount];
+
+        for (std::size_t j = 0; j < rhsCount; ++j) {
+            if (rhs[j] != b || rhs[(j + 1) % rhsCount] != a)
+                continue;
+
+            const sf::Vector2f& beforeA = lhs[(i + lhsCount - 1) % lhsCount];
+            const sf::Vector2f& afterA = rhs[(j + 2) % rhsCount];
+            const sf::Vector2f& beforeB = rhs[(j + rhsCount - 1) % rhsCount];
+            const sf::Vector2f& afterB = lhs[(i + 2) % lhsCount];
+
+            if (cross(beforeA, a, afterA) < -EPSILON || cross(beforeB, b, afterB) < -EPSILON)
+                return false;
+
+            core::Ring between;
+            for (std::size_t k = 2; k < rhsCount; ++k)
+                between.push_back(rhs[(j + k) % rhsCount]);
+
+            lhs.insert(lhs.begin() + static_cast<std::ptrdiff_t>(i) + 1, between.begin(), between.end());
+            return true;
+        }
+
+        return false;
+    }
+
+    using EdgeKey = std::array<float, 4>;
+
+    EdgeKey edgeKey(const sf::Vector2f& from, const sf::Vector2f& to) {
+        return {from.x, from.y, to.x, to.y};
+    }
+}
+
+float core::SignedArea(const Ring& ring) {
+    double area = 0.0;
+
+    for (std::size_t i = 0; i < ring.size(); ++i) {
+        const sf::Vector2f& a = ring[i];
+        const sf::Vector2f& b = ring[(i + 1) % ring.size()];
+        area += static_cast<double>(a.x) * b.y - static_cast<double>(b.x) * a.y;
+    }
+
+    return static_cast<float>(area * 0.5);
+}
+
+bool core::Triangulate(const PolygonWithHoles& polygon, std::vector<sf::Vector2f>& triangles) {
+    if (polygon.outer.size() < 3) return false;
+
+    Ring outer = polygon.outer;
+    if (SignedArea(outer) < 0.f)
+        std::reverse(outer.begin(), outer.end());
+
+    std::vector<Ring> holes;
+    for (const auto& hole : polygon.holes) {
+        if (hole.size() < 3) continue;
+
+        holes.push_back(hole);
+        if (SignedArea(holes.back()) > 0.f)
+            std::reverse(holes.back().begin(), holes.back().end());
+    }
+
+    // Rightmost holes first, so each bridge only has to clear holes that are still unmerged.
+    auto maxX = [](const Ring& ring) {
+        return std::max_element(ring.begin(), ring.end(),
+            [](const sf::Vector2f& lhs, const sf::Vector2f& rhs) { return lhs.x < rhs.x; })->x;
+    };
+    std::sort(holes.begin(), holes.end(), [&](const Ring& lhs, const Ring& rhs) { return maxX(lhs) > maxX(rhs); });
+
+    while (!holes.empty()) {
+        const Ring hole = std::move(holes.front());
+        holes.erase(holes.begin());
+
+        if (!bridgeHole(outer, hole, holes))
+            return false;
+    }
+
+    std::vector<std::size_t> remaining(outer.size());
+    std::iota(remaining.begin(), remaining.end(), std::size_t{0});
+
+    // Resume the ear search where the last ear came off; restarting from 0 turns the clip quadratic per ear.
+    std::size_t cursor = 0;
+
+    while (remaining.size() > 3) {
+        const std::size_t count = remaining.size();
+        bool clipped = false;
+
+        for (std::size_t attempt = 0; attempt < count && !clipped; ++attempt) {
+            const std::size_t k = (cursor + attempt) % count;
+            const sf::Vector2f& a = outer[remaining[(k + count - 1) % count]];
+            const sf::Vector2f& b = outer[remaining[k]];
+            const sf::Vector2f& c = outer[remaining[(k + 1) % count]];
+
+            const double turn = cross(a, b, c);
+
+            // Collinear or doubled-back vertices (bridge seams) add no area; drop them outright.
+            if (std::abs(turn) <= EPSILON && (a == b || b == c || pointOnSegment(b, a, c))) {
+                remaining.erase(remaining.begin() + static_cast<std::ptrdiff_t>(k));
+                cursor = k == 0 ? 0 : k - 1;
+                clipped = true;
+                break;
+            }
+
+            if (turn <= EPSILON) continue;
+
+            bool isEar = true;
+            for (std::size_t j = 0; j < count && isEar; ++j) {
+                if (j == k || j == (k + 1) % count || j == (k + count - 1) % count) continue;
+
+                const sf::Vector2f& p = outer[remaining[j]];
+
+                // A second copy of a corner (from a hole bridge) blocks the ear if its own edges lead into it.
+                if (p == a || p == b || p == c) {
+                    isEar = !edgeEntersTriangle(p, outer[remaining[(j + count - 1) % count]], a, b, c) &&
+                            !edgeEntersTriangle(p, outer[remaining[(j + 1) % count]], a, b, c);
+                    continue;
+                }
+
+                isEar = !pointInTriangle(p, a, b, c);
+            }
+
+            if (!isEar) continue;
+
+            triangles.push_back(a);
+            triangles.push_back(b);
+            triangles.push_back(c);
+
+            remaining.erase(remaining.begin() + static_cast<std::ptrdiff_t>(k));
+            cursor = k == 0 ? 0 : k - 1;
+            clipped = true;
+        }
+
+        if (!clipped) return false;
+    }
+
+    if (std::abs(cross(outer[remaining[0]], outer[remaining[1]], outer[remaining[2]])) > EPSILON) {
+        triangles.push_back(outer[remaining[0]]);
+        triangles.push_back(outer[remaining[1]]);
+        triangles.push_back(outer[remaining[2]]);
+    }
+
+    return true;
+}
+
+void core::MergeConvexPieces(const std::vector<sf::Vector2f>& triangles, std::vector<Ring>& pieces) {
+    std::vector<Ring> working;
+    for (std::size_t i = 0; i + 2 < triangles.size(); i += 3)
+        working.push_back(Ring{triangles[i], triangles[i + 1], triangles[i + 2]});
+
+    // Directed edge -> piece that owns it; the neighbour across a -> b is whoever owns b -> a.
+    std::map<EdgeKey, std::size_t> owners;
+    for (std::size_t i = 0; i < working.size(); ++i)
+        for (std::size_t e = 0; e < 3; ++e)
+            owners[edgeKey(working[i][e], working[i][(e + 1) % 3])] = i;
+
+    std::vector<bool> alive(working.size(), true);
+
+    for (std::size_t i = 0; i < working.size(); ++i) {
+        if (!alive[i]) continue;
+
+        for (std::size_t e = 0; e < working[i].size();) {
+            const sf::Vector2f a = working[i][e];
+            const sf::Vector2f b = working[i][(e + 1) % working[i].size()];
+
+            const auto neighbour = owners.find(edgeKey(b, a));
+            if (neighbour == owners.end() || neighbour->second == i || !alive[neighbour->second] ||
+                !tryMerge(working[i], e, working[neighbour->second])) {
+                ++e;
+                continue;
+            }
+
+            const std::size_t j = neighbour->second;
+            owners.erase(edgeKey(a, b));
+            owners.erase(edgeKey(b, a));
+
+            for (std::size_t k = 0; k < working[j].size(); ++k) {
+                const auto owner = owners.find(edgeKey(working[j][k], working[j][(k + 1) % working[j].size()]));
+                if (owner != owners.end() && owner->second == j)
+                    owner->second = i;
+            }
+
+            alive[j] = false;
+            working[j].clear();
+        }
+    }
+
+    pieces.clear();
+    for (std::size_t i = 0; i < working.size(); ++i)
+        if (alive[i]) pieces.push_back(std::move(working[i]));
+}
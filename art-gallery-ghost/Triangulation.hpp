@@ -0,0 +1,23 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <vector>
+
+namespace core {
+    using Ring = std::vector<sf::Vector2f>;
+
+    struct PolygonWithHoles {
+        Ring outer;
+        std::vector<Ring> holes;
+    };
+
+    float SignedArea(const Ring& ring);
+
+    // Ear-clips the polygon after bridging every hole into the outer ring.
+    // Appends three vertices per triangle, all wound with positive SignedArea.
+    bool Triangulate(const PolygonWithHoles& polygon, std::vector<sf::Vector2f>& triangles);
+
+    // Greedily merges neighbouring triangles while the result stays convex (Hertel-Mehlhorn).
+    void MergeConvexPieces(const std::vector<sf::Vector2f>& triangles, std::vector<Ring>& pieces);
+}
@@ -0,0 +1,233 @@
+#include "Visibility.hpp"
+#include "Collision.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define VISIBILITY_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define VISIBILITY_SSE2
+#endif
+
+using namespace core;
+
+constexpr float PI = 3.141592f;
+
+namespace {
+    // Cone in the form the kernels use: unit axis, cosine of the half angle and squared radius.
+    struct ConeTest {
+        float originX;
+        float originY;
+        float axisX;
+        float axisY;
+        float cosHalf;
+        float radiusSq;
+    };
+
+    // Inside when within the radius and |d| * cos(half) <= d . axis, which needs no atan2.
+    std::uint8_t inCone(const ConeTest& cone, const float x, const float y) {
+        const float dx = x - cone.originX;
+        const float dy = y - cone.originY;
+        const float distSq = dx * dx + dy * dy;
+
+        return distSq <= cone.radiusSq && dx * cone.axisX + dy * cone.axisY >= std::sqrt(distSq) * cone.cosHalf;
+    }
+
+#if defined(VISIBILITY_AVX2)
+    constexpr std::size_t LANES = 8;
+
+    void coneLanes(const ConeTest& cone, const float* xs, const float* ys, std::uint8_t* inside) {
+        const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(xs), _mm256_set1_ps(cone.originX));
+        const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(ys), _mm256_set1_ps(cone.originY));
+        const __m256 distSq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        const __m256 dot = _mm256_add_ps(
+            _mm256_mul_ps(dx, _mm256_set1_ps(cone.axisX)), _mm256_mul_ps(dy, _mm256_set1_ps(cone.axisY)));
+
+        const __m256 hit = _mm256_and_ps(
+            _mm256_cmp_ps(distSq, _mm256_set1_ps(cone.radiusSq), _CMP_LE_OQ),
+            _mm256_cmp_ps(dot, _mm256_mul_ps(_mm256_sqrt_ps(distSq), _mm256_set1_ps(cone.cosHalf)), _CMP_GE_OQ));
+
+        const int mask = _mm256_movemask_ps(hit);
+        for (std::size_t lane = 0; lane < LANES; ++lane)
+            inside[lane] = static_cast<std::uint8_t>((mask >> lane) & 1);
+    }
+#elif defined(VISIBILITY_SSE2)
+    constexpr std::size_t LANES = 4;
+
+    void coneLanes(const ConeTest& cone, const float* xs, const float* ys, std::uint8_t* inside) {
+        const __m128 dx = _mm_sub_ps(_mm_loadu_ps(xs), _mm_set1_ps(cone.originX));
+        const __m128 dy = _mm_sub_ps(_mm_loadu_ps(ys), _mm_set1_ps(cone.originY));
+        const __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        const __m128 dot = _mm_add_ps(_mm_mul_ps(dx, _mm_set1_ps(cone.axisX)), _mm_mul_ps(dy, _mm_set1_ps(cone.axisY)));
+
+        const __m128 hit = _mm_and_ps(
+            _mm_cmple_ps(distSq, _mm_set1_ps(cone.radiusSq)),
+            _mm_cmpge_ps(dot, _mm_mul_ps(_mm_sqrt_ps(distSq), _mm_set1_ps(cone.cosHalf))));
+
+        const int mask = _mm_movemask_ps(hit);
+        for (std::size_t lane = 0; lane < LANES; ++lane)
+            inside[lane] = static_cast<std::uint8_t>((mask >> lane) & 1);
+    }
+#else
+    constexpr std::size_t LANES = 1;
+
+    void coneLanes(const ConeTest& cone, const float* xs, const float* ys, std::uint8_t* inside) {
+        inside[0] = inCone(cone, xs[0], ys[0]);
+    }
+#endif
+
+    void testCone(const ConeTest& cone, const float* xs, const float* ys, const std::size_t count, std::uint8_t* inside) {
+        std::size_t i = 0;
+        for (; i + LANES <= count; i += LANES)
+            coneLanes(cone, xs + i, ys + i, inside + i);
+
+        for (; i < count; ++i)
+            inside[i] = inCone(cone, xs[i], ys[i]);
+    }
+
+    ConeTest makeTest(const Cone& cone) {
+        const float axisRad = (cone.startAngle + cone.fanWidth * 0.5f) * PI / 180.f;
+        return ConeTest{
+            cone.origin.x, cone.origin.y,
+            std::cos(axisRad), std::sin(axisRad),
+            std::cos(std::min(cone.fanWidth, 360.f) * 0.5f * PI / 180.f),
+            cone.radius * cone.radius};
+    }
+}
+
+// The origin, both arc ends and any axis extreme the arc passes.
+sf::FloatRect core::ConeBounds(const Cone& cone) {
+    auto at = [&cone](const float degrees) {
+        const float rad = degrees * PI / 180.f;
+        return cone.origin + cone.radius * sf::Vector2f{std::cos(rad), std::sin(rad)};
+    };
+
+    sf::Vector2f min = cone.origin;
+    sf::Vector2f max = cone.origin;
+
+    auto include = [&min, &max](const sf::Vector2f& point) {
+        min = {std::min(min.x, point.x), std::min(min.y, point.y)};
+        max = {std::max(max.x, point.x), std::max(max.y, point.y)};
+    };
+
+    include(at(cone.startAngle));
+    include(at(cone.startAngle + cone.fanWidth));
+
+    for (int quadrant = 0; quadrant < 4; ++quadrant) {
+        const float extreme = 90.f * static_cast<float>(quadrant);
+        const float offset = std::fmod(std::fmod(extreme - cone.startAngle, 360.f) + 360.f, 360.f);
+        if (offset <= cone.fanWidth)
+            include(at(extreme));
+    }
+
+    return sf::FloatRect(min, max - min);
+}
+
+void core::ConeContains(const Cone& cone, const float* xs, const float* ys, std::size_t count, std::uint8_t* inside) {
+    testCone(makeTest(cone), xs, ys, count, inside);
+}
+
+int EntityGrid::column(const float x) const {
+    return std::clamp(static_cast<int>(std::floor((x - min.x) / cell)), 0, columns - 1);
+}
+
+int EntityGrid::row(const float y) const {
+    return std::clamp(static_cast<int>(std::floor((y - min.y) / cell)), 0, rows - 1);
+}
+
+void EntityGrid::Build(const float* xs, const float* ys, std::size_t count) {
+    sortedX.resize(count);
+    sortedY.resize(count);
+    ids.resize(count);
+
+    if (count == 0) {
+        columns = rows = 0;
+        cellStart.assign(1, 0);
+        return;
+    }
+
+    min = {xs[0], ys[0]};
+    sf::Vector2f max = min;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        min = {std::min(min.x, xs[i]), std::min(min.y, ys[i])};
+        max = {std::max(max.x, xs[i]), std::max(max.y, ys[i])};
+    }
+
+    // Widen the cells when entities are spread too far for the configured size.
+    const float extent = std::max(max.x - min.x, max.y - min.y);
+    cell = std::max(cellSize, extent / static_cast<float>(MAX_CELLS_PER_SIDE));
+    columns = static_cast<int>((max.x - min.x) / cell) + 1;
+    rows = static_cast<int>((max.y - min.y) / cell) + 1;
+
+    cellStart.assign(static_cast<std::size_t>(columns * rows) + 1, 0);
+
+    for (std::size_t i = 0; i < count; ++i)
+        ++cellStart[static_cast<std::size_t>(row(ys[i]) * columns + column(xs[i])) + 1];
+
+    for (std::size_t c = 1; c < cellStart.size(); ++c)
+        cellStart[c] += cellStart[c - 1];
+
+    // Scatter through the starts, then shift them back by one cell.
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::uint32_t slot = cellStart[static_cast<std::size_t>(row(ys[i]) * columns + column(xs[i]))]++;
+        sortedX[slot] = xs[i];
+        sortedY[slot] = ys[i];
+        ids[slot] = static_cast<std::uint32_t>(i);
+    }
+
+    std::copy_backward(cellStart.begin(), cellStart.end() - 1, cellStart.end());
+    cellStart[0] = 0;
+}
+
+void EntityGrid::QueryCone(const Cone& cone, const Collision* walls, std::vector<std::uint32_t>& lit) {
+    if (ids.empty() || cone.radius <= 0.f || cone.fanWidth <= 0.f) return;
+
+    const sf::FloatRect bounds = ConeBounds(cone);
+    if (bounds.position.x > min.x + cell * static_cast<float>(columns) || bounds.position.x + bounds.size.x < min.x ||
+        bounds.position.y > min.y + cell * static_cast<float>(rows) || bounds.position.y + bounds.size.y < min.y)
+        return;
+
+    const ConeTest test = makeTest(cone);
+
+    const int firstColumn = column(bounds.position.x);
+    const int lastColumn = column(bounds.position.x + bounds.size.x);
+    const int firstRow = row(bounds.position.y);
+    const int lastRow = row(bounds.position.y + bounds.size.y);
+
+    candidateX.clear();
+    candidateY.clear();
+    candidateIds.clear();
+
+    for (int r = firstRow; r <= lastRow; ++r) {
+        const std::uint32_t begin = cellStart[static_cast<std::size_t>(r * columns + firstColumn)];
+        const std::uint32_t end = cellStart[static_cast<std::size_t>(r * columns + lastColumn) + 1];
+        const std::size_t count = end - begin;
+        if (count == 0) continue;
+
+        if (inCone.size() < count) inCone.resize(count);
+        testCone(test, sortedX.data() + begin, sortedY.data() + begin, count, inCone.data());
+
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!inCone[i]) continue;
+
+            candidateX.push_back(sortedX[begin + i]);
+            candidateY.push_back(sortedY[begin + i]);
+            candidateIds.push_back(ids[begin + i]);
+        }
+    }
+
+    if (!walls) {
+        lit.insert(lit.end(), candidateIds.begin(), candidateIds.end());
+        return;
+    }
+
+    blocked.resize(candidateIds.size());
+    walls->SegmentsBlocked(cone.origin, candidateX.data(), candidateY.data(), candidateIds.size(), blocked.data());
+
+    for (std::size_t i = 0; i < candidateIds.size(); ++i)
+        if (!blocked[i]) lit.push_back(candidateIds[i]);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstdint>
+#include <vector>
+
+class Collision;
+
+namespace core {
+    // Flashlight cone in world space. Angles are in degrees, as FlashLight stores them.
+    struct Cone {
+        sf::Vector2f origin;
+        float startAngle = 0.f;
+        float fanWidth = 0.f;
+        float radius = 0.f;
+    };
+
+    // Axis-aligned bounds of the cone's circular sector.
+    sf::FloatRect ConeBounds(const Cone& cone);
+
+    // inside[i] is 1 when (xs[i], ys[i]) lies in the cone; occlusion is not considered.
+    void ConeContains(const Cone& cone, const float* xs, const float* ys, std::size_t count, std::uint8_t* inside);
+
+    // Uniform grid over entity positions, rebuilt once per tick. A counting sort keeps every
+    // cell's entities contiguous in SoA arrays, so a row of cells is one run for the SIMD cone test.
+    class EntityGrid {
+    public:
+        constexpr static float DEFAULT_CELL_SIZE = 256.f;
+        constexpr static int MAX_CELLS_PER_SIDE = 128;
+
+        explicit EntityGrid(const float cellSize = DEFAULT_CELL_SIZE) : cellSize(cellSize) {}
+
+        // Entity ids are indices into xs / ys.
+        void Build(const float* xs, const float* ys, std::size_t count);
+
+        std::size_t GetCount() const { return ids.size(); }
+
+        // Appends the id of every entity inside the cone whose sight line from the cone origin
+        // crosses no edge of `walls`. Pass nullptr to skip occlusion.
+        void QueryCone(const Cone& cone, const Collision* walls, std::vector<std::uint32_t>& lit);
+
+    private:
+        float cellSize;
+        float cell = DEFAULT_CELL_SIZE;
+        sf::Vector2f min;
+        int columns = 0;
+        int rows = 0;
+
+        // Entities of cell c are [cellStart[c], cellStart[c + 1]) in the sorted arrays.
+        std::vector<std::uint32_t> cellStart;
+        std::vector<float> sortedX;
+        std::vector<float> sortedY;
+        std::vector<std::uint32_t> ids;
+
+        // Per-query scratch, kept to avoid allocating every tick.
+        std::vector<std::uint8_t> inCone;
+        std::vector<float> candidateX;
+        std::vector<float> candidateY;
+        std::vector<std::uint32_t> candidateIds;
+        std::vector<std::uint8_t> blocked;
+
+        int column(const float x) const;
+        int row(const float y) const;
+    };
+}
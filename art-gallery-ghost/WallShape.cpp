@@ -0,0 +1,649 @@
+#include "WallShape.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace core;
+
+namespace {
+    constexpr float PI = 3.141592f;
+
+    // Fragments thinner than this are dropped rather than kept as slivers.
+    constexpr float MIN_AREA = 1e-3f;
+
+    // Vertices this close to a clip line count as on it, and vertices this close together are merged,
+    // so no edge is short enough for float error to flip its direction.
+    constexpr float SNAP = 1e-2f;
+
+    // Point tests give the solid this much slack and skip edges shorter than MIN_EDGE, whose
+    // direction is mostly rounding, so seams between neighbouring pieces never open a crack.
+    constexpr float SOLID_SLACK = 0.05f;
+    constexpr float MIN_EDGE = 0.5f;
+
+    // Marks an edge made along a crater line until exposeCut() decides which part of it is surface.
+    constexpr std::uint8_t CUT = 2;
+
+    float cross(const sf::Vector2f& lhs, const sf::Vector2f& rhs) {
+        return lhs.x * rhs.y - lhs.y * rhs.x;
+    }
+
+    float dot(const sf::Vector2f& lhs, const sf::Vector2f& rhs) {
+        return lhs.x * rhs.x + lhs.y * rhs.y;
+    }
+
+    bool overlaps(const sf::FloatRect& lhs, const sf::FloatRect& rhs) {
+        return lhs.position.x <= rhs.position.x + rhs.size.x && rhs.position.x <= lhs.position.x + lhs.size.x &&
+               lhs.position.y <= rhs.position.y + rhs.size.y && rhs.position.y <= lhs.position.y + lhs.size.y;
+    }
+
+    bool contains(const sf::FloatRect& rect, const sf::Vector2f& point, const float slack) {
+        return point.x >= rect.position.x - slack && point.x <= rect.position.x + rect.size.x + slack &&
+               point.y >= rect.position.y - slack && point.y <= rect.position.y + rect.size.y + slack;
+    }
+
+    sf::FloatRect boundsOf(const Ring& points) {
+        sf::Vector2f min = points.front();
+        sf::Vector2f max = min;
+
+        for (const auto& point : points) {
+            min = {std::min(min.x, point.x), std::min(min.y, point.y)};
+            max = {std::max(max.x, point.x), std::max(max.y, point.y)};
+        }
+
+        return {min, max - min};
+    }
+
+    bool isRingEdge(const Ring& ring, const sf::Vector2f& a, const sf::Vector2f& b) {
+        for (std::size_t i = 0; i < ring.size(); ++i) {
+            const sf::Vector2f& from = ring[i];
+            const sf::Vector2f& to = ring[(i + 1) % ring.size()];
+
+            if ((from == a && to == b) || (from == b && to == a))
+                return true;
+        }
+
+        return false;
+    }
+
+    bool segmentsCross(const sf::Vector2f& from, const sf::Vector2f& to, const sf::Vector2f& start, const sf::Vector2f& end) {
+        const sf::Vector2f d = to - from;
+        const sf::Vector2f a = start - from;
+        const sf::Vector2f b = end - from;
+        const sf::Vector2f e = b - a;
+
+        const float sideA = cross(d, a);
+        const float sideB = cross(d, b);
+        const float sideO = cross(a, e);
+        const float sideQ = cross(e, d - a);
+
+        return sideA * sideB < 0.f && sideO * sideQ < 0.f;
+    }
+}
+
+WallShape::WallShape(const PolygonWithHoles& floor, const float thickness) {
+    if (floor.outer.size() < 3) return;
+
+    const sf::FloatRect floorBounds = boundsOf(floor.outer);
+    origin = floorBounds.position - sf::Vector2f{thickness, thickness};
+    columns = std::max(1, static_cast<int>(std::ceil((floorBounds.size.x + 2.f * thickness) / TILE_SIZE)));
+    rows = std::max(1, static_cast<int>(std::ceil((floorBounds.size.y + 2.f * thickness) / TILE_SIZE)));
+    chunkColumns = (columns + CHUNK_TILES - 1) / CHUNK_TILES;
+
+    const int chunkRows = (rows + CHUNK_TILES - 1) / CHUNK_TILES;
+    tiles.resize(static_cast<std::size_t>(columns) * rows);
+    chunks.resize(static_cast<std::size_t>(chunkColumns) * chunkRows);
+    revisions.assign(chunks.size(), 0);
+
+    for (std::uint32_t chunk = 0; chunk < chunks.size(); ++chunk)
+        dirtyChunks.push_back(chunk);
+
+    const sf::Vector2f corner = origin + sf::Vector2f{columns * TILE_SIZE, rows * TILE_SIZE};
+    const Ring frame{origin, {corner.x, origin.y}, corner, {origin.x, corner.y}};
+
+    // The band between the frame and the outer ring, plus every hole, split into convex pieces.
+    std::vector<sf::Vector2f> triangles;
+    valid = Triangulate(PolygonWithHoles{frame, {floor.outer}}, triangles);
+    for (const auto& hole : floor.holes)
+        valid = Triangulate(PolygonWithHoles{hole, {}}, triangles) && valid;
+
+    std::vector<Ring> convex;
+    MergeConvexPieces(triangles, convex);
+
+    for (auto& points : convex) {
+        Piece piece;
+        piece.exposed.resize(points.size());
+
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            const sf::Vector2f& a = points[i];
+            const sf::Vector2f& b = points[(i + 1) % points.size()];
+
+            bool surface = isRingEdge(floor.outer, a, b);
+            for (std::size_t h = 0; !surface && h < floor.holes.size(); ++h)
+                surface = isRingEdge(floor.holes[h], a, b);
+
+            piece.exposed[i] = surface ? 1 : 0;
+        }
+
+        piece.bounds = boundsOf(points);
+        piece.points = std::move(points);
+        addPiece(piece);
+    }
+
+    for (auto& tile : tiles)
+        rebuildSurface(tile);
+}
+
+void WallShape::SetFillColor(const sf::Color& color) {
+    floorColor = color;
+}
+
+void WallShape::SetWallColor(const sf::Color& color) {
+    wallColor = color;
+
+    for (int row = 0; row < rows; row += CHUNK_TILES)
+        for (int column = 0; column < columns; column += CHUNK_TILES)
+            markDirty(column, row);
+}
+
+WallShape::Tile* WallShape::tileAt(const int column, const int row) {
+    if (column < 0 || row < 0 || column >= columns || row >= rows) return nullptr;
+    return &tiles[static_cast<std::size_t>(row) * columns + column];
+}
+
+const WallShape::Tile* WallShape::tileAt(const int column, const int row) const {
+    if (column < 0 || row < 0 || column >= columns || row >= rows) return nullptr;
+    return &tiles[static_cast<std::size_t>(row) * columns + column];
+}
+
+namespace {
+    // Keeps the part of a convex piece on the left of the directed line a -> b. Edges made along
+    // the line are flagged `cutFlag`; the rest keep their own flag.
+    void clip(const Ring& points, const std::vector<std::uint8_t>& exposed, const sf::Vector2f& a, const sf::Vector2f& b,
+              const std::uint8_t cutFlag, Ring& outPoints, std::vector<std::uint8_t>& outExposed) {
+        outPoints.clear();
+        outExposed.clear();
+
+        const sf::Vector2f line = b - a;
+        const float tolerance = SNAP * std::sqrt(dot(line, line));
+        const std::size_t count = points.size();
+
+        auto sideOf = [&](const sf::Vector2f& point) {
+            const float side = cross(line, point - a);
+            return std::abs(side) <= tolerance ? 0.f : side;
+        };
+
+        // A vertex landing on the previous one replaces it, taking over the edge that leaves it.
+        auto emit = [&](const sf::Vector2f& point, const std::uint8_t flag) {
+            if (!outPoints.empty()) {
+                const sf::Vector2f gap = point - outPoints.back();
+                if (dot(gap, gap) <= SNAP * SNAP) {
+                    outExposed.back() = flag;
+                    return;
+                }
+            }
+
+            outPoints.push_back(point);
+            outExposed.push_back(flag);
+        };
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const sf::Vector2f& current = points[i];
+            const sf::Vector2f& next = points[(i + 1) % count];
+            const float side = sideOf(current);
+            const float nextSide = sideOf(next);
+
+            if (side >= 0.f) {
+                if (nextSide >= 0.f)
+                    emit(current, exposed[i]);
+                else if (side > 0.f) {
+                    emit(current, exposed[i]);
+                    emit(current + (next - current) * (side / (side - nextSide)), cutFlag);
+                }
+                else
+                    emit(current, cutFlag);
+            }
+            else if (nextSide > 0.f)
+                emit(current + (next - current) * (side / (side - nextSide)), exposed[i]);
+        }
+
+        if (outPoints.size() > 1) {
+            const sf::Vector2f gap = outPoints.front() - outPoints.back();
+            if (dot(gap, gap) <= SNAP * SNAP) {
+                outPoints.pop_back();
+                outExposed.pop_back();
+            }
+        }
+
+        if (outPoints.size() < 3) {
+            outPoints.clear();
+            outExposed.clear();
+        }
+    }
+
+    // Splits the CUT edge of a fragment so that only the part along the crater side a -> b is surface;
+    // the rest of the line runs between fragments of the same piece.
+    void exposeCut(Ring& points, std::vector<std::uint8_t>& exposed, const sf::Vector2f& a, const sf::Vector2f& b) {
+        const sf::Vector2f line = b - a;
+        const float lengthSq = dot(line, line);
+        if (lengthSq <= 0.f) return;
+
+        const float tolerance = SNAP / std::sqrt(lengthSq);
+
+        auto covered = [](const float from, const float to) {
+            const float middle = (from + to) * 0.5f;
+            return static_cast<std::uint8_t>(middle > 0.f && middle < 1.f ? 1 : 0);
+        };
+
+        Ring splitPoints;
+        std::vector<std::uint8_t> splitExposed;
+
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            const sf::Vector2f& p = points[i];
+            splitPoints.push_back(p);
+
+            if (exposed[i] != CUT) {
+                splitExposed.push_back(exposed[i]);
+                continue;
+            }
+
+            const float from = dot(p - a, line) / lengthSq;
+            const float to = dot(points[(i + 1) % points.size()] - a, line) / lengthSq;
+            const float breaks[2] = {from < to ? 0.f : 1.f, from < to ? 1.f : 0.f};
+
+            float last = from;
+            for (const float t : breaks) {
+                if ((t - from) * (t - to) >= 0.f || std::abs(t - from) <= tolerance || std::abs(t - to) <= tolerance) continue;
+
+                splitExposed.push_back(covered(last, t));
+                splitPoints.push_back(a + line * t);
+                last = t;
+            }
+
+            splitExposed.push_back(covered(last, to));
+        }
+
+        points.swap(splitPoints);
+        exposed.swap(splitExposed);
+    }
+}
+
+void WallShape::addPiece(const Piece& piece) {
+    const int firstColumn = std::max(0, static_cast<int>(std::floor((piece.bounds.position.x - origin.x) / TILE_SIZE)));
+    const int lastColumn = std::min(columns - 1, static_cast<int>(std::floor((piece.bounds.position.x + piece.bounds.size.x - origin.x) / TILE_SIZE)));
+    const int firstRow = std::max(0, static_cast<int>(std::floor((piece.bounds.position.y - origin.y) / TILE_SIZE)));
+    const int lastRow = std::min(rows - 1, static_cast<int>(std::floor((piece.bounds.position.y + piece.bounds.size.y - origin.y) / TILE_SIZE)));
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            const sf::Vector2f min = origin + sf::Vector2f{column * TILE_SIZE, row * TILE_SIZE};
+            const sf::Vector2f max = min + sf::Vector2f{TILE_SIZE, TILE_SIZE};
+            const sf::Vector2f corners[4] = {min, {max.x, min.y}, max, {min.x, max.y}};
+
+            clipped = piece;
+            for (std::size_t side = 0; side < 4 && !clipped.points.empty(); ++side) {
+                clip(clipped.points, clipped.exposed, corners[side], corners[(side + 1) % 4], 0, remaining.points, remaining.exposed);
+                std::swap(clipped, remaining);
+            }
+
+            if (clipped.points.empty() || SignedArea(clipped.points) < MIN_AREA) continue;
+
+            clipped.bounds = boundsOf(clipped.points);
+            tiles[static_cast<std::size_t>(row) * columns + column].pieces.push_back(clipped);
+            ++pieceCount;
+        }
+    }
+}
+
+bool WallShape::subtract(const Piece& piece, const Ring& crater, std::vector<Piece>& fragments) {
+    // Most pieces near a crater lie wholly outside one of its sides; skip those without clipping.
+    for (std::size_t side = 0; side < crater.size(); ++side) {
+        const sf::Vector2f& a = crater[side];
+        const sf::Vector2f line = crater[(side + 1) % crater.size()] - a;
+
+        const bool outside = std::all_of(piece.points.begin(), piece.points.end(),
+            [&](const sf::Vector2f& point) { return cross(line, point - a) <= 0.f; });
+        if (outside) return false;
+    }
+
+    const std::size_t first = fragments.size();
+    remaining = piece;
+
+    // Peel off the part outside each crater side in turn; whatever is left at the end is inside it.
+    for (std::size_t side = 0; side < crater.size(); ++side) {
+        const sf::Vector2f& a = crater[side];
+        const sf::Vector2f& b = crater[(side + 1) % crater.size()];
+
+        clip(remaining.points, remaining.exposed, b, a, CUT, clipped.points, clipped.exposed);
+        if (!clipped.points.empty() && SignedArea(clipped.points) >= MIN_AREA) {
+            exposeCut(clipped.points, clipped.exposed, a, b);
+            clipped.bounds = boundsOf(clipped.points);
+            fragments.push_back(clipped);
+        }
+
+        clip(remaining.points, remaining.exposed, a, b, 0, clipped.points, clipped.exposed);
+        std::swap(remaining, clipped);
+
+        if (remaining.points.empty()) break;
+    }
+
+    if (remaining.points.empty() || SignedArea(remaining.points) < MIN_AREA) {
+        fragments.resize(first);
+        return false;
+    }
+
+    return true;
+}
+
+bool WallShape::Carve(const sf::Vector2f& center, const float radius) {
+    if (tiles.empty() || radius <= 0.f) return false;
+
+    Ring crater(CRATER_SIDES);
+    for (std::size_t side = 0; side < CRATER_SIDES; ++side) {
+        const float rad = 2.f * PI * static_cast<float>(side) / CRATER_SIDES;
+        crater[side] = center + radius * sf::Vector2f{std::cos(rad), std::sin(rad)};
+    }
+
+    const sf::FloatRect craterBounds = boundsOf(crater);
+    const int firstColumn = static_cast<int>(std::floor((craterBounds.position.x - origin.x) / TILE_SIZE));
+    const int lastColumn = static_cast<int>(std::floor((craterBounds.position.x + craterBounds.size.x - origin.x) / TILE_SIZE));
+    const int firstRow = static_cast<int>(std::floor((craterBounds.position.y - origin.y) / TILE_SIZE));
+    const int lastRow = static_cast<int>(std::floor((craterBounds.position.y + craterBounds.size.y - origin.y) / TILE_SIZE));
+
+    // The outermost ring of tiles is never carved, so nothing can tunnel out of the frame.
+    if (firstColumn < 1 || firstRow < 1 || lastColumn > columns - 2 || lastRow > rows - 2) return false;
+
+    bool hit = false;
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            Tile& tile = tiles[static_cast<std::size_t>(row) * columns + column];
+            carved.clear();
+            cut.clear();
+
+            for (std::size_t i = 0; i < tile.pieces.size(); ++i) {
+                if (overlaps(tile.pieces[i].bounds, craterBounds) && subtract(tile.pieces[i], crater, carved))
+                    cut.push_back(i);
+            }
+
+            if (cut.empty()) continue;
+
+            // Untouched pieces stay where they are; cut ones are swapped out from the back.
+            for (auto index = cut.rbegin(); index != cut.rend(); ++index) {
+                std::swap(tile.pieces[*index], tile.pieces.back());
+                tile.pieces.pop_back();
+            }
+
+            for (auto& fragment : carved)
+                tile.pieces.push_back(std::move(fragment));
+
+            pieceCount = pieceCount - cut.size() + carved.size();
+            rebuildSurface(tile);
+            markDirty(column, row);
+            ++revisions[chunkOf(column, row)];
+            hit = true;
+        }
+    }
+
+    return hit;
+}
+
+void WallShape::GetChunksNear(const sf::Vector2f& center, const float radius, std::vector<std::uint32_t>& out) const {
+    out.clear();
+    if (tiles.empty()) return;
+
+    auto clampTile = [](const float offset, const int count) {
+        return std::clamp(static_cast<int>(std::floor(offset / TILE_SIZE)), 0, count - 1);
+    };
+
+    const int firstColumn = clampTile(center.x - radius - origin.x, columns) / CHUNK_TILES;
+    const int lastColumn = clampTile(center.x + radius - origin.x, columns) / CHUNK_TILES;
+    const int firstRow = clampTile(center.y - radius - origin.y, rows) / CHUNK_TILES;
+    const int lastRow = clampTile(center.y + radius - origin.y, rows) / CHUNK_TILES;
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column)
+            out.push_back(static_cast<std::uint32_t>(row * chunkColumns + column));
+    }
+}
+
+void WallShape::rebuildSurface(Tile& tile) {
+    tile.surface.clear();
+
+    for (const auto& piece : tile.pieces) {
+        for (std::size_t i = 0; i < piece.points.size(); ++i) {
+            if (piece.exposed[i])
+                tile.surface.push_back({piece.points[i], piece.points[(i + 1) % piece.points.size()]});
+        }
+    }
+}
+
+std::uint32_t WallShape::chunkOf(const int column, const int row) const {
+    return static_cast<std::uint32_t>((row / CHUNK_TILES) * chunkColumns + column / CHUNK_TILES);
+}
+
+void WallShape::markDirty(const int column, const int row) {
+    const std::uint32_t chunk = chunkOf(column, row);
+    if (chunks[chunk].dirty) return;
+
+    chunks[chunk].dirty = true;
+    dirtyChunks.push_back(chunk);
+}
+
+bool WallShape::IsSolid(const sf::Vector2f& point) const {
+    const Tile* tile = tileAt(static_cast<int>(std::floor((point.x - origin.x) / TILE_SIZE)),
+                              static_cast<int>(std::floor((point.y - origin.y) / TILE_SIZE)));
+    if (!tile) return true;
+
+    for (const auto& piece : tile->pieces) {
+        if (!contains(piece.bounds, point, SOLID_SLACK)) continue;
+
+        bool inside = true;
+        for (std::size_t i = 0, j = piece.points.size() - 1; inside && i < piece.points.size(); j = i++) {
+            const sf::Vector2f edge = piece.points[i] - piece.points[j];
+            const float lengthSq = dot(edge, edge);
+            if (lengthSq < MIN_EDGE * MIN_EDGE) continue;
+
+            inside = cross(edge, point - piece.points[j]) >= -SOLID_SLACK * std::sqrt(lengthSq);
+        }
+
+        if (inside) return true;
+    }
+
+    return false;
+}
+
+bool WallShape::GetClosestSurfacePoint(const sf::Vector2f& point, sf::Vector2f& closest) const {
+    if (tiles.empty()) return false;
+
+    const int column = std::clamp(static_cast<int>(std::floor((point.x - origin.x) / TILE_SIZE)), 0, columns - 1);
+    const int row = std::clamp(static_cast<int>(std::floor((point.y - origin.y) / TILE_SIZE)), 0, rows - 1);
+
+    float best = std::numeric_limits<float>::max();
+    bool found = false;
+
+    auto visit = [&](const Tile* tile) {
+        if (!tile) return;
+
+        for (const auto& edge : tile->surface) {
+            const sf::Vector2f line = edge.end - edge.start;
+            const float lengthSq = dot(line, line);
+            const float t = lengthSq > 0.f ? std::clamp(dot(point - edge.start, line) / lengthSq, 0.f, 1.f) : 0.f;
+
+            const sf::Vector2f candidate = edge.start + line * t;
+            const float distSq = dot(point - candidate, point - candidate);
+
+            if (distSq < best) {
+                best = distSq;
+                closest = candidate;
+                found = true;
+            }
+        }
+    };
+
+    // Square rings of tiles around the point; ring k is at least (k - 1) tiles away.
+    for (int ring = 0; ring <= std::max(columns, rows); ++ring) {
+        const float reach = static_cast<float>(std::max(0, ring - 1)) * TILE_SIZE;
+        if (found && best <= reach * reach) break;
+
+        for (int dr = -ring; dr <= ring; ++dr) {
+            const bool edgeRow = dr == -ring || dr == ring;
+
+            for (int dc = -ring; dc <= ring; dc += edgeRow ? 1 : std::max(1, 2 * ring))
+                visit(tileAt(column + dc, row + dr));
+        }
+    }
+
+    return found;
+}
+
+bool WallShape::SegmentBlocked(const sf::Vector2f& from, const sf::Vector2f& to) const {
+    if (tiles.empty()) return false;
+
+    // Walk the tiles the segment passes through; surface edges never leave their tile.
+    const sf::Vector2f start = (from - origin) / TILE_SIZE;
+    const sf::Vector2f end = (to - origin) / TILE_SIZE;
+    const sf::Vector2f delta = end - start;
+
+    int column = static_cast<int>(std::floor(start.x));
+    int row = static_cast<int>(std::floor(start.y));
+    const int steps = std::abs(static_cast<int>(std::floor(end.x)) - column) + std::abs(static_cast<int>(std::floor(end.y)) - row);
+
+    const int stepColumn = delta.x > 0.f ? 1 : -1;
+    const int stepRow = delta.y > 0.f ? 1 : -1;
+    const float infinity = std::numeric_limits<float>::infinity();
+
+    float nextX = delta.x != 0.f ? (static_cast<float>(column + (stepColumn > 0 ? 1 : 0)) - start.x) / delta.x : infinity;
+    float nextY = delta.y != 0.f ? (static_cast<float>(row + (stepRow > 0 ? 1 : 0)) - start.y) / delta.y : infinity;
+    const float stepX = delta.x != 0.f ? std::abs(1.f / delta.x) : infinity;
+    const float stepY = delta.y != 0.f ? std::abs(1.f / delta.y) : infinity;
+
+    for (int step = 0;; ++step) {
+        if (const Tile* tile = tileAt(column, row)) {
+            for (const auto& edge : tile->surface) {
+                if (segmentsCross(from, to, edge.start, edge.end))
+                    return true;
+            }
+        }
+
+        if (step >= steps) break;
+
+        if (nextX < nextY) {
+            column += stepColumn;
+            nextX += stepX;
+        }
+        else {
+            row += stepRow;
+            nextY += stepY;
+        }
+    }
+
+    return false;
+}
+
+void WallShape::WriteChunk(const std::size_t chunk, ByteWriter& out) const {
+    const int firstColumn = static_cast<int>(chunk % chunkColumns) * CHUNK_TILES;
+    const int firstRow = static_cast<int>(chunk / chunkColumns) * CHUNK_TILES;
+
+    for (int row = firstRow; row < std::min(rows, firstRow + CHUNK_TILES); ++row) {
+        for (int column = firstColumn; column < std::min(columns, firstColumn + CHUNK_TILES); ++column) {
+            const auto& pieces = tiles[static_cast<std::size_t>(row) * columns + column].pieces;
+            out.Write(static_cast<std::uint32_t>(pieces.size()));
+
+            for (const auto& piece : pieces) {
+                out.Write(static_cast<std::uint32_t>(piece.points.size()));
+                out.WriteBytes(piece.points.data(), piece.points.size() * sizeof(sf::Vector2f));
+                out.WriteBytes(piece.exposed.data(), piece.exposed.size());
+            }
+        }
+    }
+}
+
+bool WallShape::ReadChunk(const std::size_t chunk, ByteReader& in) {
+    if (chunk >= chunks.size()) return false;
+
+    const int firstColumn = static_cast<int>(chunk % chunkColumns) * CHUNK_TILES;
+    const int firstRow = static_cast<int>(chunk / chunkColumns) * CHUNK_TILES;
+    const int lastColumn = std::min(columns, firstColumn + CHUNK_TILES);
+    const int lastRow = std::min(rows, firstRow + CHUNK_TILES);
+
+    // Parsed in full before anything is replaced.
+    std::vector<std::vector<Piece>> loaded(static_cast<std::size_t>((lastRow - firstRow) * (lastColumn - firstColumn)));
+
+    for (auto& pieces : loaded) {
+        std::uint32_t count = 0;
+        if (!in.Read(count) || count > in.GetRemaining()) return false;
+
+        pieces.resize(count);
+        for (auto& piece : pieces) {
+            std::uint32_t points = 0;
+            if (!in.Read(points) || points < 3 || points > in.GetRemaining()) return false;
+
+            piece.points.resize(points);
+            piece.exposed.resize(points);
+            if (!in.ReadBytes(piece.points.data(), points * sizeof(sf::Vector2f)) || !in.ReadBytes(piece.exposed.data(), points))
+                return false;
+
+            piece.bounds = boundsOf(piece.points);
+        }
+    }
+
+    if (!in.AtEnd()) return false;
+
+    std::size_t next = 0;
+    for (int row = firstRow; row < lastRow; ++row) {
+        for (int column = firstColumn; column < lastColumn; ++column) {
+            Tile& tile = tiles[static_cast<std::size_t>(row) * columns + column];
+
+            pieceCount = pieceCount - tile.pieces.size() + loaded[next].size();
+            tile.pieces = std::move(loaded[next++]);
+            rebuildSurface(tile);
+        }
+    }
+
+    markDirty(firstColumn, firstRow);
+    ++revisions[chunk];
+    return true;
+}
+
+void WallShape::tessellate(const std::size_t chunk) const {
+    auto& vertices = chunks[chunk].vertices;
+    vertices.clear();
+
+    const int firstColumn = static_cast<int>(chunk % chunkColumns) * CHUNK_TILES;
+    const int firstRow = static_cast<int>(chunk / chunkColumns) * CHUNK_TILES;
+
+    for (int row = firstRow; row < std::min(rows, firstRow + CHUNK_TILES); ++row) {
+        for (int column = firstColumn; column < std::min(columns, firstColumn + CHUNK_TILES); ++column) {
+            for (const auto& piece : tiles[static_cast<std::size_t>(row) * columns + column].pieces) {
+                for (std::size_t i = 1; i + 1 < piece.points.size(); ++i) {
+                    vertices.push_back(sf::Vertex{piece.points[0], wallColor});
+                    vertices.push_back(sf::Vertex{piece.points[i], wallColor});
+                    vertices.push_back(sf::Vertex{piece.points[i + 1], wallColor});
+                }
+            }
+        }
+    }
+}
+
+void WallShape::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    for (const std::uint32_t chunk : dirtyChunks) {
+        tessellate(chunk);
+        chunks[chunk].dirty = false;
+    }
+    dirtyChunks.clear();
+
+    const sf::FloatRect frame = GetBounds();
+    const sf::Vertex quad[] = {
+        {frame.position, floorColor},
+        {frame.position + sf::Vector2f{frame.size.x, 0.f}, floorColor},
+        {frame.position + sf::Vector2f{0.f, frame.size.y}, floorColor},
+        {frame.position + frame.size, floorColor},
+    };
+    target.draw(quad, 4, sf::PrimitiveType::TriangleStrip, states);
+
+    for (const auto& chunk : chunks) {
+        if (!chunk.vertices.empty())
+            target.draw(chunk.vertices.data(), chunk.vertices.size(), sf::PrimitiveType::Triangles, states);
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "Triangulation.hpp"
+#include "ByteStream.hpp"
+
+// Solid walls around a floor plan, kept as convex pieces clipped to a uniform grid of tiles. A
+// crater only re-clips the pieces in the tiles under it, rebuilds those tiles' surface edges and
+// re-tessellates the render chunks they fall in, so sustained fire never touches the whole map.
+class WallShape : public sf::Drawable {
+public:
+    constexpr static float DEFAULT_THICKNESS = 240.f;
+    constexpr static float TILE_SIZE = 64.f;
+    constexpr static int CHUNK_TILES = 16;
+    constexpr static std::size_t CRATER_SIDES = 8;
+
+    // Everything between the floor's outer ring and a frame `thickness` beyond it is solid, and so
+    // is every hole.
+    explicit WallShape(const core::PolygonWithHoles& floor, const float thickness = DEFAULT_THICKNESS);
+
+    void SetFillColor(const sf::Color& color);
+    void SetWallColor(const sf::Color& color);
+
+    bool IsValid() const { return valid; }
+
+    // The frame; points outside it are solid.
+    sf::FloatRect GetBounds() const { return {origin, {columns * TILE_SIZE, rows * TILE_SIZE}}; }
+
+    // Removes a regular polygon of CRATER_SIDES around `center`. False when nothing solid was hit.
+    bool Carve(const sf::Vector2f& center, const float radius);
+
+    // Queries are in local space. The surface is every edge between solid and floor.
+    bool IsSolid(const sf::Vector2f& point) const;
+    bool GetClosestSurfacePoint(const sf::Vector2f& point, sf::Vector2f& closest) const;
+    bool SegmentBlocked(const sf::Vector2f& from, const sf::Vector2f& to) const;
+
+    std::size_t GetPieceCount() const { return pieceCount; }
+    std::size_t GetChunkCount() const { return chunks.size(); }
+    std::size_t GetChunkVertexCount(const std::size_t chunk) const { return chunks[chunk].vertices.size(); }
+
+    // The chunks a crater of `radius` around `center` can reshape, so they can be saved first.
+    void GetChunksNear(const sf::Vector2f& center, const float radius, std::vector<std::uint32_t>& out) const;
+
+    // Bumped whenever a crater or ReadChunk reshapes one of the chunk's tiles.
+    std::uint32_t GetChunkRevision(const std::size_t chunk) const { return revisions[chunk]; }
+
+    // Every piece in the chunk's tiles. ReadChunk only accepts data written by a shape built from
+    // the same floor plan; on malformed data it returns false and leaves the chunk as it was.
+    void WriteChunk(const std::size_t chunk, core::ByteWriter& out) const;
+    bool ReadChunk(const std::size_t chunk, core::ByteReader& in);
+
+private:
+    // Convex and wound with positive SignedArea. exposed[i] is 1 when the edge from points[i] to
+    // points[i + 1] borders the floor; edges along tile borders and between pieces are not.
+    struct Piece {
+        core::Ring points;
+        std::vector<std::uint8_t> exposed;
+        sf::FloatRect bounds;
+    };
+
+    struct Edge {
+        sf::Vector2f start;
+        sf::Vector2f end;
+    };
+
+    struct Tile {
+        std::vector<Piece> pieces;
+        std::vector<Edge> surface;
+    };
+
+    struct Chunk {
+        std::vector<sf::Vertex> vertices;
+        bool dirty = true;
+    };
+
+    sf::Vector2f origin;
+    int columns = 0;
+    int rows = 0;
+    int chunkColumns = 0;
+
+    std::vector<Tile> tiles;
+    std::size_t pieceCount = 0;
+    bool valid = false;
+
+    sf::Color floorColor = sf::Color::White;
+    sf::Color wallColor = sf::Color::Black;
+
+    // Chunks are re-tessellated on the next draw after a carve touches one of their tiles.
+    mutable std::vector<Chunk> chunks;
+    mutable std::vector<std::uint32_t> dirtyChunks;
+    std::vector<std::uint32_t> revisions;
+
+    // Per-carve scratch, kept to avoid allocating on every shot.
+    std::vector<Piece> carved;
+    std::vector<std::size_t> cut;
+    Piece remaining;
+    Piece clipped;
+
+    Tile* tileAt(const int column, const int row);
+    const Tile* tileAt(const int column, const int row) const;
+
+    void addPiece(const Piece& piece);
+    bool subtract(const Piece& piece, const core::Ring& crater, std::vector<Piece>& fragments);
+    void rebuildSurface(Tile& tile);
+    std::uint32_t chunkOf(const int column, const int row) const;
+    void markDirty(const int column, const int row);
+    void tessellate(const std::size_t chunk) const;
+
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+};
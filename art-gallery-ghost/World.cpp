@@ -0,0 +1,136 @@
+#include "World.hpp"
+
+#include "Movement.hpp"
+#include "Collision.hpp"
+#include "Gun.hpp"
+#include "FlashLight.hpp"
+#include "Autosave.hpp"
+#include "ByteStream.hpp"
+#include "MemoryStats.hpp"
+
+using namespace core;
+
+World::World(const WorldConfig& config)
+    : config(config)
+    , ghosts(config.seed) {
+    MemoryScope scope(MemoryTag::World);
+
+    map = std::make_unique<Map>(config.mapSize, config.seed);
+    player = std::make_unique<Player>(0.f, 0.f);
+
+    // Looked up once; the components live as long as their objects.
+    mapCollision = std::dynamic_pointer_cast<Collision>(map->GetComponent("collision").lock());
+    movement = std::dynamic_pointer_cast<Movement>(player->GetComponent("movement").lock());
+    gun = std::dynamic_pointer_cast<Gun>(player->GetComponent("gun").lock());
+    flashlight = std::dynamic_pointer_cast<FlashLight>(player->GetComponent("flashlight").lock());
+
+    ghosts.SetPrey(&player->GetCenter());
+    ghosts.SetWalls(&map->GetDistanceField());
+
+    if(mapCollision) {
+        ghosts.Populate(*mapCollision, config.ghostCount);
+        fog.Reset(*mapCollision);
+    }
+
+    impacts.reserve(Gun::MAX_BULLETS);
+}
+
+World::~World() = default;
+
+void World::Step(const InputCommand& input) {
+    Simulate(input);
+    ++tick;
+
+    ghosts.Update(config.tickTime);
+    applyFlashlight();
+}
+
+void World::Simulate(const InputCommand& input) {
+    impacts.clear();
+
+    ApplyInput(*player, input);
+
+    map->Update(config.tickTime);
+    player->Update(config.tickTime);
+
+    handleCollisions();
+}
+
+void World::Capture(WorldState& state) const {
+    CaptureWorld(*player, map.get(), tick, state);
+}
+
+bool World::Restore(const WorldState& state) {
+    if(!map->RewindWalls(state.wallRevision)) return false;
+
+    RestoreWorld(*player, state);
+    return true;
+}
+
+bool World::Restore(const SaveGame& save) {
+    // The fog was reset over the uncarved walls, as it was when the save's game started.
+    bool restored = map->RestoreWalls(save.walls) && save.fog.size() == fog.GetChunkCount();
+    for(std::size_t chunk = 0; restored && chunk < save.fog.size(); ++chunk) {
+        ByteReader in(save.fog[chunk]);
+        restored = fog.ReadChunk(chunk, in);
+    }
+
+    if(!restored) return false;
+
+    RestoreWorld(*player, save.world);
+    tick = save.world.tick;
+    return true;
+}
+
+void World::handleCollisions() {
+    if(!movement) return;
+
+    ResolveMapCollision(*movement, map->GetDistanceField(), config.tickTime);
+
+    if(mapCollision) {
+        if(gun)
+            CullBullets(*gun, *mapCollision, bulletScratch);
+
+        if(flashlight && flashlight->GetSwitch())
+            checkFlashlightMapCollision(player->GetCenter().GetWorldPosition());
+    }
+
+    // Bullets culled this tick are still in the list until the gun's next update.
+    if(gun) {
+        const sf::Vector2f radius{Gun::BULLET_RADIUS, Gun::BULLET_RADIUS};
+
+        for(const auto& bullet : gun->GetBullets()) {
+            if(bullet.active) continue;
+
+            impacts.push_back(Impact{bullet.position + radius, -bullet.direction});
+            if(carving) map->CarveWall(bullet.position + radius);
+        }
+    }
+}
+
+void World::applyFlashlight() {
+    if(!flashlight) return;
+
+    const auto cone = flashlight->GetCone();
+    if(!cone) return;
+
+    ghostGrid.Build(ghosts.GetXs(), ghosts.GetYs(), ghosts.GetCount());
+
+    litGhosts.clear();
+    ghostGrid.QueryCone(*cone, mapCollision.get(), litGhosts);
+    ghosts.Light(litGhosts, cone->origin);
+
+    fog.Reveal(*cone, mapCollision.get());
+}
+
+void World::checkFlashlightMapCollision(const sf::Vector2f& flashlightCenter) {
+    if (mapCollision->ContainsPoint(flashlightCenter)) {
+        // ÷öƮ  ο   ۵
+        //  ray casting  ÷öƮ     
+        // Ͽ  ִ Ÿ   
+    }
+    else {
+        // ÷öƮ  ܺο  (̷δ ߻ ʾƾ )
+        // ÷̾ ̹  ܺη  ̹Ƿ ÷öƮ  ۵
+    }
+}
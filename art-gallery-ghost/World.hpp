@@ -0,0 +1,117 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Map.hpp"
+#include "Player.hpp"
+#include "Physics.hpp"
+#include "PlayerInput.hpp"
+#include "Rollback.hpp"
+#include "GhostCrowd.hpp"
+#include "FogOfWar.hpp"
+#include "Visibility.hpp"
+
+class Movement;
+class Collision;
+class Gun;
+class FlashLight;
+
+namespace core {
+    struct SaveGame;
+
+    struct WorldConfig {
+        // Seeds the map layout and the ghosts, so equal configs simulate equal worlds.
+        std::uint32_t seed = 0;
+        float mapSize = Map::DEFAULT_SIZE;
+        std::size_t ghostCount = 48;
+        float tickTime = 1.f / 60.f;
+    };
+
+    // A bullet that stopped against a wall during the last tick.
+    struct Impact {
+        sf::Vector2f position;
+        sf::Vector2f direction;
+    };
+
+    // The simulation of one offline game: map, player, ghosts and fog of war. A world owns no
+    // window; effects such as impact particles are left to the caller through GetImpacts(). The
+    // one exception is Gun::Fire, which still emits muzzle-flash particles and OutOfAmmo events
+    // into globals. Separate worlds can be stepped on separate threads at the same time only
+    // because event log rings are per thread and particles stay off unless Particles::SetEmitting
+    // turns them on, so keep them off while worlds run in parallel.
+    class World {
+    public:
+        explicit World(const WorldConfig& config);
+        ~World();
+
+        // The ghosts hold on to this world's player.
+        World(const World&) = delete;
+        World& operator=(const World&) = delete;
+
+        // One full tick: the player's input, then the ghosts and the flashlight.
+        void Step(const InputCommand& input);
+
+        // Only the player's part of a tick, which is what rollback replays. Does not advance the tick.
+        void Simulate(const InputCommand& input);
+
+        // Stopped bullets carve craters while this is on. Networked play turns it off.
+        void SetCarving(const bool enabled) { carving = enabled; }
+
+        // LOD focus besides the player, usually the view center.
+        void SetCamera(const sf::Vector2f& center) { ghosts.SetCamera(center); }
+
+        void Capture(WorldState& state) const;
+        // Also rewinds the walls to the state's carves. False, changing nothing, when they were
+        // carved too often since for the map's journal to undo.
+        bool Restore(const WorldState& state);
+
+        // Takes over the walls, fog and player of a save made from a world with the same seed and size.
+        bool Restore(const SaveGame& save);
+
+        const WorldConfig& GetConfig() const { return config; }
+        std::uint32_t GetTick() const { return tick; }
+
+        Map& GetMap() { return *map; }
+        const Map& GetMap() const { return *map; }
+        Player& GetPlayer() { return *player; }
+        const Player& GetPlayer() const { return *player; }
+        GhostCrowd& GetGhosts() { return ghosts; }
+        FogOfWar& GetFog() { return fog; }
+        const FogOfWar& GetFog() const { return fog; }
+
+        // The map's walls as one collision shape, for line-of-sight queries.
+        const Collision* GetMapCollision() const { return mapCollision.get(); }
+
+        const std::vector<Impact>& GetImpacts() const { return impacts; }
+
+    private:
+        WorldConfig config;
+        std::uint32_t tick = 0;
+        bool carving = true;
+
+        std::unique_ptr<Map> map;
+        std::unique_ptr<Player> player;
+
+        std::shared_ptr<Collision> mapCollision;
+        std::shared_ptr<Movement> movement;
+        std::shared_ptr<Gun> gun;
+        std::shared_ptr<FlashLight> flashlight;
+
+        GhostCrowd ghosts;
+        EntityGrid ghostGrid;
+        std::vector<std::uint32_t> litGhosts;
+
+        FogOfWar fog;
+
+        BulletScratch bulletScratch;
+        std::vector<Impact> impacts;
+
+        void handleCollisions();
+        void applyFlashlight();
+        void checkFlashlightMapCollision(const sf::Vector2f& flashlightCenter);
+    };
+}
@@ -1,13 +1,94 @@
 #include "Game.hpp"
+#include "Server.hpp"
+#include "EventLog.hpp"
+#include "BatchRunner.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
 
 const std::string TITLE = "Art gallery ghost";
 
 const std::uint16_t WIDTH = 1920;
 const std::uint16_t HEIGHT = 1080;
 
-int main() {
+// art-gallery-ghost                          single player
+// art-gallery-ghost --server [port] [--bots N]  headless authoritative server
+// art-gallery-ghost --connect host[:port]    join a server
+// --log path                                  write gameplay events to a file instead of the console
+// --low-latency                               spin-then-sleep frame pacing and late-latched aim
+// --save dir                                  single player: resume from and autosave into dir
+// art-gallery-ghost --batch N [--ticks T] [--threads K] [--seed S]
+//                                             step N headless scripted worlds and report ticks/sec
+int main(int argc, char* argv[]) {
+    const std::vector<std::string_view> args(argv + 1, argv + argc);
+
+    auto valueAfter = [&args](const std::string_view flag) -> std::string {
+        for(std::size_t i = 0; i + 1 < args.size(); ++i)
+            if(args[i] == flag) return std::string(args[i + 1]);
+        return {};
+    };
+
+    auto hasFlag = [&args](const std::string_view flag) {
+        return std::find(args.begin(), args.end(), flag) != args.end();
+    };
+
+    core::EventLog::Start(valueAfter("--log"));
+    const core::EventLogGuard logGuard;
+
+    if(const std::string batch = valueAfter("--batch"); !batch.empty()) {
+        const std::string ticks = valueAfter("--ticks");
+        const std::string threads = valueAfter("--threads");
+        const std::string seed = valueAfter("--seed");
+
+        core::BatchRunner runner(threads.empty() ? 0 : static_cast<std::size_t>(std::stoul(threads)));
+
+        core::WorldConfig config;
+        config.seed = seed.empty() ? 1 : static_cast<std::uint32_t>(std::stoul(seed));
+        runner.Populate(static_cast<std::size_t>(std::stoul(batch)), config);
+
+        const core::BatchStats stats = runner.Run(ticks.empty() ? 600 : static_cast<std::uint32_t>(std::stoul(ticks)));
+
+        std::cout << "[batch] " << stats.worlds << " worlds on " << stats.threads << " threads"
+            << " | " << stats.ticks << " ticks in " << stats.seconds << " s"
+            << " | " << stats.GetTicksPerSecond() << " ticks/s"
+            << " | " << stats.GetTicksPerSecond() / static_cast<double>(stats.threads) << " ticks/s per thread"
+            << std::endl;
+
+        return 0;
+    }
+
+    if(hasFlag("--server")) {
+        const std::string port = valueAfter("--server");
+        const std::string bots = valueAfter("--bots");
+
+        net::Server server(
+            port.empty() || port.front() == '-' ? net::DEFAULT_PORT : static_cast<unsigned short>(std::stoi(port)),
+            bots.empty() ? 0 : static_cast<std::size_t>(std::stoul(bots)));
+
+        if(!server.Start()) return 1;
+
+        server.Run();
+        return 0;
+    }
+
     core::Game game(TITLE, WIDTH, HEIGHT);
 
+    if(const std::string address = valueAfter("--connect"); !address.empty()) {
+        const std::size_t colon = address.find(':');
+        const std::string host = address.substr(0, colon);
+        const unsigned short port = colon == std::string::npos
+            ? net::DEFAULT_PORT
+            : static_cast<unsigned short>(std::stoi(address.substr(colon + 1)));
+
+        if(!game.Connect(host, port)) return 1;
+    }
+
+    if(const std::string save = valueAfter("--save"); !save.empty() && !game.EnableAutosave(save)) return 1;
+
+    game.SetLowLatency(hasFlag("--low-latency"));
     game.Run();
     game.Clear();
     return 0;
@@ -0,0 +1,638 @@
+// Headless microbenchmarks for the Collision hot paths.
+//
+// Windows: build the collision-bench project in art-gallery-ghost.sln (Release|x64).
+// Linux:
+//   g++ -std=c++20 -O2 -DNDEBUG -I../art-gallery-ghost -o collision-bench CollisionBench.cpp
+//       ../art-gallery-ghost/Collision.cpp ../art-gallery-ghost/CollisionBatch.cpp
+//       ../art-gallery-ghost/PolygonShape.cpp ../art-gallery-ghost/Triangulation.cpp
+//       ../art-gallery-ghost/Visibility.cpp ../art-gallery-ghost/Transform.cpp
+//       ../art-gallery-ghost/Behavior.cpp ../art-gallery-ghost/GhostCrowd.cpp ../art-gallery-ghost/WallShape.cpp
+//       ../art-gallery-ghost/DistanceField.cpp ../art-gallery-ghost/MemoryStats.cpp ../art-gallery-ghost/SimulationLod.cpp
+//       ../art-gallery-ghost/AudioMixer.cpp ../art-gallery-ghost/SoundScene.cpp
+//       -lsfml-graphics -lsfml-window -lsfml-system
+//   ./collision-bench --vertices 6,64,1024,10000 --queries 100000 --repeat 5
+//
+// Nothing here opens a window; shapes are only used as vertex sources.
+
+#include "Collision.hpp"
+#include "Object.hpp"
+#include "Movement.hpp"
+#include "Render.hpp"
+#include "PolygonShape.hpp"
+#include "Visibility.hpp"
+#include "GhostCrowd.hpp"
+#include "DistanceField.hpp"
+#include "MemoryStats.hpp"
+#include "SoundScene.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    constexpr float PI = 3.141592f;
+    constexpr float WORLD_SIZE = 4000.f;
+    constexpr std::size_t POOL_SIZE = 256;
+    constexpr std::size_t GALLERY_PILLARS = 8;
+    constexpr std::size_t GHOST_COUNT = 512;
+    constexpr std::size_t CROWD_SIZE = 4096;
+    constexpr std::size_t WIDE_CROWD_SIZE = 32768;
+    constexpr float WIDE_RADIUS = 16000.f;
+    constexpr float TICK_TIME = 1.f / 60.f;
+    constexpr float CRATER_RADIUS = 14.f;
+    constexpr std::size_t HUMMING_GHOSTS = 48;
+
+    // Per-query cost of the O(vertices) benchmarks is capped to this many edge visits per repeat.
+    constexpr double EDGE_BUDGET = 5e7;
+
+    using Clock = std::chrono::steady_clock;
+
+    class Shape : public core::Object {
+    public:
+        Shape(core::RenderShape drawable, const sf::Vector2f& pos) {
+            this->AddComponent(std::make_shared<Movement>(this, pos));
+            this->AddComponent(std::make_shared<Render>(this, std::move(drawable)));
+            this->AddComponent(std::make_shared<Collision>(this));
+
+            collision = std::static_pointer_cast<Collision>(this->GetComponent("collision").lock());
+        }
+
+        void Update(const float deltaTime) override { collision->Update(deltaTime); }
+
+        const Collision& GetCollision() const { return *collision; }
+
+    private:
+        std::shared_ptr<Collision> collision;
+    };
+
+    struct Options {
+        std::vector<std::size_t> vertexCounts{6, 64, 1024, 10000};
+        std::size_t queries = 100000;
+        std::size_t repeat = 5;
+        std::string filter;
+        bool csv = false;
+        bool noAlloc = false;
+    };
+
+    struct Result {
+        std::string name;
+        std::size_t vertices = 0;
+        std::size_t queries = 0;
+        double nsPerQuery = 0.0;
+        // Heap allocations per timed repeat, after the warm-up call.
+        double allocations = 0.0;
+    };
+
+    // Rows whose job is to build or grow geometry; --no-alloc holds every other row to zero.
+    constexpr std::string_view ALLOCATING_ROWS[] = {"PolygonShape", "DistanceField::Bake", "WallShape::Carve"};
+
+    // Results are folded in here so the optimizer cannot drop the queries.
+    volatile std::uint64_t sink = 0;
+
+    sf::ConvexShape makePolygon(const std::size_t vertexCount, const float radius, std::mt19937& gen) {
+        std::uniform_real_distribution<float> noiseDist(-0.25f, 0.25f);
+        const float step = 2.f * PI / static_cast<float>(vertexCount);
+
+        sf::ConvexShape convex(vertexCount);
+        for(std::size_t i = 0; i < vertexCount; ++i) {
+            const float rad = (static_cast<float>(i) + noiseDist(gen)) * step;
+            convex.setPoint(i, radius * sf::Vector2f{std::cos(rad), std::sin(rad)});
+        }
+
+        return convex;
+    }
+
+    std::vector<std::unique_ptr<Shape>> makePool(const CollisionType type, const std::size_t vertexCount, std::mt19937& gen) {
+        std::uniform_real_distribution<float> posDist(0.f, WORLD_SIZE * 0.1f);
+        std::uniform_real_distribution<float> sizeDist(20.f, 200.f);
+
+        std::vector<std::unique_ptr<Shape>> pool;
+        pool.reserve(POOL_SIZE);
+
+        for(std::size_t i = 0; i < POOL_SIZE; ++i) {
+            const sf::Vector2f pos{posDist(gen), posDist(gen)};
+            core::RenderShape drawable;
+
+            switch(type) {
+                case CollisionType::Circle:
+                    drawable = sf::CircleShape(sizeDist(gen));
+                    break;
+                case CollisionType::Rectangle:
+                    drawable = sf::RectangleShape(sf::Vector2f{sizeDist(gen), sizeDist(gen)});
+                    break;
+                case CollisionType::Convex:
+                case CollisionType::Polygon:
+                case CollisionType::Walls:
+                    drawable = makePolygon(vertexCount, sizeDist(gen), gen);
+                    break;
+            }
+
+            pool.emplace_back(std::make_unique<Shape>(std::move(drawable), pos));
+        }
+
+        return pool;
+    }
+
+    void makeQueryPoints(const std::size_t count, const float extent, std::mt19937& gen, std::vector<float>& xs, std::vector<float>& ys) {
+        std::uniform_real_distribution<float> dist(-extent, extent);
+
+        xs.resize(count);
+        ys.resize(count);
+        for(std::size_t i = 0; i < count; ++i) {
+            xs[i] = dist(gen);
+            ys[i] = dist(gen);
+        }
+    }
+
+    // Runs body(queries) opts.repeat times and keeps the fastest repeat.
+    Result measure(const Options& opts, std::string name, const std::size_t vertices, const std::size_t queries,
+                   const std::function<void(std::size_t)>& body) {
+        body(std::min<std::size_t>(queries, 64));
+
+        double best = std::numeric_limits<double>::max();
+        const core::NoAllocationScope allocations;
+        for(std::size_t r = 0; r < opts.repeat; ++r) {
+            const auto start = Clock::now();
+            body(queries);
+            const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            best = std::min(best, ns);
+        }
+
+        return Result{std::move(name), vertices, queries, best / static_cast<double>(queries),
+            static_cast<double>(allocations.GetAllocations()) / static_cast<double>(opts.repeat)};
+    }
+
+    std::size_t scaledQueries(const Options& opts, const std::size_t vertices) {
+        const auto budget = static_cast<std::size_t>(EDGE_BUDGET / static_cast<double>(std::max<std::size_t>(vertices, 1)));
+        return std::max<std::size_t>(std::min(opts.queries, budget), 256);
+    }
+
+    Result benchPairs(const Options& opts, std::string name, const CollisionType lhsType, const CollisionType rhsType,
+                      const std::size_t vertices, std::mt19937& gen) {
+        const auto lhs = makePool(lhsType, vertices, gen);
+        const auto rhs = makePool(rhsType, vertices, gen);
+
+        return measure(opts, std::move(name), vertices, opts.queries, [&](const std::size_t queries) {
+            std::uint64_t hits = 0;
+            for(std::size_t q = 0; q < queries; ++q) {
+                const CollisionInfo info = lhs[q % POOL_SIZE]->GetCollision()
+                    .CheckCollision(rhs[(q * 7 + q / POOL_SIZE) % POOL_SIZE]->GetCollision());
+                hits += info.hasCollision;
+            }
+            sink = sink + hits;
+        });
+    }
+
+    void benchConvex(const Options& opts, const std::size_t vertices, std::mt19937& gen, std::vector<Result>& results,
+                     const std::function<bool(std::string_view)>& enabled) {
+        const float radius = 1000.f;
+        Shape polygon(makePolygon(vertices, radius, gen), {0.f, 0.f});
+        const Collision& collision = polygon.GetCollision();
+
+        const std::size_t queries = scaledQueries(opts, vertices);
+        std::vector<float> xs, ys;
+        makeQueryPoints(queries, radius * 1.2f, gen, xs, ys);
+
+        std::vector<std::uint8_t> inside(queries);
+        std::vector<float> outXs(queries), outYs(queries);
+
+        if(enabled("pointInConvex"))
+            results.emplace_back(measure(opts, "pointInConvex", vertices, queries, [&](const std::size_t count) {
+                std::uint64_t hits = 0;
+                for(std::size_t q = 0; q < count; ++q)
+                    hits += collision.ContainsPoint({xs[q], ys[q]});
+                sink = sink + hits;
+            }));
+
+        if(enabled("ContainsPoints"))
+            results.emplace_back(measure(opts, "ContainsPoints", vertices, queries, [&](const std::size_t count) {
+                collision.ContainsPoints(xs.data(), ys.data(), count, inside.data());
+                sink = sink + inside[count / 2];
+            }));
+
+        if(enabled("GetClosestPointOnBoundary"))
+            results.emplace_back(measure(opts, "GetClosestPointOnBoundary", vertices, queries, [&](const std::size_t count) {
+                float sum = 0.f;
+                for(std::size_t q = 0; q < count; ++q)
+                    sum += collision.GetClosestPointOnBoundary({xs[q], ys[q]}).x;
+                sink = sink + static_cast<std::uint64_t>(std::abs(sum));
+            }));
+
+        if(enabled("GetClosestPointsOnBoundary"))
+            results.emplace_back(measure(opts, "GetClosestPointsOnBoundary", vertices, queries, [&](const std::size_t count) {
+                collision.GetClosestPointsOnBoundary(xs.data(), ys.data(), count, outXs.data(), outYs.data());
+                sink = sink + static_cast<std::uint64_t>(std::abs(outXs[count / 2]));
+            }));
+
+        if(enabled("UpdateFromRenderShape")) {
+            const std::size_t rebuilds = std::max<std::size_t>(scaledQueries(opts, vertices) / 16, 16);
+            results.emplace_back(measure(opts, "UpdateFromRenderShape", vertices, rebuilds, [&](const std::size_t count) {
+                for(std::size_t q = 0; q < count; ++q)
+                    polygon.Update(0.f);
+                sink = sink + static_cast<std::uint64_t>(collision.GetBounds().size.x);
+            }));
+        }
+
+        if(enabled("checkConvexCollision"))
+            results.emplace_back(benchPairs(opts, "checkConvexCollision",
+                CollisionType::Convex, CollisionType::Convex, vertices, gen));
+    }
+
+    // Star-shaped gallery outline with square pillars, as Map builds but with a configurable vertex count.
+    core::PolygonWithHoles makeGallery(const std::size_t vertexCount, const float radius, std::mt19937& gen) {
+        std::uniform_real_distribution<float> noiseDist(-0.25f, 0.25f);
+        const float step = 2.f * PI / static_cast<float>(vertexCount);
+
+        core::PolygonWithHoles gallery;
+        for(std::size_t i = 0; i < vertexCount; ++i) {
+            const float rad = (static_cast<float>(i) + noiseDist(gen)) * step;
+            const float distance = i % 2 == 0 ? radius : radius * 0.75f;
+            gallery.outer.emplace_back(distance * sf::Vector2f{std::cos(rad), std::sin(rad)});
+        }
+
+        for(std::size_t i = 0; i < GALLERY_PILLARS; ++i) {
+            const float rad = static_cast<float>(i) * 2.f * PI / GALLERY_PILLARS;
+            const float distance = radius * (i % 2 == 0 ? 0.3f : 0.5f);
+            const sf::Vector2f center = distance * sf::Vector2f{std::cos(rad), std::sin(rad)};
+            const float half = radius * 0.04f;
+
+            gallery.holes.push_back({
+                center + sf::Vector2f{-half, -half}, center + sf::Vector2f{half, -half},
+                center + sf::Vector2f{half, half}, center + sf::Vector2f{-half, half}});
+        }
+
+        return gallery;
+    }
+
+    // The sound scene's share of a tick with every source slot taken: HUMMING_GHOSTS ghost hums
+    // and one-shots restarted as they end. The listener walks a circle, so sources keep trading
+    // voices, and every OCCLUSION_TICKS ticks all of them are traced against the gallery walls.
+    // Then the mixer's share: one block of every voice, mixed offline on this thread.
+    void benchAudio(const Options& opts, const std::size_t vertices, const Collision& walls, const float radius,
+                    std::mt19937& gen, std::vector<Result>& results, const std::function<bool(std::string_view)>& enabled) {
+        if(enabled("SoundScene::Update")) {
+            core::SoundScene scene;
+            scene.SetWalls(&walls);
+
+            std::vector<float> xs, ys;
+            makeQueryPoints(core::SoundScene::MAX_SOURCES, radius, gen, xs, ys);
+
+            std::size_t tick = 0;
+            std::vector<std::size_t> ends(core::SoundScene::MAX_SOURCES, 0);
+            auto restart = [&](const std::size_t i) {
+                const auto kind = i % 3 == 0 ? core::SoundKind::Gunshot : i % 3 == 1 ? core::SoundKind::Footstep : core::SoundKind::Impact;
+                scene.Play(kind, {xs[i], ys[i]});
+                ends[i] = tick + static_cast<std::size_t>(core::SoundBank::GetDuration(kind) / TICK_TIME) + 1;
+            };
+
+            for(std::size_t i = 0; i < HUMMING_GHOSTS; ++i)
+                scene.Loop(core::SoundKind::Ghost, {xs[i], ys[i]});
+            for(std::size_t i = HUMMING_GHOSTS; i < core::SoundScene::MAX_SOURCES; ++i)
+                restart(i);
+
+            results.emplace_back(measure(opts, "SoundScene::Update", vertices, opts.queries / 64 + 1, [&](const std::size_t count) {
+                for(std::size_t q = 0; q < count; ++q, ++tick) {
+                    const float angle = static_cast<float>(tick) * 0.01f;
+                    scene.SetListener({std::cos(angle) * radius * 0.5f, std::sin(angle) * radius * 0.5f});
+                    scene.Update(TICK_TIME);
+
+                    for(std::size_t i = HUMMING_GHOSTS; i < core::SoundScene::MAX_SOURCES; ++i)
+                        if(tick > ends[i]) restart(i);
+                }
+                sink = sink + scene.GetPlayingCount();
+            }));
+        }
+
+        if(enabled("AudioMixer::MixBlock")) {
+            core::AudioMixer mixer;
+            for(std::size_t voice = 0; voice < core::AudioMixer::VOICE_COUNT; ++voice) {
+                core::VoiceCommand command;
+                command.type = core::VoiceCommand::Type::Start;
+                command.voice = static_cast<std::uint8_t>(voice);
+                command.kind = core::SoundKind::Ghost;
+                command.loop = true;
+                command.gain = 0.5f;
+                command.pan = static_cast<float>(voice) / core::AudioMixer::VOICE_COUNT * 2.f - 1.f;
+                command.offset = static_cast<std::uint32_t>(voice * 997);
+                mixer.Send(command);
+            }
+
+            std::vector<float> block(core::AudioMixer::BLOCK_FRAMES * 2);
+            results.emplace_back(measure(opts, "AudioMixer::MixBlock", core::AudioMixer::VOICE_COUNT, opts.queries / 64 + 1, [&](const std::size_t count) {
+                for(std::size_t q = 0; q < count; ++q)
+                    mixer.MixBlock(block.data());
+                sink = sink + static_cast<std::uint64_t>(block[0] * 1000.f + 1000.f);
+            }));
+        }
+    }
+
+    void benchGallery(const Options& opts, const std::size_t vertices, std::mt19937& gen, std::vector<Result>& results,
+                      const std::function<bool(std::string_view)>& enabled) {
+        const float radius = 1000.f;
+        const core::PolygonWithHoles gallery = makeGallery(vertices, radius, gen);
+
+        if(enabled("PolygonShape"))
+            results.emplace_back(measure(opts, "PolygonShape", vertices, 1, [&](const std::size_t count) {
+                for(std::size_t q = 0; q < count; ++q)
+                    sink = sink + PolygonShape(gallery).GetTriangleCount();
+            }));
+
+        Shape polygon(PolygonShape(gallery), {0.f, 0.f});
+        const Collision& collision = polygon.GetCollision();
+
+        const std::size_t queries = scaledQueries(opts, vertices);
+        std::vector<float> xs, ys;
+        makeQueryPoints(queries, radius * 1.2f, gen, xs, ys);
+        std::vector<std::uint8_t> inside(queries);
+
+        if(enabled("pointInPolygon"))
+            results.emplace_back(measure(opts, "pointInPolygon", vertices, queries, [&](const std::size_t count) {
+                std::uint64_t hits = 0;
+                for(std::size_t q = 0; q < count; ++q)
+                    hits += collision.ContainsPoint({xs[q], ys[q]});
+                sink = sink + hits;
+            }));
+
+        if(enabled("polygonContainsPoints"))
+            results.emplace_back(measure(opts, "polygonContainsPoints", vertices, queries, [&](const std::size_t count) {
+                collision.ContainsPoints(xs.data(), ys.data(), count, inside.data());
+                sink = sink + inside[count / 2];
+            }));
+
+        if(enabled("polygonUpdateFromRenderShape"))
+            results.emplace_back(measure(opts, "polygonUpdateFromRenderShape", vertices, opts.queries, [&](const std::size_t count) {
+                for(std::size_t q = 0; q < count; ++q)
+                    polygon.Update(0.f);
+                sink = sink + static_cast<std::uint64_t>(collision.GetBounds().size.x);
+            }));
+
+        // The same batched queries against the gallery as carvable walls, which walk the tile grid
+        // per point instead of running the lane kernels.
+        if(enabled("Walls::GetClosestPointsOnBoundary") || enabled("Walls::SegmentsBlocked")) {
+            Shape carvable(WallShape(gallery), {0.f, 0.f});
+            const Collision& walls = carvable.GetCollision();
+            std::vector<float> outXs(queries), outYs(queries);
+
+            if(enabled("Walls::GetClosestPointsOnBoundary"))
+                results.emplace_back(measure(opts, "Walls::GetClosestPointsOnBoundary", vertices, queries, [&](const std::size_t count) {
+                    walls.GetClosestPointsOnBoundary(xs.data(), ys.data(), count, outXs.data(), outYs.data());
+                    sink = sink + static_cast<std::uint64_t>(std::abs(outXs[count / 2]));
+                }));
+
+            if(enabled("Walls::SegmentsBlocked"))
+                results.emplace_back(measure(opts, "Walls::SegmentsBlocked", vertices, queries, [&](const std::size_t count) {
+                    walls.SegmentsBlocked({0.f, 0.f}, xs.data(), ys.data(), count, inside.data());
+                    sink = sink + inside[count / 2];
+                }));
+        }
+
+        // Push-out needs a signed distance and a normal: the edge scans it used to make per query,
+        // against one lookup in the baked field.
+        if(enabled("pushOutEdgeScan"))
+            results.emplace_back(measure(opts, "pushOutEdgeScan", vertices, queries, [&](const std::size_t count) {
+                float total = 0.f;
+                for(std::size_t q = 0; q < count; ++q) {
+                    const sf::Vector2f point{xs[q], ys[q]};
+                    const sf::Vector2f closest = collision.GetClosestPointOnBoundary(point);
+                    const sf::Vector2f toPoint = point - closest;
+                    const float distance = std::sqrt(toPoint.x * toPoint.x + toPoint.y * toPoint.y);
+                    total += collision.ContainsPoint(point) ? distance : -distance;
+                }
+                sink = sink + static_cast<std::uint64_t>(std::abs(total));
+            }));
+
+        core::DistanceField field;
+        if(enabled("DistanceField"))
+            field.Bake(collision);
+
+        if(enabled("DistanceField::Bake"))
+            results.emplace_back(measure(opts, "DistanceField::Bake", vertices, 1, [&](const std::size_t count) {
+                for(std::size_t q = 0; q < count; ++q)
+                    field.Bake(collision);
+                sink = sink + field.GetNodeCount();
+            }));
+
+        if(enabled("DistanceField::Sample"))
+            results.emplace_back(measure(opts, "DistanceField::Sample", vertices, opts.queries, [&](const std::size_t count) {
+                float total = 0.f;
+                for(std::size_t q = 0; q < count; ++q)
+                    total += field.Sample({xs[q % queries], ys[q % queries]}).distance;
+                sink = sink + static_cast<std::uint64_t>(std::abs(total));
+            }));
+
+        // GHOST_COUNT ghosts scattered over the gallery, lit by flashlight cones from random spots.
+        std::vector<float> ghostXs, ghostYs;
+        makeQueryPoints(GHOST_COUNT, radius, gen, ghostXs, ghostYs);
+
+        core::EntityGrid grid;
+        grid.Build(ghostXs.data(), ghostYs.data(), GHOST_COUNT);
+
+        if(enabled("EntityGrid::Build"))
+            results.emplace_back(measure(opts, "EntityGrid::Build", GHOST_COUNT, opts.queries / 64 + 1, [&](const std::size_t count) {
+                for(std::size_t q = 0; q < count; ++q)
+                    grid.Build(ghostXs.data(), ghostYs.data(), GHOST_COUNT);
+                sink = sink + grid.GetCount();
+            }));
+
+        if(enabled("QueryCone")) {
+            std::uniform_real_distribution<float> angleDist(0.f, 360.f);
+            std::uniform_real_distribution<float> widthDist(10.f, 100.f);
+            std::uniform_real_distribution<float> rangeDist(500.f, 3000.f);
+
+            std::vector<core::Cone> cones(POOL_SIZE);
+            std::vector<float> originXs, originYs;
+            makeQueryPoints(POOL_SIZE, radius * 0.6f, gen, originXs, originYs);
+
+            for(std::size_t i = 0; i < POOL_SIZE; ++i)
+                cones[i] = core::Cone{{originXs[i], originYs[i]}, angleDist(gen), widthDist(gen), rangeDist(gen)};
+
+            std::vector<std::uint32_t> lit;
+            lit.reserve(GHOST_COUNT);
+
+            results.emplace_back(measure(opts, "QueryCone", vertices, std::max<std::size_t>(queries / GHOST_COUNT, 16), [&](const std::size_t count) {
+                std::uint64_t total = 0;
+                for(std::size_t q = 0; q < count; ++q) {
+                    lit.clear();
+                    grid.QueryCone(cones[q % POOL_SIZE], &collision, lit);
+                    total += lit.size();
+                }
+                sink = sink + total;
+            }));
+        }
+
+        // Sustained fire: every shot chips the wall surface nearest one of POOL_SIZE aim points, so
+        // later repeats keep digging the same craters deeper instead of hitting fresh wall.
+        if(enabled("WallShape::Carve")) {
+            WallShape walls(gallery);
+            std::vector<float> aimXs, aimYs;
+            makeQueryPoints(POOL_SIZE, radius * 1.1f, gen, aimXs, aimYs);
+            std::size_t shot = 0;
+
+            results.emplace_back(measure(opts, "WallShape::Carve", vertices, std::max<std::size_t>(opts.queries / 64, 64), [&](const std::size_t count) {
+                std::uint64_t hits = 0;
+                for(std::size_t q = 0; q < count; ++q, ++shot) {
+                    const sf::Vector2f aim{aimXs[shot % POOL_SIZE], aimYs[shot % POOL_SIZE]};
+                    sf::Vector2f surface;
+                    if(walls.GetClosestSurfacePoint(aim, surface))
+                        hits += walls.Carve(surface, CRATER_RADIUS);
+                }
+                sink = sink + hits + walls.GetPieceCount();
+            }));
+        }
+
+        // One scheduler tick for CROWD_SIZE haunting ghosts, most of them idle or gliding.
+        if(enabled("GhostCrowd::Update")) {
+            core::GhostCrowd crowd(12345);
+            crowd.Populate(collision, CROWD_SIZE);
+
+            results.emplace_back(measure(opts, "GhostCrowd::Update", CROWD_SIZE, opts.queries / 64 + 1, [&](const std::size_t count) {
+                std::uint64_t resumed = 0;
+                for(std::size_t q = 0; q < count; ++q) {
+                    crowd.Update(TICK_TIME);
+                    resumed += crowd.GetScheduler().GetResumed();
+                }
+                sink = sink + resumed;
+            }));
+        }
+
+        // A crowd spread over a gallery 16 times wider, ticked with every ghost at full rate and
+        // then with the LOD focused on the centre, where most ghosts end up dormant or slowed.
+        if(enabled("GhostCrowd::UpdateAll") || enabled("GhostCrowd::UpdateLod")) {
+            Shape wide(PolygonShape(makeGallery(vertices, WIDE_RADIUS, gen)), {0.f, 0.f});
+
+            for(const bool lod : {false, true}) {
+                const std::string name = lod ? "GhostCrowd::UpdateLod" : "GhostCrowd::UpdateAll";
+                if(!enabled(name)) continue;
+
+                core::GhostCrowd crowd(12345);
+                crowd.Populate(wide.GetCollision(), WIDE_CROWD_SIZE);
+                if(lod) crowd.SetCamera({0.f, 0.f});
+
+                results.emplace_back(measure(opts, name, vertices, opts.queries / 64 + 1, [&](const std::size_t count) {
+                    std::uint64_t resumed = 0;
+                    for(std::size_t q = 0; q < count; ++q) {
+                        crowd.Update(TICK_TIME);
+                        resumed += crowd.GetScheduler().GetResumed();
+                    }
+                    sink = sink + resumed;
+                }));
+            }
+        }
+
+        if(enabled("SoundScene::Update") || enabled("AudioMixer::MixBlock"))
+            benchAudio(opts, vertices, collision, radius, gen, results, enabled);
+    }
+
+    std::vector<std::size_t> parseList(const std::string_view text) {
+        std::vector<std::size_t> values;
+        std::size_t start = 0;
+
+        while(start < text.size()) {
+            const std::size_t comma = std::min(text.find(',', start), text.size());
+            values.push_back(static_cast<std::size_t>(std::stoul(std::string(text.substr(start, comma - start)))));
+            start = comma + 1;
+        }
+
+        return values;
+    }
+
+    bool parseOptions(const int argc, char* argv[], Options& opts) {
+        for(int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if(arg == "--vertices" && hasValue)
+                opts.vertexCounts = parseList(argv[++i]);
+            else if(arg == "--queries" && hasValue)
+                opts.queries = std::max<std::size_t>(std::stoul(argv[++i]), 1);
+            else if(arg == "--repeat" && hasValue)
+                opts.repeat = std::max<std::size_t>(std::stoul(argv[++i]), 1);
+            else if(arg == "--filter" && hasValue)
+                opts.filter = argv[++i];
+            else if(arg == "--csv")
+                opts.csv = true;
+            else if(arg == "--no-alloc")
+                opts.noAlloc = true;
+            else {
+                std::cerr << "usage: collision-bench [--vertices 6,64,1024,10000] [--queries N] [--repeat N] [--filter name] [--csv] [--no-alloc]\n";
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void print(const Options& opts, const std::vector<Result>& results) {
+        if(opts.csv) {
+            std::cout << "name,vertices,queries,ns_per_query,mqueries_per_sec,allocs_per_repeat\n";
+            for(const auto& result : results)
+                std::cout << result.name << ',' << result.vertices << ',' << result.queries << ','
+                    << result.nsPerQuery << ',' << 1e3 / result.nsPerQuery << ',' << result.allocations << '\n';
+            return;
+        }
+
+        std::cout << std::left << std::setw(36) << "benchmark" << std::right
+            << std::setw(10) << "vertices" << std::setw(10) << "queries"
+            << std::setw(14) << "ns/query" << std::setw(14) << "Mquery/s" << std::setw(10) << "allocs" << '\n';
+
+        std::cout << std::fixed << std::setprecision(2);
+        for(const auto& result : results)
+            std::cout << std::left << std::setw(36) << result.name << std::right
+                << std::setw(10) << result.vertices << std::setw(10) << result.queries
+                << std::setw(14) << result.nsPerQuery << std::setw(14) << 1e3 / result.nsPerQuery
+                << std::setw(10) << result.allocations << '\n';
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options opts;
+    if(!parseOptions(argc, argv, opts)) return 1;
+
+    auto enabled = [&opts](const std::string_view name) {
+        return opts.filter.empty() || name.find(opts.filter) != std::string_view::npos;
+    };
+
+    std::mt19937 gen{12345};
+    std::vector<Result> results;
+
+    if(enabled("checkCircleCircle"))
+        results.emplace_back(benchPairs(opts, "checkCircleCircle", CollisionType::Circle, CollisionType::Circle, 0, gen));
+    if(enabled("checkCircleRect"))
+        results.emplace_back(benchPairs(opts, "checkCircleRect", CollisionType::Circle, CollisionType::Rectangle, 0, gen));
+    if(enabled("checkRectRect"))
+        results.emplace_back(benchPairs(opts, "checkRectRect", CollisionType::Rectangle, CollisionType::Rectangle, 0, gen));
+
+    for(const std::size_t vertices : opts.vertexCounts)
+        if(vertices >= 3) {
+            benchConvex(opts, vertices, gen, results, enabled);
+            benchGallery(opts, vertices, gen, results, enabled);
+        }
+
+    print(opts, results);
+
+    if(opts.noAlloc) {
+        bool allocated = false;
+        for(const auto& result : results) {
+            const bool allowed = std::find(std::begin(ALLOCATING_ROWS), std::end(ALLOCATING_ROWS), result.name) != std::end(ALLOCATING_ROWS);
+            if(allowed || result.allocations == 0.0) continue;
+
+            std::cerr << "steady-state allocation: " << result.name << " (" << result.vertices << " vertices) allocated "
+                << result.allocations << " times per repeat\n";
+            allocated = true;
+        }
+
+        if(allocated) return 1;
+    }
+
+    return 0;
+}
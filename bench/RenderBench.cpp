@@ -0,0 +1,416 @@
+// Offscreen benchmark for the draw paths: renders scripted scenes into an sf::RenderTexture and
+// reports CPU submit time, display (flush) time, draw calls and vertices per frame.
+//
+// Windows: build the render-bench project in art-gallery-ghost.sln (Release|x64).
+// Linux, software GL without a monitor:
+//   g++ -std=c++20 -O2 -DNDEBUG -I../art-gallery-ghost -o render-bench RenderBench.cpp
+//       ../art-gallery-ghost/Player.cpp ../art-gallery-ghost/Controller.cpp ../art-gallery-ghost/PlayerInput.cpp
+//       ../art-gallery-ghost/Gun.cpp ../art-gallery-ghost/FlashLight.cpp ../art-gallery-ghost/Hud.cpp
+//       ../art-gallery-ghost/Tessellation.cpp ../art-gallery-ghost/Collision.cpp ../art-gallery-ghost/CollisionBatch.cpp
+//       ../art-gallery-ghost/Visibility.cpp ../art-gallery-ghost/PolygonShape.cpp ../art-gallery-ghost/Triangulation.cpp
+//       ../art-gallery-ghost/EventLog.cpp ../art-gallery-ghost/Transform.cpp ../art-gallery-ghost/Particles.cpp
+//       ../art-gallery-ghost/WallShape.cpp ../art-gallery-ghost/MemoryStats.cpp
+//       -lsfml-graphics -lsfml-window -lsfml-system -pthread
+//   LIBGL_ALWAYS_SOFTWARE=1 xvfb-run -a ./render-bench --scales 1,4,16 --frames 200
+//
+// Every scene count is the base count times the scene scale. Game::render draws the whole scene in
+// the game's order; the other rows draw only their own path so regressions can be attributed.
+// The Particles row also integrates and refills the pools, so its submit time is a full frame's
+// particle cost.
+// --no-alloc fails the run if any row's body allocates in steady state; the allocations SFML makes
+// in clear() and display() are not counted.
+
+#include "Object.hpp"
+#include "Player.hpp"
+#include "Movement.hpp"
+#include "Render.hpp"
+#include "Gun.hpp"
+#include "FlashLight.hpp"
+#include "Hud.hpp"
+#include "Particles.hpp"
+#include "PolygonShape.hpp"
+#include "RenderStats.hpp"
+#include "MemoryStats.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    constexpr float PI = 3.141592f;
+    constexpr float GALLERY_RADIUS = 1500.f;
+
+    constexpr std::size_t BASE_WALL_VERTICES = 64;
+    constexpr std::size_t BASE_PILLARS = 4;
+    constexpr std::size_t BASE_BULLETS = 16;
+    constexpr std::size_t BASE_FLASHLIGHTS = 2;
+    constexpr std::size_t BASE_HUD_ELEMENTS = 2;
+    constexpr std::size_t HUD_AMMO_FRAMES = 8;
+    constexpr std::size_t BASE_PARTICLES = 6250;
+
+    constexpr float FRAME_TIME = 1.f / 60.f;
+    constexpr std::size_t PARTICLE_BURST = 64;
+
+    using Clock = std::chrono::steady_clock;
+
+    class Walls : public core::Object {
+    public:
+        explicit Walls(core::PolygonWithHoles gallery) {
+            PolygonShape polygon(std::move(gallery));
+            polygon.SetFillColor(sf::Color::White);
+
+            this->AddComponent(std::make_shared<Movement>(this, sf::Vector2f{0.f, 0.f}));
+            this->AddComponent(std::make_shared<Render>(this, std::move(polygon)));
+
+            render = std::static_pointer_cast<Render>(this->GetComponent("render").lock());
+        }
+
+        void Update(const float deltaTime) override {}
+
+        void Draw(sf::RenderTarget& target) { render->Draw(target); }
+
+    private:
+        std::shared_ptr<Render> render;
+    };
+
+    struct Options {
+        std::vector<std::size_t> scales{1, 4, 16};
+        std::size_t frames = 200;
+        unsigned int width = 1280;
+        unsigned int height = 720;
+        std::string filter;
+        bool csv = false;
+        bool noAlloc = false;
+    };
+
+    struct Result {
+        std::string name;
+        std::size_t scale = 0;
+        double submitMs = 0.0;
+        double displayMs = 0.0;
+        double drawCalls = 0.0;
+        double vertices = 0.0;
+        // Heap allocations per frame made by the row's body, after the warm-up frame.
+        double allocations = 0.0;
+    };
+
+    struct Scene {
+        std::unique_ptr<Walls> walls;
+        std::vector<std::unique_ptr<Player>> players;
+        std::vector<std::shared_ptr<Gun>> guns;
+        std::vector<std::shared_ptr<FlashLight>> flashlights;
+        core::HudLayer hud;
+    };
+
+    core::PolygonWithHoles makeGallery(const std::size_t vertexCount, const std::size_t pillars, std::mt19937& gen) {
+        std::uniform_real_distribution<float> noiseDist(-0.25f, 0.25f);
+        const float step = 2.f * PI / static_cast<float>(vertexCount);
+
+        core::PolygonWithHoles gallery;
+        for(std::size_t i = 0; i < vertexCount; ++i) {
+            const float rad = (static_cast<float>(i) + noiseDist(gen)) * step;
+            const float distance = i % 2 == 0 ? GALLERY_RADIUS : GALLERY_RADIUS * 0.85f;
+            gallery.outer.emplace_back(distance * sf::Vector2f{std::cos(rad), std::sin(rad)});
+        }
+
+        // Pillars on concentric rings, small enough not to overlap at any scale.
+        const std::size_t perRing = 16;
+        const float half = GALLERY_RADIUS * 0.015f;
+
+        for(std::size_t i = 0; i < pillars; ++i) {
+            const std::size_t ring = i / perRing;
+            const float rad = (static_cast<float>(i % perRing) + 0.5f * static_cast<float>(ring % 2)) * 2.f * PI / perRing;
+            const float distance = GALLERY_RADIUS * (0.2f + 0.05f * static_cast<float>(ring % 12));
+            const sf::Vector2f center = distance * sf::Vector2f{std::cos(rad), std::sin(rad)};
+
+            gallery.holes.push_back({
+                center + sf::Vector2f{-half, -half}, center + sf::Vector2f{half, -half},
+                center + sf::Vector2f{half, half}, center + sf::Vector2f{-half, half}});
+        }
+
+        return gallery;
+    }
+
+    Scene makeScene(const std::size_t scale, const Options& opts, std::mt19937& gen) {
+        std::uniform_real_distribution<float> posDist(-GALLERY_RADIUS * 0.6f, GALLERY_RADIUS * 0.6f);
+        std::uniform_real_distribution<float> angleDist(0.f, 360.f);
+
+        Scene scene;
+        scene.walls = std::make_unique<Walls>(makeGallery(BASE_WALL_VERTICES * scale, BASE_PILLARS * scale, gen));
+
+        const std::size_t bullets = BASE_BULLETS * scale;
+        const std::size_t flashlights = BASE_FLASHLIGHTS * scale;
+        const std::size_t players = std::max(flashlights, (bullets + Gun::MAX_BULLETS - 1) / Gun::MAX_BULLETS);
+
+        std::size_t bulletsLeft = bullets;
+        for(std::size_t p = 0; p < players; ++p) {
+            auto& player = scene.players.emplace_back(std::make_unique<Player>(posDist(gen), posDist(gen)));
+            player->Update(0.f);
+
+            auto gun = std::dynamic_pointer_cast<Gun>(player->GetComponent("gun").lock());
+            auto flashlight = std::dynamic_pointer_cast<FlashLight>(player->GetComponent("flashlight").lock());
+
+            std::vector<Gun::Bullet> spawned;
+            for(; bulletsLeft > 0 && spawned.size() < Gun::MAX_BULLETS; --bulletsLeft) {
+                const float rad = angleDist(gen) * PI / 180.f;
+                spawned.emplace_back(sf::Vector2f{posDist(gen), posDist(gen)}, sf::Vector2f{std::cos(rad), std::sin(rad)});
+            }
+            gun->SetBullets(spawned);
+
+            if(p < flashlights) {
+                flashlight->ToggleSwitch();
+                flashlight->SetWidth(45.f);
+                flashlight->SetRadius(1200.f);
+                flashlight->SetAngles(angleDist(gen));
+            }
+
+            scene.guns.push_back(gun);
+            scene.flashlights.push_back(flashlight);
+        }
+
+        std::uniform_real_distribution<float> screenX(40.f, static_cast<float>(opts.width) - 40.f);
+        std::uniform_real_distribution<float> screenY(40.f, static_cast<float>(opts.height) - 40.f);
+        for(std::size_t i = 0; i < BASE_HUD_ELEMENTS * scale; ++i) {
+            auto& gauge = scene.hud.Add<core::AmmoGauge>();
+            gauge.SetPosition({screenX(gen), screenY(gen)});
+            gauge.Bind(static_cast<int>(i % (Gun::MAX_AMMO + 1)));
+        }
+
+        return scene;
+    }
+
+    // Keeps roughly `total` particles alive, split across kinds by pool capacity.
+    void refillParticles(const std::size_t total, std::mt19937& gen) {
+        constexpr core::ParticleKind kinds[] = {
+            core::ParticleKind::MuzzleFlash, core::ParticleKind::Impact, core::ParticleKind::Ghost};
+
+        std::size_t capacity = 0;
+        for(const auto kind : kinds)
+            capacity += core::Particles::GetCapacity(kind);
+
+        std::uniform_real_distribution<float> posDist(-GALLERY_RADIUS * 0.6f, GALLERY_RADIUS * 0.6f);
+        std::uniform_real_distribution<float> angleDist(0.f, 2.f * PI);
+
+        for(const auto kind : kinds) {
+            const std::size_t share = std::min(core::Particles::GetCapacity(kind),
+                total * core::Particles::GetCapacity(kind) / capacity);
+
+            while(core::Particles::GetCount(kind) < share) {
+                const float rad = angleDist(gen);
+                const std::size_t burst = std::min(PARTICLE_BURST, share - core::Particles::GetCount(kind));
+                core::Particles::Emit(kind, {posDist(gen), posDist(gen)}, {std::cos(rad), std::sin(rad)}, burst);
+            }
+        }
+    }
+
+    // Averages over opts.frames frames after one warm-up frame.
+    Result measure(const Options& opts, std::string name, const std::size_t scale, sf::RenderTexture& target,
+                   const std::function<void()>& body) {
+        target.clear();
+        body();
+        target.display();
+
+        double submit = 0.0;
+        double display = 0.0;
+        std::uint64_t allocations = 0;
+        core::renderStats = core::RenderStats{};
+
+        for(std::size_t f = 0; f < opts.frames; ++f) {
+            const auto start = Clock::now();
+            target.clear();
+            {
+                const core::NoAllocationScope scope;
+                body();
+                allocations += scope.GetAllocations();
+            }
+            const auto submitted = Clock::now();
+            target.display();
+            const auto end = Clock::now();
+
+            submit += std::chrono::duration<double, std::milli>(submitted - start).count();
+            display += std::chrono::duration<double, std::milli>(end - submitted).count();
+        }
+
+        const double frames = static_cast<double>(opts.frames);
+        return Result{std::move(name), scale, submit / frames, display / frames,
+            static_cast<double>(core::renderStats.drawCalls) / frames,
+            static_cast<double>(core::renderStats.vertices) / frames,
+            static_cast<double>(allocations) / frames};
+    }
+
+    std::vector<std::size_t> parseList(const std::string_view text) {
+        std::vector<std::size_t> values;
+        std::size_t start = 0;
+
+        while(start < text.size()) {
+            const std::size_t comma = std::min(text.find(',', start), text.size());
+            values.push_back(static_cast<std::size_t>(std::stoul(std::string(text.substr(start, comma - start)))));
+            start = comma + 1;
+        }
+
+        return values;
+    }
+
+    bool parseOptions(const int argc, char* argv[], Options& opts) {
+        for(int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if(arg == "--scales" && hasValue)
+                opts.scales = parseList(argv[++i]);
+            else if(arg == "--frames" && hasValue)
+                opts.frames = std::max<std::size_t>(std::stoul(argv[++i]), 1);
+            else if(arg == "--size" && hasValue) {
+                const std::string size = argv[++i];
+                const std::size_t x = size.find('x');
+                if(x == std::string::npos) return false;
+
+                opts.width = static_cast<unsigned int>(std::stoul(size.substr(0, x)));
+                opts.height = static_cast<unsigned int>(std::stoul(size.substr(x + 1)));
+            }
+            else if(arg == "--filter" && hasValue)
+                opts.filter = argv[++i];
+            else if(arg == "--csv")
+                opts.csv = true;
+            else if(arg == "--no-alloc")
+                opts.noAlloc = true;
+            else {
+                std::cerr << "usage: render-bench [--scales 1,4,16] [--frames N] [--size 1280x720] [--filter name] [--csv] [--no-alloc]\n";
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void print(const Options& opts, const std::vector<Result>& results) {
+        if(opts.csv) {
+            std::cout << "name,scale,submit_ms,display_ms,draw_calls,vertices,allocs_per_frame\n";
+            for(const auto& result : results)
+                std::cout << result.name << ',' << result.scale << ',' << result.submitMs << ','
+                    << result.displayMs << ',' << result.drawCalls << ',' << result.vertices << ','
+                    << result.allocations << '\n';
+            return;
+        }
+
+        std::cout << std::left << std::setw(20) << "path" << std::right
+            << std::setw(7) << "scale" << std::setw(12) << "submit ms" << std::setw(12) << "display ms"
+            << std::setw(12) << "draw calls" << std::setw(12) << "vertices" << std::setw(14) << "allocs/frame" << '\n';
+
+        std::cout << std::fixed;
+        for(const auto& result : results)
+            std::cout << std::left << std::setw(20) << result.name << std::right
+                << std::setw(7) << result.scale
+                << std::setw(12) << std::setprecision(3) << result.submitMs
+                << std::setw(12) << result.displayMs
+                << std::setw(12) << std::setprecision(0) << result.drawCalls
+                << std::setw(12) << result.vertices
+                << std::setw(14) << std::setprecision(2) << result.allocations << '\n';
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options opts;
+    if(!parseOptions(argc, argv, opts)) return 1;
+
+    auto enabled = [&opts](const std::string_view name) {
+        return opts.filter.empty() || name.find(opts.filter) != std::string_view::npos;
+    };
+
+    sf::RenderTexture target;
+    if(!target.resize({opts.width, opts.height})) {
+        std::cerr << "could not create a " << opts.width << "x" << opts.height << " render texture\n";
+        return 1;
+    }
+
+    const float aspect = static_cast<float>(opts.width) / static_cast<float>(opts.height);
+    target.setView(sf::View({0.f, 0.f}, {GALLERY_RADIUS * 2.2f * aspect, GALLERY_RADIUS * 2.2f}));
+
+    std::mt19937 gen{12345};
+    std::vector<Result> results;
+
+    core::Particles::SetEmitting(true);
+
+    for(const std::size_t scale : opts.scales) {
+        if(scale == 0) continue;
+
+        Scene scene = makeScene(scale, opts, gen);
+        const sf::Vector2f cursor{static_cast<float>(opts.width) * 0.5f, static_cast<float>(opts.height) * 0.5f};
+
+        if(enabled("Game::render"))
+            results.emplace_back(measure(opts, "Game::render", scale, target, [&]() {
+                scene.walls->Draw(target);
+                for(const auto& player : scene.players)
+                    player->Draw(target);
+                scene.hud.Draw(target);
+            }));
+
+        if(enabled("Gun::Render"))
+            results.emplace_back(measure(opts, "Gun::Render", scale, target, [&]() {
+                for(const auto& gun : scene.guns)
+                    gun->Render(target);
+            }));
+
+        if(enabled("FlashLight::Render"))
+            results.emplace_back(measure(opts, "FlashLight::Render", scale, target, [&]() {
+                for(const auto& flashlight : scene.flashlights)
+                    flashlight->Render(target);
+            }));
+
+        // Game::renderHud: the cursor moves every frame, the ammo only every HUD_AMMO_FRAMES.
+        if(enabled("HudLayer")) {
+            core::HudLayer hud;
+            auto& ammo = hud.Add<core::AmmoGauge>();
+            auto& zoom = hud.Add<core::ZoomGauge>();
+            zoom.SetPosition({16.f, static_cast<float>(opts.height) - 16.f - core::ZoomGauge::SIZE.y});
+
+            std::size_t frame = 0;
+            results.emplace_back(measure(opts, "HudLayer", scale, target, [&]() {
+                const float rad = static_cast<float>(frame) * 0.05f;
+                ammo.SetPosition(cursor + 100.f * sf::Vector2f{std::cos(rad), std::sin(rad)});
+                ammo.Bind(Gun::MAX_AMMO - static_cast<int>(frame / HUD_AMMO_FRAMES % (Gun::MAX_AMMO + 1)));
+                zoom.Bind(0.5f);
+                hud.Draw(target);
+                ++frame;
+            }));
+        }
+
+        if(enabled("Particles")) {
+            const std::size_t particles = BASE_PARTICLES * scale;
+
+            results.emplace_back(measure(opts, "Particles", scale, target, [&]() {
+                core::Particles::Update(FRAME_TIME);
+                refillParticles(particles, gen);
+                core::Particles::Draw(target);
+            }));
+
+            core::Particles::Clear();
+        }
+    }
+
+    print(opts, results);
+
+    if(opts.noAlloc) {
+        bool allocated = false;
+        for(const auto& result : results) {
+            if(result.allocations == 0.0) continue;
+
+            std::cerr << "steady-state allocation: " << result.name << " (scale " << result.scale << ") allocated "
+                << result.allocations << " times per frame\n";
+            allocated = true;
+        }
+
+        if(allocated) return 1;
+    }
+
+    return 0;
+}